@@ -0,0 +1,68 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_BANDEDRASTER_HPP
+#define TD_UTIL_BANDEDRASTER_HPP
+
+#include <DGtal/base/Common.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace td::util
+{
+    /// Values of a 2D raster, row by row, stored in bands of rows which are shared between copies.
+    /// A copy only copies the handles of the bands, and writing a row of a shared band copies that band first,
+    /// so that editing a few rows of a copy costs those rows, not the whole raster.
+    /// Each row is contiguous, the bands are not.
+    /// \tparam T
+    template <typename T>
+    class BandedRaster
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef T Value;
+
+        /** --------- methods ------------- **/
+        inline BandedRaster();
+        /// \param width
+        /// \param height
+        /// \param value of every pixel.
+        inline BandedRaster(std::size_t width, std::size_t height, Value const & value = Value());
+
+        [[nodiscard]] inline std::size_t
+          getWidth() const;
+        [[nodiscard]] inline std::size_t
+          getHeight() const;
+
+        /// \param row must be below the height.
+        /// \return the width values of the row.
+        [[nodiscard]] inline Value const *
+          getRow(std::size_t row) const;
+
+        /// Same, to be written: the band of the row is copied first unless this raster is its only owner.
+        /// Distinct values of bands owned by this raster alone can be written from several threads.
+        /// \param row must be below the height.
+        [[nodiscard]] inline Value *
+          getMutableRow(std::size_t row);
+
+       private:
+        /** --------- typedefs ------------- **/
+        typedef std::vector<Value> Band;
+
+        /** --------- data ------------- **/
+        std::size_t                        m_width;
+        std::size_t                        m_height;
+        std::vector<std::shared_ptr<Band>> m_bands;
+
+        // Rows per band, a power of two: 64 rows of 2048 64-bit values is 1 MB.
+        static constexpr std::size_t c_bandShift = 6;
+        static constexpr std::size_t c_bandMask  = (std::size_t {1} << c_bandShift) - 1;
+    };
+}  // namespace td::util
+
+#include "BandedRaster.inl"
+
+#endif  // TD_UTIL_BANDEDRASTER_HPP
@@ -0,0 +1,67 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_BANDEDRASTER_INL
+#define TD_UTIL_BANDEDRASTER_INL
+
+#include <algorithm>
+
+namespace td::util
+{
+    template <typename T>
+    inline BandedRaster<T>::BandedRaster() : m_width(0), m_height(0), m_bands()
+    {
+    }
+
+    template <typename T>
+    inline BandedRaster<T>::BandedRaster(std::size_t width, std::size_t height, Value const & value)
+        : m_width(width), m_height(height), m_bands()
+    {
+        std::size_t const numberBands = (height + c_bandMask) >> c_bandShift;
+        m_bands.reserve(numberBands);
+        for (std::size_t band = 0; band < numberBands; ++band)
+        {
+            // The last band only has the rows left.
+            std::size_t const rows = std::min(height - (band << c_bandShift), c_bandMask + 1);
+            m_bands.push_back(std::make_shared<Band>(rows * width, value));
+        }
+    }
+
+    template <typename T>
+    inline std::size_t
+      BandedRaster<T>::getWidth() const
+    {
+        return m_width;
+    }
+
+    template <typename T>
+    inline std::size_t
+      BandedRaster<T>::getHeight() const
+    {
+        return m_height;
+    }
+
+    template <typename T>
+    inline typename BandedRaster<T>::Value const *
+      BandedRaster<T>::getRow(std::size_t row) const
+    {
+        ASSERT(row < m_height);
+        return m_bands[row >> c_bandShift]->data() + (row & c_bandMask) * m_width;
+    }
+
+    template <typename T>
+    inline typename BandedRaster<T>::Value *
+      BandedRaster<T>::getMutableRow(std::size_t row)
+    {
+        ASSERT(row < m_height);
+        std::shared_ptr<Band> & band = m_bands[row >> c_bandShift];
+        if (band.use_count() != 1)
+        {
+            band = std::make_shared<Band>(*band);
+        }
+        return band->data() + (row & c_bandMask) * m_width;
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_BANDEDRASTER_INL
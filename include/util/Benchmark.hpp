@@ -0,0 +1,158 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_BENCHMARK_HPP
+#define TD_UTIL_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace td::util
+{
+    /// Timing loop of a benchmark, in the manner of Google Benchmark:
+    ///     while (state.keepRunning()) { ... }
+    /// Only the iterations are timed, the set-up before the loop is not.
+    class BenchmarkState
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef std::chrono::steady_clock Clock;
+        typedef double                    Seconds;
+
+        /** --------- methods ------------- **/
+        inline BenchmarkState(std::int64_t argument, std::size_t iterations);
+
+        /// Starts the clock on the first call, stops it after the last iteration.
+        /// \return whether there is another iteration to run.
+        [[nodiscard]] inline bool
+          keepRunning();
+
+        /// Excludes the work between the two calls from the time,
+        /// for a set-up which has to be repeated at each iteration.
+        /// Reading the clocks costs about a microsecond, so only worth it for longer iterations.
+        inline void
+          pauseTiming();
+        inline void
+          resumeTiming();
+
+        /// Parameter of the benchmark (size of the input, ...).
+        [[nodiscard]] inline std::int64_t
+          getArgument() const;
+
+        /// Work done by all the iterations, reported as a rate.
+        inline void
+          setItemsProcessed(std::int64_t items);
+
+        [[nodiscard]] inline std::size_t
+          getIterations() const;
+        [[nodiscard]] inline Seconds
+          getRealTime() const;
+        [[nodiscard]] inline Seconds
+          getCpuTime() const;
+        [[nodiscard]] inline std::int64_t
+          getItemsProcessed() const;
+
+       private:
+        /** --------- data ------------- **/
+        std::int64_t m_argument;
+        std::size_t  m_iterations;
+        std::size_t  m_remaining;
+        bool         m_isStarted;
+        std::int64_t m_itemsProcessed;
+
+        Clock::time_point m_realStart;
+        std::clock_t      m_cpuStart;
+        Seconds           m_realTime;
+        Seconds           m_cpuTime;
+    };
+
+    /// Registry of parameterised benchmarks.
+    /// Each benchmark is run once per argument: the number of iterations is grown
+    /// until a run lasts long enough, then the run is repeated to estimate the spread.
+    /// The JSON output follows the format of Google Benchmark, so that its tools can compare two of them.
+    class BenchmarkSuite
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef BenchmarkState::Seconds            Seconds;
+        typedef std::function<void(BenchmarkState &)> Function;
+
+        /// Times of one benchmark with one argument, per iteration.
+        struct Result
+        {
+            std::string  name;
+            std::size_t  iterations;
+            std::size_t  repetitions;
+            Seconds      meanRealTime;
+            Seconds      medianRealTime;
+            Seconds      standardDeviationRealTime;
+            Seconds      meanCpuTime;
+            Seconds      medianCpuTime;
+            Seconds      standardDeviationCpuTime;
+            // 0 when the benchmark does not report its work.
+            double       itemsPerSecond;
+        };
+
+        /** --------- methods ------------- **/
+        /// \param minimumTime shortest run used to measure.
+        /// \param repetitions number of measured runs.
+        inline explicit BenchmarkSuite(Seconds minimumTime = 0.2, std::size_t repetitions = 5);
+
+        /// \param name
+        /// \param arguments one run per argument, named "name/argument".
+        /// \param function
+        inline void
+          add(std::string name, std::vector<std::int64_t> arguments, Function function);
+
+        /// Runs every benchmark whose name contains the filter.
+        /// \param filter
+        /// \param log progress, one line per result.
+        /// \return
+        [[nodiscard]] inline std::vector<Result>
+          run(std::string const & filter, std::ostream & log) const;
+
+        inline static void
+          writeJson(std::ostream & os, std::vector<Result> const & results);
+
+        /// Keeps the compiler from discarding a value which is computed but never used.
+        template <class T>
+        inline static void
+          doNotOptimize(T const & value);
+
+       private:
+        /** --------- typedefs ------------- **/
+        struct Entry
+        {
+            std::string               name;
+            std::vector<std::int64_t> arguments;
+            Function                  function;
+        };
+
+        /** --------- methods ------------- **/
+        [[nodiscard]] inline Result
+          runOne(Entry const & entry, std::int64_t argument) const;
+
+        /// Upper median of a non-empty sample.
+        [[nodiscard]] inline static Seconds
+          median(std::vector<Seconds> times);
+
+        /** --------- data ------------- **/
+        Seconds            m_minimumTime;
+        std::size_t        m_repetitions;
+        std::vector<Entry> m_entries;
+
+        // Growth of the number of iterations between two calibration runs.
+        static constexpr std::size_t c_maximumGrowth = 10;
+        static constexpr std::size_t c_maximumIterations = std::size_t {1} << 30;
+    };
+}  // namespace td::util
+
+#include "Benchmark.inl"
+
+#endif  // TD_UTIL_BENCHMARK_HPP
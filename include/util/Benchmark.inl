@@ -0,0 +1,246 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_BENCHMARK_INL
+#define TD_UTIL_BENCHMARK_INL
+
+#include <DGtal/base/Common.h>
+
+#include <util/common.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace td::util
+{
+    inline BenchmarkState::BenchmarkState(std::int64_t argument, std::size_t iterations)
+        : m_argument(argument),
+          m_iterations(iterations),
+          m_remaining(iterations),
+          m_isStarted(false),
+          m_itemsProcessed(0),
+          m_realStart(),
+          m_cpuStart(),
+          m_realTime(0),
+          m_cpuTime(0)
+    {}
+
+    inline bool
+      BenchmarkState::keepRunning()
+    {
+        if (!m_isStarted)
+        {
+            m_isStarted = true;
+            resumeTiming();
+        }
+        if (m_remaining == 0)
+        {
+            pauseTiming();
+            return false;
+        }
+        --m_remaining;
+        return true;
+    }
+
+    inline void
+      BenchmarkState::pauseTiming()
+    {
+        m_realTime += std::chrono::duration<Seconds>(Clock::now() - m_realStart).count();
+        m_cpuTime += static_cast<Seconds>(std::clock() - m_cpuStart) / CLOCKS_PER_SEC;
+    }
+
+    inline void
+      BenchmarkState::resumeTiming()
+    {
+        m_realStart = Clock::now();
+        m_cpuStart  = std::clock();
+    }
+
+    inline std::int64_t
+      BenchmarkState::getArgument() const
+    {
+        return m_argument;
+    }
+
+    inline void
+      BenchmarkState::setItemsProcessed(std::int64_t items)
+    {
+        m_itemsProcessed = items;
+    }
+
+    inline std::size_t
+      BenchmarkState::getIterations() const
+    {
+        return m_iterations;
+    }
+
+    inline BenchmarkState::Seconds
+      BenchmarkState::getRealTime() const
+    {
+        return m_realTime;
+    }
+
+    inline BenchmarkState::Seconds
+      BenchmarkState::getCpuTime() const
+    {
+        return m_cpuTime;
+    }
+
+    inline std::int64_t
+      BenchmarkState::getItemsProcessed() const
+    {
+        return m_itemsProcessed;
+    }
+
+    inline BenchmarkSuite::BenchmarkSuite(Seconds minimumTime, std::size_t repetitions)
+        : m_minimumTime(minimumTime), m_repetitions(repetitions), m_entries()
+    {
+        ASSERT(minimumTime > 0 && repetitions > 0);
+    }
+
+    inline void
+      BenchmarkSuite::add(std::string name, std::vector<std::int64_t> arguments, Function function)
+    {
+        m_entries.push_back({std::move(name), std::move(arguments), std::move(function)});
+    }
+
+    inline std::vector<BenchmarkSuite::Result>
+      BenchmarkSuite::run(std::string const & filter, std::ostream & log) const
+    {
+        std::vector<Result> results;
+        for (Entry const & entry : m_entries)
+        {
+            for (std::int64_t argument : entry.arguments)
+            {
+                std::string const name = entry.name + "/" + std::to_string(argument);
+                if (name.find(filter) == std::string::npos)
+                {
+                    continue;
+                }
+                results.push_back(runOne(entry, argument));
+                Result const &     result = results.back();
+                std::ostringstream line;
+                line << std::left << std::setw(48) << result.name << std::right << std::fixed << std::setprecision(1)
+                     << std::setw(16) << result.meanRealTime * 1e9 << " ns" << std::setw(12) << result.iterations
+                     << " it  +- " << 100. * result.standardDeviationRealTime / result.meanRealTime << " %";
+                log << line.str() << std::endl;
+            }
+        }
+        return results;
+    }
+
+    inline BenchmarkSuite::Result
+      BenchmarkSuite::runOne(Entry const & entry, std::int64_t argument) const
+    {
+        // Calibration: grows the number of iterations until a run lasts long enough,
+        // aiming a bit past the minimum time from the last run.
+        std::size_t iterations = 1;
+        while (true)
+        {
+            BenchmarkState state(argument, iterations);
+            entry.function(state);
+            Seconds const time = state.getRealTime();
+            if (time >= m_minimumTime || iterations >= c_maximumIterations)
+            {
+                break;
+            }
+            double const    target = 1.4 * m_minimumTime / std::max(time, 1e-9);
+            std::size_t const next   = static_cast<std::size_t>(std::ceil(static_cast<double>(iterations) * target));
+            iterations = std::min({std::max(next, iterations + 1), iterations * c_maximumGrowth, c_maximumIterations});
+        }
+
+        std::vector<Seconds> realTimes;
+        std::vector<Seconds> cpuTimes;
+        realTimes.reserve(m_repetitions);
+        cpuTimes.reserve(m_repetitions);
+        std::int64_t items = 0;
+        for (std::size_t i = 0; i < m_repetitions; ++i)
+        {
+            BenchmarkState state(argument, iterations);
+            entry.function(state);
+            realTimes.push_back(state.getRealTime() / static_cast<Seconds>(iterations));
+            cpuTimes.push_back(state.getCpuTime() / static_cast<Seconds>(iterations));
+            items = state.getItemsProcessed();
+        }
+
+        Result result {};
+        result.name                      = entry.name + "/" + std::to_string(argument);
+        result.iterations                = iterations;
+        result.repetitions               = m_repetitions;
+        result.meanRealTime              = maths<Seconds>::average(realTimes);
+        result.standardDeviationRealTime = maths<Seconds>::standardDeviation(realTimes);
+        result.medianRealTime            = median(realTimes);
+        result.meanCpuTime               = maths<Seconds>::average(cpuTimes);
+        result.standardDeviationCpuTime  = maths<Seconds>::standardDeviation(cpuTimes);
+        result.medianCpuTime             = median(cpuTimes);
+        result.itemsPerSecond =
+          items > 0 ? static_cast<double>(items) / static_cast<double>(iterations) / result.meanRealTime : 0.;
+        return result;
+    }
+
+    inline BenchmarkSuite::Seconds
+      BenchmarkSuite::median(std::vector<Seconds> times)
+    {
+        ASSERT(!times.empty());
+        std::nth_element(times.begin(), times.begin() + static_cast<std::ptrdiff_t>(times.size() / 2), times.end());
+        return times[times.size() / 2];
+    }
+
+    inline void
+      BenchmarkSuite::writeJson(std::ostream & os, std::vector<Result> const & results)
+    {
+        std::time_t const now = std::time(nullptr);
+        os << "{\n  \"context\": {\"date\": \"" << std::put_time(std::localtime(&now), "%FT%T%z")
+           << "\", \"num_cpus\": " << std::thread::hardware_concurrency() << ", \"library_build_type\": \""
+#ifdef NDEBUG
+           << "release"
+#else
+           << "debug"
+#endif
+           << "\"},\n  \"benchmarks\": [";
+        // One entry per statistic, as the aggregates of Google Benchmark.
+        auto const writeAggregate =
+          [&os](Result const & result, char const * aggregate, Seconds realTime, Seconds cpuTime, bool isFirst)
+        {
+            os << (isFirst ? "\n" : ",\n") << "    {\"name\": \"" << result.name << "_" << aggregate
+               << "\", \"run_name\": \"" << result.name << "\", \"run_type\": \"aggregate\""
+               << ", \"aggregate_name\": \"" << aggregate << "\", \"repetitions\": " << result.repetitions
+               << ", \"iterations\": " << result.iterations << ", \"real_time\": " << realTime * 1e9
+               << ", \"cpu_time\": " << cpuTime * 1e9 << ", \"time_unit\": \"ns\"";
+            if (result.itemsPerSecond > 0)
+            {
+                os << ", \"items_per_second\": " << result.itemsPerSecond;
+            }
+            os << "}";
+        };
+        os << std::setprecision(9);
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            Result const & result = results[i];
+            writeAggregate(result, "mean", result.meanRealTime, result.meanCpuTime, i == 0);
+            writeAggregate(result, "median", result.medianRealTime, result.medianCpuTime, false);
+            writeAggregate(result, "stddev", result.standardDeviationRealTime, result.standardDeviationCpuTime, false);
+        }
+        os << "\n  ]\n}\n";
+    }
+
+    template <class T>
+    inline void
+      BenchmarkSuite::doNotOptimize(T const & value)
+    {
+        // The value may be read through its address, so it has to be computed.
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        // No GNU inline assembly (MSVC): the address escapes through a volatile store instead.
+        static void const * volatile s_sink = nullptr;
+        s_sink                              = &value;
+#endif
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_BENCHMARK_INL
@@ -0,0 +1,112 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_BINARYPYRAMID_HPP
+#define TD_UTIL_BINARYPYRAMID_HPP
+
+#include <util/DigitalComponent.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace td::util
+{
+    /// Binary images of a set of points at halved resolutions.
+    /// Level k has a pixel for each 2^k x 2^k block of the base domain, so that all the coarse levels
+    /// together take a third of the base level.
+    /// The base level (0) is built from the same points, so that every level has the same foreground
+    /// and distances measured at different levels bound each other.
+    /// It can't share the raster of a CompositeDigitalObject or its distance transform,
+    /// whose foreground also holds the filtered components.
+    /// Each level keeps a distance transform (a SquaredDistance per pixel) and its points, not its image:
+    /// the pyramid takes about 4/3 of a distance transform of the base domain, plus the points.
+    /// Coarse coordinates are floor(p / 2^k), shared by any two pyramids of the same level.
+    /// \tparam dimension
+    /// \tparam Topology_T
+    template <int dimension, class Topology_T>
+    class BinaryPyramid
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef DigitalComponent<dimension, Topology_T> Component;
+
+        typedef typename Component::Space             Space;
+        typedef typename Component::Domain            Domain;
+        typedef typename Component::Point             Point;
+        typedef typename Component::Integer           Integer;
+        typedef typename Component::Perimeter         Perimeter;
+        typedef typename Component::Image             Image;
+        typedef typename Component::DistanceTransform DistanceTransform;
+
+        /// How a block of 2 x 2 pixels is reduced to one.
+        enum class Downsampling
+        {
+            // Foreground if any pixel is, no shape gets thinner.
+            Or,
+            // Foreground if at least half of the pixels are.
+            Majority
+        };
+
+        /// One level, with the distance transform of its background.
+        struct Level
+        {
+            inline explicit Level(Image const & levelImage);
+            Level(Level const &) = delete;
+            Level &
+              operator=(Level const &) = delete;
+
+            DistanceTransform distance;
+            // Foreground points of the level.
+            std::vector<Point> points;
+        };
+
+        /** --------- methods ------------- **/
+        /// \tparam PointRange
+        /// \param points foreground of the base level.
+        /// \param domain domain of the base level.
+        /// \param downsampling
+        template <class PointRange>
+        inline BinaryPyramid(PointRange const & points,
+                             Domain const &     domain,
+                             Downsampling       downsampling = Downsampling::Or);
+
+        /// Number of levels, the base one included.
+        [[nodiscard]] inline std::size_t
+          getNumberLevels() const;
+
+        /// \param level from 0 (full resolution) to getNumberLevels() - 1.
+        [[nodiscard]] inline Level const &
+          getLevel(std::size_t level) const;
+
+        /// Coordinates of a base point at a level.
+        [[nodiscard]] inline static Point
+          toLevel(Point const & point, std::size_t level);
+
+        /// Bound on the difference between a distance measured at a level (scaled back)
+        /// and the same distance at full resolution, for Or downsampling.
+        /// Each point moves by less than the diagonal of a block on each side, plus the rounding of rigid motions.
+        [[nodiscard]] inline static Perimeter
+          getLevelError(std::size_t level);
+
+       private:
+        /** --------- methods ------------- **/
+        [[nodiscard]] static Image
+          computeDownsampled(std::vector<Point> const & points, Domain const & domain, Downsampling downsampling);
+        template <class PointRange>
+        [[nodiscard]] static Image
+          computeBase(PointRange const & points, Domain const & domain);
+
+        /** --------- data ------------- **/
+        // Base level first, then coarser and coarser ones.
+        std::vector<std::unique_ptr<Level>> m_levels;
+
+        // Levels are added until the domain is this small.
+        static constexpr Integer     c_minimumExtent   = 8;
+        static constexpr std::size_t c_maximumLevels   = 6;
+    };
+}  // namespace td::util
+
+#include "BinaryPyramid.inl"
+
+#endif  // TD_UTIL_BINARYPYRAMID_HPP
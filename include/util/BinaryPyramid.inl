@@ -0,0 +1,119 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_BINARYPYRAMID_INL
+#define TD_UTIL_BINARYPYRAMID_INL
+
+#include <cmath>
+
+namespace td::util
+{
+    template <int dimension, class Topology_T>
+    inline BinaryPyramid<dimension, Topology_T>::Level::Level(Image const & levelImage)
+        : distance(levelImage.domain(), [&levelImage](Point const & point) { return levelImage(point) != 0; }),
+          points()
+    {
+        for (auto const & point : levelImage.domain())
+        {
+            if (levelImage(point) != 0)
+            {
+                points.push_back(point);
+            }
+        }
+    }
+
+    template <int dimension, class Topology_T>
+    template <class PointRange>
+    inline BinaryPyramid<dimension, Topology_T>::BinaryPyramid(PointRange const & points,
+                                                               Domain const &     domain,
+                                                               Downsampling       downsampling)
+        : m_levels()
+    {
+        m_levels.push_back(std::make_unique<Level>(computeBase(points, domain)));
+        Domain levelDomain = domain;
+        while (m_levels.size() < c_maximumLevels
+               && (levelDomain.upperBound() - levelDomain.lowerBound()).max() + 1 > c_minimumExtent)
+        {
+            levelDomain = Domain(toLevel(levelDomain.lowerBound(), 1), toLevel(levelDomain.upperBound(), 1));
+            // Each level is reduced from the previous one.
+            m_levels.push_back(
+              std::make_unique<Level>(computeDownsampled(m_levels.back()->points, levelDomain, downsampling)));
+        }
+    }
+
+    template <int dimension, class Topology_T>
+    typename BinaryPyramid<dimension, Topology_T>::Image
+      BinaryPyramid<dimension, Topology_T>::computeDownsampled(std::vector<Point> const & points,
+                                                               Domain const &             domain,
+                                                               Downsampling               downsampling)
+    {
+        // Count of foreground pixels in each block.
+        Image image(domain);
+        for (auto const & point : points)
+        {
+            Point const coarse = toLevel(point, 1);
+            image.setValue(coarse, image(coarse) + 1);
+        }
+        // A block has 2^dimension pixels.
+        int const threshold = downsampling == Downsampling::Or ? 1 : (1 << dimension) / 2;
+        for (auto const & point : domain)
+        {
+            image.setValue(point, image(point) >= threshold ? 255 : 0);
+        }
+        return image;
+    }
+
+    template <int dimension, class Topology_T>
+    template <class PointRange>
+    typename BinaryPyramid<dimension, Topology_T>::Image
+      BinaryPyramid<dimension, Topology_T>::computeBase(PointRange const & points, Domain const & domain)
+    {
+        Image image(domain);
+        for (auto const & point : points)
+        {
+            image.setValue(point, 255);
+        }
+        return image;
+    }
+
+    template <int dimension, class Topology_T>
+    inline std::size_t
+      BinaryPyramid<dimension, Topology_T>::getNumberLevels() const
+    {
+        return m_levels.size();
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename BinaryPyramid<dimension, Topology_T>::Level const &
+      BinaryPyramid<dimension, Topology_T>::getLevel(std::size_t level) const
+    {
+        ASSERT(level < getNumberLevels());
+        return *m_levels[level];
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename BinaryPyramid<dimension, Topology_T>::Point
+      BinaryPyramid<dimension, Topology_T>::toLevel(Point const & point, std::size_t level)
+    {
+        auto const scale = static_cast<Integer>(1) << level;
+        Point      coarse;
+        for (int k = 0; k < dimension; ++k)
+        {
+            // Rounding towards minus infinity, for negative coordinates too.
+            coarse[k] = point[k] >= 0 ? point[k] / scale : -((-point[k] + scale - 1) / scale);
+        }
+        return coarse;
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename BinaryPyramid<dimension, Topology_T>::Perimeter
+      BinaryPyramid<dimension, Topology_T>::getLevelError(std::size_t level)
+    {
+        auto const scale    = static_cast<Perimeter>(1 << level);
+        auto const diagonal = std::sqrt(static_cast<Perimeter>(dimension));
+        return level == 0 ? diagonal : diagonal * (2. * (scale - 1.) + scale);
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_BINARYPYRAMID_INL
@@ -0,0 +1,108 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_BINARYVOLUME_HPP
+#define TD_UTIL_BINARYVOLUME_HPP
+
+#include <DGtal/helpers/StdDefs.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <vector>
+
+namespace td::util
+{
+    /// Binary 3D image, one bit per voxel.
+    /// A 1024^3 volume takes 128 MiB.
+    /// Model of DGtal's point predicate.
+    class BinaryVolume
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef DGtal::Z3i::Space  Space;
+        typedef DGtal::Z3i::Domain Domain;
+        typedef DGtal::Z3i::Point  Point;
+        // Grey level of 8-bit and 16-bit volumes.
+        typedef std::uint16_t Value;
+
+        // Order of the bytes of 16-bit voxels.
+        enum class ByteOrder
+        {
+            BigEndian,
+            LittleEndian
+        };
+
+        /** --------- methods ------------- **/
+        /// Empty volume over [0, extent - 1].
+        inline explicit BinaryVolume(Point const & extent);
+
+        /// Empty volume over any domain, for instance the bounding box of a component.
+        inline explicit BinaryVolume(Domain const & domain);
+
+        /// Reads a raw file of 8-bit or 16-bit voxels, x varying first, then y, then z.
+        /// Slices are read and thresholded one at a time, the grey levels are never stored.
+        /// \param path
+        /// \param extent number of voxels along each axis.
+        /// \param threshold voxels strictly above are foreground.
+        /// \param bytesPerVoxel 1 or 2.
+        /// \param byteOrder of 16-bit voxels.
+        /// \return
+        [[nodiscard]] inline static BinaryVolume
+          importRaw(std::filesystem::path const & path,
+                    Point const &                 extent,
+                    Value                         threshold     = 0,
+                    int                           bytesPerVoxel = 1,
+                    ByteOrder                     byteOrder     = ByteOrder::LittleEndian);
+
+        /// Reads a PGM3D file (P2-3D for ASCII, P5-3D or P3D for binary), slice by slice.
+        /// \param path
+        /// \param threshold voxels strictly above are foreground.
+        /// \return
+        [[nodiscard]] inline static BinaryVolume
+          importPGM3D(std::filesystem::path const & path, Value threshold = 0);
+
+        [[nodiscard]] inline bool
+          operator()(Point const & point) const;
+
+        inline void
+          setValue(Point const & point, bool value);
+
+        [[nodiscard]] inline Domain const &
+          domain() const;
+
+        /// Number of foreground voxels.
+        [[nodiscard]] inline std::size_t
+          count() const;
+
+        /// Calls the function on each foreground voxel, x varying first, then y, then z.
+        /// Empty words of 64 voxels are skipped.
+        /// \param function called with the point of the voxel.
+        template <class Function>
+        inline void
+          forEachPoint(Function const & function) const;
+
+       private:
+        /** --------- methods ------------- **/
+        [[nodiscard]] inline std::size_t
+          getIndex(Point const & point) const;
+
+        [[nodiscard]] inline Point
+          getPoint(std::size_t index) const;
+
+        /// Reads the slices of a binary stream, with 1 or 2 bytes per voxel.
+        /// Throws if the stream ends before the last slice.
+        inline void
+          readSlices(std::istream & is, int bytesPerVoxel, ByteOrder byteOrder, Value threshold);
+
+        /** --------- data ------------- **/
+        Domain                     m_domain;
+        Point                      m_extent;
+        std::vector<std::uint64_t> m_words;
+    };
+}  // namespace td::util
+
+#include "BinaryVolume.inl"
+
+#endif  // TD_UTIL_BINARYVOLUME_HPP
@@ -0,0 +1,218 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_BINARYVOLUME_INL
+#define TD_UTIL_BINARYVOLUME_INL
+
+#include <DGtal/base/Exceptions.h>
+
+#include <bitset>
+#include <fstream>
+#include <string>
+
+namespace td::util
+{
+    inline BinaryVolume::BinaryVolume(Point const & extent)
+        : BinaryVolume(Domain(Point::zero, extent - Point::diagonal()))
+    {}
+
+    inline BinaryVolume::BinaryVolume(Domain const & domain)
+        : m_domain(domain),
+          m_extent(domain.upperBound() - domain.lowerBound() + Point::diagonal()),
+          m_words((static_cast<std::size_t>(m_extent[0]) * static_cast<std::size_t>(m_extent[1])
+                     * static_cast<std::size_t>(m_extent[2])
+                   + 63)
+                    / 64,
+                  0)
+    {}
+
+    inline BinaryVolume
+      BinaryVolume::importRaw(std::filesystem::path const & path,
+                              Point const &                 extent,
+                              Value                         threshold,
+                              int                           bytesPerVoxel,
+                              ByteOrder                     byteOrder)
+    {
+        ASSERT(bytesPerVoxel == 1 || bytesPerVoxel == 2);
+        std::ifstream is(path, std::ios::binary);
+        if (!is)
+        {
+            DGtal::trace.error() << "BinaryVolume: can't open " << path << std::endl;
+            throw DGtal::IOException();
+        }
+        BinaryVolume volume(extent);
+        volume.readSlices(is, bytesPerVoxel, byteOrder, threshold);
+        return volume;
+    }
+
+    inline BinaryVolume
+      BinaryVolume::importPGM3D(std::filesystem::path const & path, Value threshold)
+    {
+        std::ifstream is(path, std::ios::binary);
+        if (!is)
+        {
+            DGtal::trace.error() << "BinaryVolume: can't open " << path << std::endl;
+            throw DGtal::IOException();
+        }
+        // header tokens, comments start with '#'.
+        auto const readToken = [&is]() -> std::string
+        {
+            std::string token;
+            while (is >> token && token.front() == '#')
+            {
+                std::getline(is, token);
+            }
+            return token;
+        };
+        std::string const magic = readToken();
+        bool const        isBinary = magic == "P5-3D" || magic == "P3D";
+        if (!isBinary && magic != "P2-3D")
+        {
+            DGtal::trace.error() << "BinaryVolume: " << path << " is not a PGM3D file" << std::endl;
+            throw DGtal::IOException();
+        }
+        Point extent;
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+            extent[k] = std::stoi(readToken());
+        }
+        int const maxValue = std::stoi(readToken());
+
+        BinaryVolume volume(extent);
+        if (isBinary)
+        {
+            // a single whitespace separates the header from the data.
+            is.get();
+            volume.readSlices(is, maxValue > 255 ? 2 : 1, ByteOrder::BigEndian, threshold);
+        }
+        else
+        {
+            int value;
+            for (auto const & point : volume.m_domain)
+            {
+                is >> value;
+                volume.setValue(point, value > static_cast<int>(threshold));
+            }
+        }
+        if (!is)
+        {
+            DGtal::trace.error() << "BinaryVolume: " << path << " is truncated" << std::endl;
+            throw DGtal::IOException();
+        }
+        return volume;
+    }
+
+    inline void
+      BinaryVolume::readSlices(std::istream & is, int bytesPerVoxel, ByteOrder byteOrder, Value threshold)
+    {
+        // Byte of each voxel read first, as the most significant one for big endian data.
+        std::size_t const high = byteOrder == ByteOrder::BigEndian ? 0 : 1;
+        auto const sliceSize = static_cast<std::size_t>(m_extent[0]) * static_cast<std::size_t>(m_extent[1]);
+        // Only one slice is in memory at a time.
+        std::vector<char> slice(sliceSize * static_cast<std::size_t>(bytesPerVoxel));
+        for (DGtal::Z3i::Integer z = 0; z < m_extent[2]; ++z)
+        {
+            is.read(slice.data(), static_cast<std::streamsize>(slice.size()));
+            if (is.gcount() != static_cast<std::streamsize>(slice.size()))
+            {
+                DGtal::trace.error() << "BinaryVolume: data ends in slice " << z << " of " << m_extent[2]
+                                     << std::endl;
+                throw DGtal::IOException();
+            }
+            std::size_t const offset = static_cast<std::size_t>(z) * sliceSize;
+            for (std::size_t i = 0; i < sliceSize; ++i)
+            {
+                Value value = static_cast<std::uint8_t>(slice[i * static_cast<std::size_t>(bytesPerVoxel)]);
+                if (bytesPerVoxel == 2)
+                {
+                    value = static_cast<Value>(static_cast<std::uint8_t>(slice[i * 2 + high]) << 8
+                                               | static_cast<std::uint8_t>(slice[i * 2 + 1 - high]));
+                }
+                if (value > threshold)
+                {
+                    std::size_t const index = offset + i;
+                    m_words[index / 64] |= std::uint64_t {1} << (index % 64);
+                }
+            }
+        }
+    }
+
+    inline bool
+      BinaryVolume::operator()(Point const & point) const
+    {
+        if (!m_domain.isInside(point))
+        {
+            return false;
+        }
+        std::size_t const index = getIndex(point);
+        return (m_words[index / 64] >> (index % 64)) & 1u;
+    }
+
+    inline void
+      BinaryVolume::setValue(Point const & point, bool value)
+    {
+        std::size_t const   index = getIndex(point);
+        std::uint64_t const mask  = std::uint64_t {1} << (index % 64);
+        m_words[index / 64]       = value ? (m_words[index / 64] | mask) : (m_words[index / 64] & ~mask);
+    }
+
+    inline BinaryVolume::Domain const &
+      BinaryVolume::domain() const
+    {
+        return m_domain;
+    }
+
+    inline std::size_t
+      BinaryVolume::count() const
+    {
+        std::size_t count = 0;
+        for (std::uint64_t word : m_words)
+        {
+            // Compiled to a single instruction where the target has one.
+            count += std::bitset<64>(word).count();
+        }
+        return count;
+    }
+
+    template <class Function>
+    inline void
+      BinaryVolume::forEachPoint(Function const & function) const
+    {
+        for (std::size_t w = 0; w < m_words.size(); ++w)
+        {
+            // stops at the highest set bit of the word.
+            std::uint64_t word = m_words[w];
+            for (std::size_t bit = 0; word != 0; ++bit, word >>= 1)
+            {
+                if ((word & 1u) != 0)
+                {
+                    function(getPoint(w * 64 + bit));
+                }
+            }
+        }
+    }
+
+    inline std::size_t
+      BinaryVolume::getIndex(Point const & point) const
+    {
+        Point const local = point - m_domain.lowerBound();
+        return (static_cast<std::size_t>(local[2]) * static_cast<std::size_t>(m_extent[1])
+                + static_cast<std::size_t>(local[1]))
+                 * static_cast<std::size_t>(m_extent[0])
+               + static_cast<std::size_t>(local[0]);
+    }
+
+    inline BinaryVolume::Point
+      BinaryVolume::getPoint(std::size_t index) const
+    {
+        auto const width  = static_cast<std::size_t>(m_extent[0]);
+        auto const height = static_cast<std::size_t>(m_extent[1]);
+        Point const local(static_cast<DGtal::Z3i::Integer>(index % width),
+                          static_cast<DGtal::Z3i::Integer>(index / width % height),
+                          static_cast<DGtal::Z3i::Integer>(index / width / height));
+        return m_domain.lowerBound() + local;
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_BINARYVOLUME_INL
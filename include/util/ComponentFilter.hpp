@@ -0,0 +1,68 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_COMPONENTFILTER_HPP
+#define TD_UTIL_COMPONENTFILTER_HPP
+
+#include <util/DigitalComponent.hpp>
+
+#include <optional>
+#include <vector>
+
+namespace td::util
+{
+    /// Criteria to keep components, unset ones are not checked.
+    /// Cheap criteria come first: rim contact from the cached bounding box,
+    /// area from the number of points, aspect ratio from the cached moments.
+    /// Circularity is by far the most expensive: getCircularity tracks the boundary of the component
+    /// and runs its greedy segmentation into digital straight segments, linear in the length of the boundary
+    /// but many times the cost of the other criteria. It is only computed for the components left,
+    /// and kept with their geometry, so that later perimeters and circularities are free.
+    /// \tparam dimension
+    /// \tparam Topology_T
+    template <int dimension, class Topology_T>
+    struct ComponentFilter
+    {
+        /** --------- typedefs ------------- **/
+        typedef DigitalComponent<dimension, Topology_T> Component;
+
+        typedef typename Component::Domain      Domain;
+        typedef typename Component::Area        Area;
+        typedef typename Component::FloatScalar FloatScalar;
+
+        /** --------- methods ------------- **/
+        /// \param component
+        /// \return whether the component passes all set criteria.
+        [[nodiscard]] bool
+          operator()(Component const & component) const;
+
+        /// Removes the components which do not pass, in a single pass keeping the order of the others.
+        /// \param components
+        /// \return number of components removed.
+        std::size_t
+          apply(std::vector<Component> & components) const;
+
+        /// Filter passing the components which pass both filters, so that a sequence of filters can be kept as one.
+        /// \param other
+        /// \return
+        [[nodiscard]] ComponentFilter
+          combine(ComponentFilter const & other) const;
+
+        /** --------- data ------------- **/
+        // Components touching the rim of this domain are discarded.
+        std::optional<Domain> rim;
+        // Count area.
+        std::optional<Area> minimumArea;
+        std::optional<Area> maximumArea;
+        std::optional<FloatScalar> minimumAspectRatio;
+        std::optional<FloatScalar> maximumAspectRatio;
+        // Tracks the boundary and segments it, see above.
+        std::optional<FloatScalar> minimumCircularity;
+        std::optional<FloatScalar> maximumCircularity;
+    };
+}  // namespace td::util
+
+#include "ComponentFilter.inl"
+
+#endif  // TD_UTIL_COMPONENTFILTER_HPP
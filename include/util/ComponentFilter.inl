@@ -0,0 +1,101 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_COMPONENTFILTER_INL
+#define TD_UTIL_COMPONENTFILTER_INL
+
+#include <algorithm>
+#include <type_traits>
+
+namespace td::util
+{
+    template <int dimension, class Topology_T>
+    bool
+      ComponentFilter<dimension, Topology_T>::operator()(Component const & component) const
+    {
+        if (rim.has_value() && component.isBorderingRim(rim.value()))
+        {
+            return false;
+        }
+        Area const area = component.getCountArea();
+        if ((minimumArea.has_value() && area < minimumArea.value())
+            || (maximumArea.has_value() && area > maximumArea.value()))
+        {
+            return false;
+        }
+        if (minimumAspectRatio.has_value() || maximumAspectRatio.has_value())
+        {
+            FloatScalar const aspectRatio = component.getAspectRatio();
+            if ((minimumAspectRatio.has_value() && aspectRatio < minimumAspectRatio.value())
+                || (maximumAspectRatio.has_value() && aspectRatio > maximumAspectRatio.value()))
+            {
+                return false;
+            }
+        }
+        // Last, it tracks the boundary and segments it.
+        if (minimumCircularity.has_value() || maximumCircularity.has_value())
+        {
+            FloatScalar const circularity = component.getCircularity();
+            if ((minimumCircularity.has_value() && circularity < minimumCircularity.value())
+                || (maximumCircularity.has_value() && circularity > maximumCircularity.value()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <int dimension, class Topology_T>
+    std::size_t
+      ComponentFilter<dimension, Topology_T>::apply(std::vector<Component> & components) const
+    {
+        // remove_if moves each kept component at most once, and keeps their order.
+        auto const end = std::remove_if(components.begin(),
+                                        components.end(),
+                                        [this](Component const & component) { return !(*this)(component); });
+        auto const removed = static_cast<std::size_t>(std::distance(end, components.end()));
+        components.erase(end, components.end());
+        return removed;
+    }
+
+    template <int dimension, class Topology_T>
+    ComponentFilter<dimension, Topology_T>
+      ComponentFilter<dimension, Topology_T>::combine(ComponentFilter const & other) const
+    {
+        // The tighter bound of each criterion.
+        auto const tighter = [](auto const & first, auto const & second, auto const & choose)
+        {
+            if (!first.has_value() || !second.has_value())
+            {
+                return first.has_value() ? first : second;
+            }
+            return std::decay_t<decltype(first)>(choose(first.value(), second.value()));
+        };
+        auto const larger  = [](auto const & a, auto const & b) { return std::max(a, b); };
+        auto const smaller = [](auto const & a, auto const & b) { return std::min(a, b); };
+
+        ComponentFilter combined;
+        // Inside the borderless parts of both rims is inside the borderless part of their intersection.
+        combined.rim = tighter(rim,
+                               other.rim,
+                               [](Domain const & a, Domain const & b)
+                               {
+                                   typedef typename Domain::Point Point;
+                                   Point const upper = a.upperBound().inf(b.upperBound());
+                                   Point const lower = a.lowerBound().sup(b.lowerBound());
+                                   // Disjoint rims: the empty domain, which every component borders.
+                                   return lower.isLower(upper) ? Domain(lower, upper)
+                                                               : Domain(upper + Point::diagonal(), upper);
+                               });
+        combined.minimumArea        = tighter(minimumArea, other.minimumArea, larger);
+        combined.maximumArea        = tighter(maximumArea, other.maximumArea, smaller);
+        combined.minimumAspectRatio = tighter(minimumAspectRatio, other.minimumAspectRatio, larger);
+        combined.maximumAspectRatio = tighter(maximumAspectRatio, other.maximumAspectRatio, smaller);
+        combined.minimumCircularity = tighter(minimumCircularity, other.minimumCircularity, larger);
+        combined.maximumCircularity = tighter(maximumCircularity, other.maximumCircularity, smaller);
+        return combined;
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_COMPONENTFILTER_INL
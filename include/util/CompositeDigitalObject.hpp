@@ -5,11 +5,20 @@
 #ifndef TD_UTIL_COMPOSITEDIGITALOBJECT_HPP
 #define TD_UTIL_COMPOSITEDIGITALOBJECT_HPP
 
+#include <util/BandedRaster.hpp>
+#include <util/BinaryPyramid.hpp>
+#include <util/ComponentFilter.hpp>
 #include <util/DigitalComponent.hpp>
+#include <util/Profiler.hpp>
+#include <util/UniformGrid2D.hpp>
+#include <util/parallel.hpp>
 
 #include <DGtal/images/RigidTransformation2D.h>
 #include <DGtal/images/ConstImageAdapter.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <optional>
 
 namespace td::util
@@ -35,8 +44,11 @@ namespace td::util
         typedef typename Component::PointSet   DigitalSet;
 
         typedef typename Component::AngleRadian AngleRadian;
+        typedef typename Component::FloatScalar FloatScalar;
+        typedef typename Component::Matrix      Matrix;
 
         typedef typename Component::Perimeter Perimeter;
+        typedef typename Component::Calipers  Calipers;
         // Image type
         typedef typename Component::Image Image;
 
@@ -54,16 +66,49 @@ namespace td::util
 
         typedef typename Component::DistanceTransform DistanceTransform;
 
+        typedef ComponentFilter<dimension, Topology_T> Filter;
+
+        // Multiresolution
+        typedef BinaryPyramid<dimension, Topology_T> Pyramid;
+
         // other
         typedef DGtal::Color Colour;
 
+        /// Rigid transformation aligning another object onto this one,
+        /// to be applied to it with transformRigidBackward(centre, angle, translation).
+        struct Registration
+        {
+            AngleRadian angle;
+            RealPoint   centre;
+            RealVector  translation;
+            // Root mean square distance of the last correspondences.
+            Perimeter rms;
+            int       iterations;
+        };
+
+        /// Candidate rigid transformation of another object, same convention as Registration.
+        struct Alignment
+        {
+            AngleRadian angle;
+            RealPoint   centre;
+            RealVector  translation;
+            // Hausdorff distance after the transformation, set by searchAlignments.
+            Perimeter distance;
+        };
+
         /** --------- methods ------------- **/
         // c-tor
-        inline explicit CompositeDigitalObject(Image const & image);
+        inline explicit CompositeDigitalObject(Image image);
 
-        inline CompositeDigitalObject(CompositeDigitalObject const &);
-        // And for some reason it does not compile if I mark this as noexcept..
-        inline CompositeDigitalObject(CompositeDigitalObject &&) = default;
+        // The pixels, distance transform and pyramid are shared between copies:
+        // copies are shallow, transformations replace them,
+        // applyPatch copies the bands of rows it writes first if they are shared (see BandedRaster).
+        CompositeDigitalObject(CompositeDigitalObject const &) = default;
+        CompositeDigitalObject(CompositeDigitalObject &&) noexcept = default;
+        CompositeDigitalObject &
+          operator=(CompositeDigitalObject const &) = default;
+        CompositeDigitalObject &
+          operator=(CompositeDigitalObject &&) noexcept = default;
 
         /// Set custom interest point. Will be transformed with the object.
         /// \param interestPoint
@@ -71,8 +116,34 @@ namespace td::util
 
         std::optional<Point> getInterestPoint() const;
 
+        /// No patch can be applied afterwards, applyPatch throws.
         void cullAllButLargestComponent();
 
+        /// Removes the components which do not pass the filter,
+        /// to discard debris before computing any geometry (but for a circularity criterion, see ComponentFilter).
+        /// The filter is kept for the components of later patches.
+        /// \param filter
+        /// \return number of components removed.
+        std::size_t
+          filterComponents(Filter const & filter);
+
+        /// Replaces the pixels of a region, for small edits of a large image.
+        /// Only the components next to a pixel which enters or leaves the foreground are labelled again,
+        /// the others keep their computed geometry.
+        /// Components which grow or merge are joined from their points. A component which loses points is
+        /// only walked again when its points left do not connect around the change (see c_patchMargin).
+        /// New components go through the filters applied so far: the rim, as in the constructor,
+        /// and those of filterComponents.
+        /// The distance transform is computed again around the changed sites only,
+        /// as far as the change can propagate (found by doubling a margin, see c_patchMargin).
+        /// \param region clipped by the domain of the image.
+        /// \param newPixels its domain must include the region.
+        /// Throws after cullAllButLargestComponent: the other components are gone,
+        /// so the largest one can't be found again.
+        /// \return number of new components, appended to the components.
+        std::size_t
+          applyPatch(Domain const & region, Image const & newPixels);
+
         void
           transformRigidForward(RealPoint const & rotCentre, AngleRadian angle, RealVector const & translation);
         void
@@ -81,6 +152,72 @@ namespace td::util
 
         [[nodiscard]] Perimeter computeHausdorffDistance(CompositeDigitalObject const & other) const;
         [[nodiscard]] Perimeter computeDubuissonJainDissimilarity(CompositeDigitalObject const & other) const;
+        /// Hausdorff distance between the components of both objects, measured at a level of their pyramids.
+        /// It is within Pyramid::getLevelError(level) of the distance at full resolution (level 0).
+        [[nodiscard]] Perimeter computeHausdorffDistance(CompositeDigitalObject const & other,
+                                                         std::size_t                    level) const;
+        /// Same, after moving other by an alignment.
+        [[nodiscard]] Perimeter computeHausdorffDistance(CompositeDigitalObject const & other,
+                                                         Alignment const &              alignment,
+                                                         std::size_t                    level) const;
+
+        /// Keeps the best candidate alignments of other onto this object.
+        /// All candidates are evaluated at the coarsest level of the pyramids,
+        /// and only those which can still be among the best are evaluated at the next finer level.
+        /// \param other
+        /// \param candidates
+        /// \param numberSurvivors
+        /// \return at most numberSurvivors alignments, by increasing Hausdorff distance at full resolution.
+        [[nodiscard]] std::vector<Alignment> searchAlignments(CompositeDigitalObject const & other,
+                                                              std::vector<Alignment>         candidates,
+                                                              std::size_t numberSurvivors = 1) const;
+
+        /// Domain of the image.
+        [[nodiscard]] inline Domain const &
+          getDomain() const;
+
+        /// Pyramid of the components, built on first use.
+        /// Safe to call from several threads, the first one builds it and the others wait.
+        [[nodiscard]] Pyramid const &
+          getPyramid() const;
+
+        /// Builds the local windows and medial axes of all components, spread over threads.
+        /// Each component only reads its own points, no image is reloaded.
+        /// \param numberThreads 0 to use all hardware threads.
+        void
+          computeMedialAxes(unsigned int numberThreads = 0) const;
+
+        /// Feret diameters and minimum-area rectangles of all components (see DigitalComponent::getCalipers),
+        /// the components being spread over threads. Each one tracks its boundary and hull first if needed.
+        /// \param numberThreads 0 to use all hardware threads.
+        /// \return in the order of the components.
+        [[nodiscard]] std::vector<Calipers>
+          computeCalipers(unsigned int numberThreads = 0) const;
+
+        /// Iterative closest point registration of the boundary of the first component of other
+        /// onto the boundary of the first component of this object (see cullAllButLargestComponent).
+        /// Correspondences are searched on a subsample of the boundary first, refined down to every point.
+        /// \param other
+        /// \param maxIterations per level of subsampling.
+        /// \param tolerance stops a level when the rms distance improves by less than that.
+        /// \return
+        [[nodiscard]] Registration computeRegistration(CompositeDigitalObject const & other,
+                                                       int       maxIterations = c_registrationIterations,
+                                                       Perimeter tolerance     = c_registrationTolerance) const;
+
+        /// Records the pixels of the components and the interest point, to be rendered later.
+        inline void
+        drawObjectComponents(DrawingBuffer & drawing,
+             Colour const &   objectColour        = Colour::None,
+             Colour const &   interestPointColour = Colour::Magenta) const;
+
+        /// One drawing per component, recorded in parallel:
+        /// its pixels in the colour of its label (see DrawingBuffer::getLabelColour),
+        /// then its boundary, hull and segments as in DigitalComponent::draw.
+        /// Meant for a RasterOverlay over the image domain.
+        /// \param numberThreads 0 to use all hardware threads.
+        [[nodiscard]] std::vector<DrawingBuffer>
+          drawComponents(unsigned int numberThreads = 0) const;
 
         inline void
         drawObjectComponents(DGtal::Board2D & board,
@@ -95,26 +232,118 @@ namespace td::util
         /** --------- methods ------------- **/
         [[nodiscard]] inline static std::vector<Object>
           computeObjectComponents(Object const & object);
+        /// Flood fill of the component of a seed, with the foreground adjacency of the topology.
+        /// The points are gathered first, so that the object is built over its window once.
+        /// \param seed
+        /// \param domain points outside are background.
+        /// \param isForeground
+        /// \param visited points already in a component, the new ones are added.
+        /// \return object over the window of the component (see DigitalComponent::getWindow).
+        template <class Predicate>
+        [[nodiscard]] static Object
+          computeComponentObject(Point const &     seed,
+                                 Domain const &    domain,
+                                 Predicate const & isForeground,
+                                 DigitalSet &      visited);
         [[nodiscard]] inline static Object
           computeObject(Image const & image);
-        [[nodiscard]] inline static DistanceTransform
+        [[nodiscard]] inline static std::shared_ptr<DistanceTransform const>
           computeBackgroundDistanceTransform(Image const & image);
+        /// Image of the pixels, for the transformations.
+        [[nodiscard]] Image
+          createImage() const;
+        [[nodiscard]] inline typename Image::Value
+          getPixel(Point const & point) const;
+        /// Copies the band of the pixel first if it is shared.
+        inline void
+          setPixel(Point const & point, typename Image::Value value);
         /// Removes the components whose set of points include a border point.
         /// \param components
         void
           cullBorderComponents();
-        void reset(Image const & image);
+        void reset(Image image);
+
+        /// New components around the points which entered or left the foreground (see applyPatch).
+        /// \param added
+        /// \param removed
+        /// \return number of new components.
+        std::size_t
+          relabelChanges(std::vector<Point> const & added, std::vector<Point> const & removed);
+
+        /// Distances updated after the pixels of a region changed (see applyPatch).
+        void
+          updateBackgroundDistanceTransform(Domain const & region);
+
+        /// Payload of a shared pointer, copied first unless this object is its only owner.
+        /// The payloads are created mutable (see reset), only their owners see them as constant.
+        template <class T>
+        [[nodiscard]] static T &
+          getUniquePayload(std::shared_ptr<T const> & payload);
+
+        /// Hausdorff distance between the components of this object
+        /// and the components of the other one transformed by the alignment.
+        [[nodiscard]] Perimeter computeAlignmentDistance(CompositeDigitalObject const & other,
+                                                         Alignment const &              alignment,
+                                                         std::size_t                    level) const;
 
         /** --------- data ------------- **/
-        Image m_image;
-        Object m_object;
+        // Values of the image.
+        Domain                              m_domain;
+        BandedRaster<typename Image::Value> m_pixels;
         // Point of interest (optional)
         std::optional<Point> m_interestPoint;
-        DistanceTransform    m_backgroundDistanceTransform;
+        std::shared_ptr<DistanceTransform const> m_backgroundDistanceTransform;
+        /// Value built from the components by the first thread which needs it, the others wait for it.
+        /// Unlike the stages of a component, it is dropped when the components change:
+        /// a mutex guards it rather than a once_flag, which can't be reset nor copied.
+        template <class T>
+        class Lazy
+        {
+           public:
+            Lazy() = default;
+            // Copies take the value if it was built, moves are not guarded.
+            inline Lazy(Lazy const & other);
+            inline Lazy(Lazy && other) noexcept;
+            inline Lazy &
+              operator=(Lazy const & other);
+            inline Lazy &
+              operator=(Lazy && other) noexcept;
+
+            /// \param compute () -> std::shared_ptr<T const>, called once until reset.
+            template <class Compute>
+            T const &
+              get(Compute const & compute) const;
+            /// Drops the value, not to be called along get.
+            inline void
+              reset();
+
+           private:
+            std::mutex mutable               m_mutex;
+            std::shared_ptr<T const> mutable m_value;
+            // Set with the value, read without locking once it is built.
+            std::atomic<T const *> mutable m_pointer {nullptr};
+        };
+
+        // Coarse levels of the components (lazy).
+        Lazy<Pyramid> m_pyramid;
+        // Filters applied so far, as one, for the components of the patches.
+        Filter m_filter;
+        // Set by cullAllButLargestComponent, patches are refused after it.
+        bool m_isCulled;
         // Topology object
         inline static DigitalTopology const s_topology = DGtal::Z2i::dt4_8;
-        // Metric object
-        inline static Metric const s_metric = DGtal::Z2i::l2Metric;
+
+        // Registration parameters.
+        static constexpr int         c_registrationIterations   = 30;
+        static constexpr double      c_registrationTolerance    = 1e-3;
+        // Number of boundary points of the coarsest level, each level has c_registrationRefinement times more.
+        static constexpr std::size_t c_registrationCoarsePoints = 64;
+        static constexpr std::size_t c_registrationRefinement   = 4;
+        static constexpr double      c_registrationCellSize     = 4.;
+
+        // Margin around the changes of a patch: the box where components which lose points are checked
+        // to stay connected, and the first margin of the distance transform, doubled until its update is exact.
+        static constexpr typename Space::Integer c_patchMargin = 16;
 
     };
 }  // namespace td::util
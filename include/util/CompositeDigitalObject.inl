@@ -5,76 +5,525 @@
 #ifndef TD_UTIL_DIGITALOBJECTWRAPPER_INL
 #define TD_UTIL_DIGITALOBJECTWRAPPER_INL
 
+#include <DGtal/base/Exceptions.h>
 #include <DGtal/images/imagesSetsUtils/SetFromImage.h>
-// cloning mechanism (deep copy)
-#include <DGtal/base/Clone.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
 
 namespace td::util
 {
     template <int dimension, class Topology_T>
-    inline CompositeDigitalObject<dimension, Topology_T>::CompositeDigitalObject(Image const & image)
+    inline CompositeDigitalObject<dimension, Topology_T>::CompositeDigitalObject(Image image)
         : components(),
-          m_image(DGtal::Clone(image)),
-          m_backgroundDistanceTransform(computeBackgroundDistanceTransform(m_image))
+          m_domain(image.domain()),
+          m_pixels(),
+          m_interestPoint(),
+          m_backgroundDistanceTransform(),
+          m_pyramid(),
+          m_filter(),
+          m_isCulled(false)
     {
-        // assigning m_image twice, otherwise we get a compilation error.
-        reset(image);
+        reset(std::move(image));
     }
 
     template <int dimension, class Topology_T>
     void
-    CompositeDigitalObject<dimension, Topology_T>::reset(Image const & image)
+    CompositeDigitalObject<dimension, Topology_T>::reset(Image image)
     {
-        m_image = DGtal::Clone(image);
-        m_object = computeObject(m_image);
-        std::vector<Object> objectComponents = computeObjectComponents(m_object);
+        // New payloads: copies of this object keep the previous ones.
+        m_domain = image.domain();
+        m_pixels = BandedRaster<typename Image::Value>(
+          static_cast<std::size_t>(m_domain.upperBound()[0] - m_domain.lowerBound()[0] + 1),
+          static_cast<std::size_t>(m_domain.upperBound()[1] - m_domain.lowerBound()[1] + 1));
+        for (Point point = m_domain.lowerBound(); point[1] <= m_domain.upperBound()[1]; ++point[1])
+        {
+            auto * const row = m_pixels.getMutableRow(static_cast<std::size_t>(point[1] - m_domain.lowerBound()[1]));
+            for (point[0] = m_domain.lowerBound()[0]; point[0] <= m_domain.upperBound()[0]; ++point[0])
+            {
+                row[point[0] - m_domain.lowerBound()[0]] = image(point);
+            }
+        }
+        m_pyramid.reset();
+        // All the components are back.
+        m_filter   = Filter();
+        m_isCulled = false;
+        std::vector<Object> objectComponents = computeObjectComponents(computeObject(image));
         m_backgroundDistanceTransform        = computeBackgroundDistanceTransform(image);
         components.clear();
         components.reserve(objectComponents.size());
-        for (auto const & objectComponent : objectComponents)
+        for (auto & objectComponent : objectComponents)
         {
-            components.emplace_back(objectComponent);
+            components.emplace_back(std::move(objectComponent));
         }
         // we remove the components too close to the domain's rim.
         cullBorderComponents();
     }
 
     template <int dimension, class Topology_T>
-    CompositeDigitalObject<dimension, Topology_T>::CompositeDigitalObject(CompositeDigitalObject const & other)
-        : components(other.components),
-          m_image(DGtal::Clone(other.m_image)),
-          m_object(DGtal::Clone(other.m_object)),
-          m_interestPoint(other.m_interestPoint),
-          m_backgroundDistanceTransform(other.m_backgroundDistanceTransform)
+    void
+      CompositeDigitalObject<dimension, Topology_T>::cullBorderComponents()
+    {
+        TD_PROFILE_SCOPE("cullBorderComponents");
+        m_filter.rim = m_domain;
+        m_filter.apply(components);
+    }
+
+    template <int dimension, class Topology_T>
+    std::size_t
+      CompositeDigitalObject<dimension, Topology_T>::filterComponents(Filter const & filter)
     {
+        m_filter                  = m_filter.combine(filter);
+        std::size_t const removed = filter.apply(components);
+        if (removed > 0)
+        {
+            // the pyramid included the removed components.
+            m_pyramid.reset();
+        }
+        return removed;
+    }
+
+    template <int dimension, class Topology_T>
+    std::size_t
+      CompositeDigitalObject<dimension, Topology_T>::applyPatch(Domain const & region, Image const & newPixels)
+    {
+        TD_PROFILE_SCOPE("applyPatch");
+        if (m_isCulled)
+        {
+            DGtal::trace.error() << "CompositeDigitalObject: can't patch after cullAllButLargestComponent" << std::endl;
+            throw DGtal::InputException();
+        }
+        Domain const & domain = m_domain;
+        Point const    lower  = region.lowerBound().sup(domain.lowerBound());
+        Point const    upper  = region.upperBound().inf(domain.upperBound());
+        for (int k = 0; k < dimension; ++k)
+        {
+            if (lower[k] > upper[k])
+            {
+                return 0;
+            }
+        }
+        Domain const patch(lower, upper);
+        ASSERT(newPixels.domain().isInside(lower) && newPixels.domain().isInside(upper));
+        // Same foreground as computeObject, same sites as computeBackgroundDistanceTransform.
+        auto const isForeground = [](typename Image::Value value) { return value > 1 && value <= 255; };
+
+        // 1) Pixels: only their bands of rows are copied, if shared.
+        std::vector<Point> added;
+        std::vector<Point> removed;
+        bool               isSiteChanged = false;
+        Point              siteLower     = upper;
+        Point              siteUpper     = lower;
+        for (auto const & point : patch)
+        {
+            typename Image::Value const previous = getPixel(point);
+            typename Image::Value const value    = newPixels(point);
+            if (value == previous)
+            {
+                continue;
+            }
+            setPixel(point, value);
+            if (isForeground(value) != isForeground(previous))
+            {
+                (isForeground(value) ? added : removed).push_back(point);
+            }
+            if ((value != 0) != (previous != 0))
+            {
+                isSiteChanged = true;
+                siteLower     = siteLower.inf(point);
+                siteUpper     = siteUpper.sup(point);
+            }
+        }
 
+        // 2) Components around the changes.
+        std::size_t numberNew = 0;
+        if (!added.empty() || !removed.empty())
+        {
+            numberNew = relabelChanges(added, removed);
+            // the pyramid included the old components.
+            m_pyramid.reset();
+        }
+
+        // 3) Distances around the changed sites.
+        if (isSiteChanged)
+        {
+            updateBackgroundDistanceTransform(Domain(siteLower, siteUpper));
+        }
+        return numberNew;
+    }
+
+    template <int dimension, class Topology_T>
+    std::size_t
+      CompositeDigitalObject<dimension, Topology_T>::relabelChanges(std::vector<Point> const & added,
+                                                                  std::vector<Point> const & removed)
+    {
+        TD_PROFILE_SCOPE("relabelChanges");
+        Domain const & domain            = m_domain;
+        auto const     isForegroundPoint = [this](Point const & point)
+        {
+            typename Image::Value const value = getPixel(point);
+            return value > 1 && value <= 255;
+        };
+        std::vector<Point> neighbours;
+        auto const         writeNeighbours = [&neighbours](Point const & point)
+        {
+            neighbours.clear();
+            auto inserter = std::back_inserter(neighbours);
+            s_topology.kappa().writeNeighbors(inserter, point);
+        };
+
+        // Box around the changes, the only place where the components are looked at point by point.
+        Point changedLower = added.empty() ? removed.front() : added.front();
+        Point changedUpper = changedLower;
+        for (auto const & points : {std::cref(added), std::cref(removed)})
+        {
+            for (auto const & point : points.get())
+            {
+                changedLower = changedLower.inf(point);
+                changedUpper = changedUpper.sup(point);
+            }
+        }
+        Domain const box((changedLower - Point::diagonal(c_patchMargin)).sup(domain.lowerBound()),
+                         (changedUpper + Point::diagonal(c_patchMargin)).inf(domain.upperBound()));
+        Point const  boxLower = box.lowerBound();
+        auto const   boxWidth = static_cast<std::size_t>(box.upperBound()[0] - boxLower[0] + 1);
+        auto const   indexOf  = [&boxLower, boxWidth](Point const & point)
+        {
+            return static_cast<std::size_t>(point[1] - boxLower[1]) * boxWidth
+                   + static_cast<std::size_t>(point[0] - boxLower[0]);
+        };
+
+        // Node of each point of the box: the index of its component, or numberComponents + i for added[i].
+        // Foreground points of no node belong to components removed by a filter.
+        std::size_t const        numberComponents = components.size();
+        std::size_t const        numberNodes      = numberComponents + added.size();
+        std::size_t const        none             = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> nodes(boxWidth * static_cast<std::size_t>(box.upperBound()[1] - boxLower[1] + 1), none);
+        for (std::size_t k = 0; k < numberComponents; ++k)
+        {
+            Domain const window = components[k].getWindow();
+            Point const  l      = window.lowerBound().sup(boxLower);
+            Point const  u      = window.upperBound().inf(box.upperBound());
+            if (l[0] > u[0] || l[1] > u[1])
+            {
+                continue;
+            }
+            DigitalSet const & pointSet = components[k].getPointSet();
+            for (auto const & point : Domain(l, u))
+            {
+                if (pointSet.find(point) != pointSet.end())
+                {
+                    nodes[indexOf(point)] = k;
+                }
+            }
+        }
+        for (std::size_t i = 0; i < added.size(); ++i)
+        {
+            nodes[indexOf(added[i])] = numberComponents + i;
+        }
+
+        // Groups of nodes which form one component at most: union-find over the adjacencies of the added points.
+        std::vector<std::size_t> parents(numberNodes);
+        std::iota(parents.begin(), parents.end(), std::size_t {0});
+        auto const findRoot = [&parents](std::size_t node)
+        {
+            while (parents[node] != node)
+            {
+                parents[node] = parents[parents[node]];
+                node          = parents[node];
+            }
+            return node;
+        };
+        // A group which lost points may be split, and one reaching unlabelled points needs all of theirs:
+        // both are walked again, unless the points left by the first are connected in the box.
+        enum Mark : std::uint8_t
+        {
+            c_isChanged    = 1,
+            c_isLost       = 2,
+            c_isUnlabelled = 4,
+            c_isSplit      = 8
+        };
+        std::vector<std::uint8_t> marks(numberNodes, 0);
+        // The walks start from the added points, and from the points left next to the removed ones:
+        // each piece of a component which lost points has one of them.
+        std::vector<Point> seeds(added);
+        for (std::size_t i = 0; i < added.size(); ++i)
+        {
+            marks[numberComponents + i] |= c_isChanged;
+            writeNeighbours(added[i]);
+            for (auto const & neighbour : neighbours)
+            {
+                if (!domain.isInside(neighbour) || !isForegroundPoint(neighbour))
+                {
+                    continue;
+                }
+                std::size_t const node = nodes[indexOf(neighbour)];
+                if (node == none)
+                {
+                    marks[numberComponents + i] |= c_isUnlabelled;
+                }
+                else
+                {
+                    parents[findRoot(node)] = findRoot(numberComponents + i);
+                }
+            }
+        }
+        // Points left next to removed points of no node: the pieces of a component removed by a filter,
+        // each one walked and filtered again, as it may pass now.
+        std::vector<Point> unlabelledSeeds;
+        for (auto const & point : removed)
+        {
+            std::size_t const node = nodes[indexOf(point)];
+            if (node == none)
+            {
+                writeNeighbours(point);
+                for (auto const & neighbour : neighbours)
+                {
+                    if (domain.isInside(neighbour) && nodes[indexOf(neighbour)] == none && isForegroundPoint(neighbour))
+                    {
+                        unlabelledSeeds.push_back(neighbour);
+                    }
+                }
+                continue;
+            }
+            marks[node] |= c_isChanged | c_isLost;
+            writeNeighbours(point);
+            for (auto const & neighbour : neighbours)
+            {
+                if (domain.isInside(neighbour) && nodes[indexOf(neighbour)] == node && isForegroundPoint(neighbour))
+                {
+                    seeds.push_back(neighbour);
+                }
+            }
+        }
+        for (std::size_t node = 0; node < numberNodes; ++node)
+        {
+            marks[findRoot(node)] |= marks[node];
+        }
+
+        // Connections of the groups which lost points, within the box.
+        std::vector<bool>  isReached(nodes.size(), false);
+        std::vector<Point> stack;
+        for (auto const & seed : seeds)
+        {
+            std::size_t const root = findRoot(nodes[indexOf(seed)]);
+            if ((marks[root] & (c_isLost | c_isUnlabelled)) != c_isLost || isReached[indexOf(seed)])
+            {
+                continue;
+            }
+            // Another seed of the group already reached this one, or the group is split.
+            if (marks[root] & c_isSplit)
+            {
+                continue;
+            }
+            marks[root] |= c_isSplit;
+            isReached[indexOf(seed)] = true;
+            stack.assign(1, seed);
+            while (!stack.empty())
+            {
+                Point const point = stack.back();
+                stack.pop_back();
+                writeNeighbours(point);
+                for (auto const & neighbour : neighbours)
+                {
+                    if (box.isInside(neighbour) && !isReached[indexOf(neighbour)] && isForegroundPoint(neighbour))
+                    {
+                        isReached[indexOf(neighbour)] = true;
+                        stack.push_back(neighbour);
+                    }
+                }
+            }
+        }
+        // c_isSplit was set on every group checked: it is cleared when all its seeds were reached.
+        std::vector<bool> isConnected(numberNodes, true);
+        for (auto const & seed : seeds)
+        {
+            if (!isReached[indexOf(seed)])
+            {
+                isConnected[findRoot(nodes[indexOf(seed)])] = false;
+            }
+        }
+        for (std::size_t node = 0; node < numberNodes; ++node)
+        {
+            if ((marks[node] & c_isSplit) && isConnected[node])
+            {
+                marks[node] &= static_cast<std::uint8_t>(~c_isSplit);
+            }
+        }
+
+        // New components: the groups walked again from their seeds, the others joined from their points,
+        // all going through the filter below.
+        auto const isWalked = [&marks](std::size_t root) { return (marks[root] & (c_isUnlabelled | c_isSplit)) != 0; };
+        std::vector<Object> objects;
+        DigitalSet          visited(domain);
+        for (auto const & seed : seeds)
+        {
+            if (isWalked(findRoot(nodes[indexOf(seed)])) && visited.find(seed) == visited.end())
+            {
+                objects.push_back(computeComponentObject(seed, domain, isForegroundPoint, visited));
+            }
+        }
+        // A piece joined to added points was already walked from them.
+        for (auto const & seed : unlabelledSeeds)
+        {
+            if (visited.find(seed) == visited.end())
+            {
+                objects.push_back(computeComponentObject(seed, domain, isForegroundPoint, visited));
+            }
+        }
+        std::vector<std::pair<std::size_t, std::size_t>> members;
+        for (std::size_t node = 0; node < numberNodes; ++node)
+        {
+            std::size_t const root = findRoot(node);
+            if ((marks[root] & c_isChanged) && !isWalked(root))
+            {
+                members.emplace_back(root, node);
+            }
+        }
+        std::sort(members.begin(), members.end());
+        std::vector<Point> points;
+        for (auto first = members.begin(); first != members.end();)
+        {
+            auto const last = std::find_if(
+              first, members.end(), [root = first->first](auto const & member) { return member.first != root; });
+            bool const isLost = (marks[first->first] & c_isLost) != 0;
+            points.clear();
+            for (auto member = first; member != last; ++member)
+            {
+                if (member->second >= numberComponents)
+                {
+                    points.push_back(added[member->second - numberComponents]);
+                    continue;
+                }
+                for (auto const & point : components[member->second].getPointSet())
+                {
+                    if (!isLost || isForegroundPoint(point))
+                    {
+                        points.push_back(point);
+                    }
+                }
+            }
+            first = last;
+            if (points.empty())
+            {
+                continue;
+            }
+            Point lower = points.front();
+            Point upper = lower;
+            for (auto const & point : points)
+            {
+                lower = lower.inf(point);
+                upper = upper.sup(point);
+            }
+            // The domain of each component is its window.
+            DigitalSet set(Domain(lower - Point::diagonal(), upper + Point::diagonal()));
+            set.insertNew(points.begin(), points.end());
+            objects.emplace_back(s_topology, set);
+        }
+
+        // The changed components are replaced, the others keep their order.
+        std::size_t kept = 0;
+        for (std::size_t k = 0; k < numberComponents; ++k)
+        {
+            if (marks[findRoot(k)] & c_isChanged)
+            {
+                continue;
+            }
+            if (kept != k)
+            {
+                components[kept] = std::move(components[k]);
+            }
+            ++kept;
+        }
+        components.erase(components.begin() + static_cast<std::ptrdiff_t>(kept), components.end());
+
+        std::vector<Component> relabelled;
+        relabelled.reserve(objects.size());
+        std::size_t numberPoints = 0;
+        for (auto & object : objects)
+        {
+            numberPoints += object.size();
+            relabelled.emplace_back(std::move(object));
+        }
+        TD_PROFILE_COUNT("patch points relabelled", numberPoints);
+        m_filter.apply(relabelled);
+        for (auto & component : relabelled)
+        {
+            components.push_back(std::move(component));
+        }
+        return relabelled.size();
     }
 
     template <int dimension, class Topology_T>
     void
-      CompositeDigitalObject<dimension, Topology_T>::cullBorderComponents()
+      CompositeDigitalObject<dimension, Topology_T>::updateBackgroundDistanceTransform(Domain const & region)
     {
-        Domain const & compositeDomain = m_object.domain();
-        // IMPORTANT:
-        // be mindful to use it < components.end()
-        // as an end condition,
-        // because of erasure, the iterator index gets messed up,
-        // and can jump the end such that it > components.end()
-        for (auto it = components.begin(); it < components.end();)
+        TD_PROFILE_SCOPE("updateBackgroundDistanceTransform");
+        typedef typename DistanceTransform::SquaredDistance SquaredDistance;
+        Domain const &            domain   = m_domain;
+        DistanceTransform const & previous = *m_backgroundDistanceTransform;
+        auto const isSite = [this](Point const & point) { return getPixel(point) != 0; };
+        auto const grow   = [&domain](Domain const & box, typename Space::Integer margin)
+        {
+            return Domain((box.lowerBound() - Point::diagonal(margin)).sup(domain.lowerBound()),
+                          (box.upperBound() + Point::diagonal(margin)).inf(domain.upperBound()));
+        };
+        for (auto margin = c_patchMargin;; margin *= 2)
         {
-            if (it->isBorderingRim(compositeDomain))
+            // The window covers the region grown by twice the margin.
+            DistanceTransform local = DistanceTransform::computeLocal(domain, isSite, region, 2 * margin);
+            if (local.domain().lowerBound() == domain.lowerBound()
+                && local.domain().upperBound() == domain.upperBound())
             {
-                it = components.erase(it);
+                // It is the whole map.
+                m_backgroundDistanceTransform = std::make_shared<DistanceTransform>(std::move(local));
+                return;
             }
-            else
+            // Only the region grown by the margin is updated. Both conditions make it exact:
+            // - every point of the inner box is closer than the margin to a site,
+            //   hence closer than any site outside of the window;
+            // - the old distances are below the margin on the border of the inner box.
+            //   A point outside whose nearest site was (or now is) in the region would see the segment
+            //   to that site cross the border, at a point as far from the site as the margin.
+            Domain const          inner = grow(region, margin);
+            SquaredDistance const limit = static_cast<SquaredDistance>(margin - 1) * (margin - 1);
+            bool                  isExact = true;
+            for (auto const & point : inner)
             {
-                ++it;
+                bool const isBorder = point[0] == inner.lowerBound()[0] || point[0] == inner.upperBound()[0]
+                                      || point[1] == inner.lowerBound()[1] || point[1] == inner.upperBound()[1];
+                if (local.getSquaredDistance(point) >= limit
+                    || (isBorder && previous.getSquaredDistance(point) >= limit))
+                {
+                    isExact = false;
+                    break;
+                }
+            }
+            if (isExact)
+            {
+                getUniquePayload(m_backgroundDistanceTransform).paste(local, inner);
+                return;
             }
         }
     }
 
+    template <int dimension, class Topology_T>
+    template <class T>
+    T &
+      CompositeDigitalObject<dimension, Topology_T>::getUniquePayload(std::shared_ptr<T const> & payload)
+    {
+        if (payload.use_count() != 1)
+        {
+            payload = std::make_shared<T>(*payload);
+        }
+        return *std::const_pointer_cast<T>(payload);
+    }
+
     template <int dimension, class Topology_T>
     inline void
       CompositeDigitalObject<dimension, Topology_T>::setInterestPoint(Point interestPoint)
@@ -98,14 +547,14 @@ namespace td::util
     {
         ForwardTransform forwardTransform (rotCentre, angle, translation);
         DomainTransformer megatron (forwardTransform);
-        Bounds bounds = megatron (m_image.domain());
+        Bounds bounds = megatron (m_domain);
         Domain transformedDomain (bounds.first, bounds.second);
 
         Image transformedImage (transformedDomain);
         // Compute the resulting point from each point in the original image.
-        for (auto const & point : m_image.domain())
+        for (auto const & point : m_domain)
         {
-            transformedImage.setValue(forwardTransform(point), m_image(point));
+            transformedImage.setValue(forwardTransform(point), getPixel(point));
         }
         // Also transform the interest point if set.
         if (m_interestPoint.has_value())
@@ -113,7 +562,7 @@ namespace td::util
             setInterestPoint(forwardTransform(m_interestPoint.value()));
         }
         // reset the object with the transformed image.
-        reset(transformedImage);
+        reset(std::move(transformedImage));
     }
 
     template <int dimension, class Topology_T>
@@ -127,15 +576,16 @@ namespace td::util
         // Compute transformed domain from the forward transform.
         ForwardTransform forwardTransform (rotCentre, angle, translation);
         DomainTransformer megatron (forwardTransform);
-        Bounds bounds = megatron (m_image.domain());
+        Bounds bounds = megatron (m_domain);
         Domain transformedDomain (bounds.first, bounds.second);
         DGtal::functors::Identity id {};
         //
 
         Image transformedImage (transformedDomain);
 
+        Image const image = createImage();
         ImageBackwardAdapter  imageBackwardAdapter (
-          m_image,
+          image,
           transformedDomain,
           backwardTransform,
           id
@@ -153,13 +603,14 @@ namespace td::util
         }
 
         // reset the object with the transformed image.
-        reset(transformedImage);
+        reset(std::move(transformedImage));
     }
 
     template <int dimension, class Topology_T>
     typename CompositeDigitalObject<dimension, Topology_T>::Object
       CompositeDigitalObject<dimension, Topology_T>::computeObject(Image const & image)
     {
+        TD_PROFILE_SCOPE("computeObject");
         // 1) Create a digital set of proper size
         DigitalSet set2d(image.domain());
         // 2) Use SetFromImage::append() to populate a digital set from the input image
@@ -172,11 +623,41 @@ namespace td::util
 
 
     template <int dimension, class Topology_T>
-    inline typename CompositeDigitalObject<dimension, Topology_T>::DistanceTransform
+    inline std::shared_ptr<typename CompositeDigitalObject<dimension, Topology_T>::DistanceTransform const>
     CompositeDigitalObject<dimension, Topology_T>::computeBackgroundDistanceTransform(Image const & image)
     {
-        Binariser bin (image, -1, 0);
-        return DistanceTransform(&image.domain(), &bin, &s_metric);
+        TD_PROFILE_SCOPE("backgroundDistanceTransform");
+        // Distance to the nearest point of the object.
+        return std::make_shared<DistanceTransform>(image.domain(),
+                                                   [&image](Point const & point) { return image(point) != 0; });
+    }
+
+    template <int dimension, class Topology_T>
+    typename CompositeDigitalObject<dimension, Topology_T>::Image
+      CompositeDigitalObject<dimension, Topology_T>::createImage() const
+    {
+        Image image(m_domain);
+        for (auto const & point : m_domain)
+        {
+            image.setValue(point, getPixel(point));
+        }
+        return image;
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename CompositeDigitalObject<dimension, Topology_T>::Image::Value
+      CompositeDigitalObject<dimension, Topology_T>::getPixel(Point const & point) const
+    {
+        Point const local = point - m_domain.lowerBound();
+        return m_pixels.getRow(static_cast<std::size_t>(local[1]))[local[0]];
+    }
+
+    template <int dimension, class Topology_T>
+    inline void
+      CompositeDigitalObject<dimension, Topology_T>::setPixel(Point const & point, typename Image::Value value)
+    {
+        Point const local = point - m_domain.lowerBound();
+        m_pixels.getMutableRow(static_cast<std::size_t>(local[1]))[local[0]] = value;
     }
 
 
@@ -185,14 +666,94 @@ namespace td::util
       CompositeDigitalObject<dimension, Topology_T>::computeObjectComponents(
         Object const & object)
     {
+        TD_PROFILE_SCOPE("computeObjectComponents");
+        TD_PROFILE_COUNT("component points visited", object.size());
         // create output
         std::vector<Object> components;
-        // create output iterator
-        std::back_insert_iterator<std::vector<Object>> inserter(components);
-        object.writeComponents(inserter);
+        if constexpr (FlatTopologyTraits<dimension, DigitalTopology>::c_isSpecialised)
+        {
+            // Labelling on the raster, rather than through the generic neighbourhoods.
+            FlatMask2D const mask(object.pointSet());
+            auto const       flatComponents =
+              FlatTopology2D<FlatTopologyTraits<dimension, DigitalTopology>::c_foregroundAdjacency>::labelComponents(
+                mask);
+            components.reserve(flatComponents.size());
+            for (auto const & flatComponent : flatComponents)
+            {
+                // The domain of each component is its window (see DigitalComponent::getWindow).
+                Point lower(flatComponent.front().x, flatComponent.front().y);
+                Point upper = lower;
+                for (auto const & point : flatComponent)
+                {
+                    lower = lower.inf(Point(point.x, point.y));
+                    upper = upper.sup(Point(point.x, point.y));
+                }
+                DigitalSet set(Domain(lower - Point::diagonal(), upper + Point::diagonal()));
+                for (auto const & point : flatComponent)
+                {
+                    set.insertNew(Point(point.x, point.y));
+                }
+                components.emplace_back(object.topology(), set);
+            }
+        }
+        else
+        {
+            // Rather than writeComponents, whose objects have the whole domain
+            // and would be copied again over their windows.
+            TD_PROFILE_SCOPE("floodFill");
+            DigitalSet visited(object.domain());
+            auto const isForeground = [&object](Point const & point)
+            { return object.pointSet().find(point) != object.pointSet().end(); };
+            for (auto const & seed : object.pointSet())
+            {
+                if (visited.find(seed) == visited.end())
+                {
+                    components.push_back(computeComponentObject(seed, object.domain(), isForeground, visited));
+                }
+            }
+        }
         return components;
     }
 
+    template <int dimension, class Topology_T>
+    template <class Predicate>
+    typename CompositeDigitalObject<dimension, Topology_T>::Object
+      CompositeDigitalObject<dimension, Topology_T>::computeComponentObject(Point const &     seed,
+                                                                          Domain const &    domain,
+                                                                          Predicate const & isForeground,
+                                                                          DigitalSet &      visited)
+    {
+        std::vector<Point> stack(1, seed);
+        std::vector<Point> points;
+        std::vector<Point> neighbours;
+        visited.insertNew(seed);
+        Point lower = seed;
+        Point upper = seed;
+        while (!stack.empty())
+        {
+            Point const point = stack.back();
+            stack.pop_back();
+            points.push_back(point);
+            lower = lower.inf(point);
+            upper = upper.sup(point);
+            neighbours.clear();
+            auto inserter = std::back_inserter(neighbours);
+            s_topology.kappa().writeNeighbors(inserter, point);
+            for (auto const & neighbour : neighbours)
+            {
+                if (domain.isInside(neighbour) && isForeground(neighbour) && visited.find(neighbour) == visited.end())
+                {
+                    visited.insertNew(neighbour);
+                    stack.push_back(neighbour);
+                }
+            }
+        }
+        // The domain of each component is its window.
+        DigitalSet set(Domain(lower - Point::diagonal(), upper + Point::diagonal()));
+        set.insertNew(points.begin(), points.end());
+        return Object(s_topology, set);
+    }
+
 
     template <int dimension, class Topology_T>
     typename CompositeDigitalObject<dimension, Topology_T>::Perimeter
@@ -200,10 +761,10 @@ namespace td::util
       CompositeDigitalObject const & other
     ) const
     {
-        //
+        TD_PROFILE_SCOPE("computeHausdorffDistance");
         return std::max(
-        this->components.front().computeLargestDistance(other.m_backgroundDistanceTransform),
-          other.components.front().computeLargestDistance(this->m_backgroundDistanceTransform)
+        this->components.front().computeLargestDistance(*other.m_backgroundDistanceTransform),
+          other.components.front().computeLargestDistance(*this->m_backgroundDistanceTransform)
         );
     }
 
@@ -212,13 +773,319 @@ namespace td::util
     CompositeDigitalObject<dimension, Topology_T>::computeDubuissonJainDissimilarity(
         CompositeDigitalObject const & other) const
     {
-        //
+        TD_PROFILE_SCOPE("computeDubuissonJainDissimilarity");
         return std::max(
-          components.front().computeAverageDistance(other.m_backgroundDistanceTransform),
-          other.components.front().computeAverageDistance(this->m_backgroundDistanceTransform)
+          components.front().computeAverageDistance(*other.m_backgroundDistanceTransform),
+          other.components.front().computeAverageDistance(*this->m_backgroundDistanceTransform)
         );
     }
 
+    template <int dimension, class Topology_T>
+    inline typename CompositeDigitalObject<dimension, Topology_T>::Domain const &
+    CompositeDigitalObject<dimension, Topology_T>::getDomain() const
+    {
+        return m_domain;
+    }
+
+    template <int dimension, class Topology_T>
+    typename CompositeDigitalObject<dimension, Topology_T>::Pyramid const &
+    CompositeDigitalObject<dimension, Topology_T>::getPyramid() const
+    {
+        return m_pyramid.get(
+          [this]()
+          {
+              std::vector<Point> points;
+              for (auto const & component : components)
+              {
+                  points.insert(points.end(), component.getPointSet().begin(), component.getPointSet().end());
+              }
+              return std::make_shared<Pyramid const>(points, m_domain);
+          });
+    }
+
+    template <int dimension, class Topology_T>
+    template <class T>
+    inline CompositeDigitalObject<dimension, Topology_T>::Lazy<T>::Lazy(Lazy const & other)
+        : m_mutex(), m_value(), m_pointer(nullptr)
+    {
+        std::lock_guard<std::mutex> const lock(other.m_mutex);
+        m_value = other.m_value;
+        m_pointer.store(m_value.get(), std::memory_order_release);
+    }
+
+    template <int dimension, class Topology_T>
+    template <class T>
+    inline CompositeDigitalObject<dimension, Topology_T>::Lazy<T>::Lazy(Lazy && other) noexcept
+        : m_mutex(), m_value(std::move(other.m_value)), m_pointer(m_value.get())
+    {
+        other.m_pointer.store(nullptr, std::memory_order_relaxed);
+    }
+
+    template <int dimension, class Topology_T>
+    template <class T>
+    inline typename CompositeDigitalObject<dimension, Topology_T>::template Lazy<T> &
+      CompositeDigitalObject<dimension, Topology_T>::Lazy<T>::operator=(Lazy const & other)
+    {
+        if (this != &other)
+        {
+            std::lock_guard<std::mutex> const lock(other.m_mutex);
+            m_value = other.m_value;
+            m_pointer.store(m_value.get(), std::memory_order_release);
+        }
+        return *this;
+    }
+
+    template <int dimension, class Topology_T>
+    template <class T>
+    inline typename CompositeDigitalObject<dimension, Topology_T>::template Lazy<T> &
+      CompositeDigitalObject<dimension, Topology_T>::Lazy<T>::operator=(Lazy && other) noexcept
+    {
+        m_value = std::move(other.m_value);
+        m_pointer.store(m_value.get(), std::memory_order_release);
+        other.m_pointer.store(nullptr, std::memory_order_relaxed);
+        return *this;
+    }
+
+    template <int dimension, class Topology_T>
+    template <class T>
+    template <class Compute>
+    T const &
+      CompositeDigitalObject<dimension, Topology_T>::Lazy<T>::get(Compute const & compute) const
+    {
+        if (T const * const pointer = m_pointer.load(std::memory_order_acquire))
+        {
+            return *pointer;
+        }
+        // Other threads asking at the same time wait for the first one.
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        if (!m_value)
+        {
+            m_value = compute();
+            m_pointer.store(m_value.get(), std::memory_order_release);
+        }
+        return *m_value;
+    }
+
+    template <int dimension, class Topology_T>
+    template <class T>
+    inline void
+      CompositeDigitalObject<dimension, Topology_T>::Lazy<T>::reset()
+    {
+        m_pointer.store(nullptr, std::memory_order_relaxed);
+        m_value.reset();
+    }
+
+    template <int dimension, class Topology_T>
+    void
+    CompositeDigitalObject<dimension, Topology_T>::computeMedialAxes(unsigned int numberThreads) const
+    {
+        // Components are picked one at a time, large and small ones get mixed across threads.
+        parallel::forEach(components.size(),
+                          numberThreads,
+                          [this](std::size_t i) { static_cast<void>(components[i].getMedialAxis()); });
+    }
+
+    template <int dimension, class Topology_T>
+    std::vector<typename CompositeDigitalObject<dimension, Topology_T>::Calipers>
+    CompositeDigitalObject<dimension, Topology_T>::computeCalipers(unsigned int numberThreads) const
+    {
+        TD_PROFILE_SCOPE("computeCalipers");
+        std::vector<Calipers> calipers(components.size());
+        parallel::forEach(components.size(),
+                          numberThreads,
+                          [this, &calipers](std::size_t i) { calipers[i] = components[i].getCalipers(); });
+        return calipers;
+    }
+
+    template <int dimension, class Topology_T>
+    typename CompositeDigitalObject<dimension, Topology_T>::Perimeter
+    CompositeDigitalObject<dimension, Topology_T>::computeAlignmentDistance(
+        CompositeDigitalObject const & other,
+        Alignment const &              alignment,
+        std::size_t                    level) const
+    {
+        static_assert(dimension == 2, "Rotation angles are only defined in 2D.");
+        // A pixel of the level stands for the block of full resolution pixels around its centre.
+        auto const        scale  = static_cast<FloatScalar>(1 << level);
+        FloatScalar const offset = (scale - 1.) / 2.;
+        FloatScalar const c      = std::cos(alignment.angle);
+        FloatScalar const s      = std::sin(alignment.angle);
+        auto const        toLevel = [scale, offset](FloatScalar x, FloatScalar y)
+        {
+            return Point(static_cast<typename Point::Component>(std::lround((x - offset) / scale)),
+                         static_cast<typename Point::Component>(std::lround((y - offset) / scale)));
+        };
+        // other -> this
+        auto const forward = [&](Point const & point)
+        {
+            FloatScalar const dx = point[0] * scale + offset - alignment.centre[0];
+            FloatScalar const dy = point[1] * scale + offset - alignment.centre[1];
+            return toLevel(c * dx - s * dy + alignment.centre[0] + alignment.translation[0],
+                           s * dx + c * dy + alignment.centre[1] + alignment.translation[1]);
+        };
+        // this -> other
+        auto const backward = [&](Point const & point)
+        {
+            FloatScalar const dx = point[0] * scale + offset - alignment.centre[0] - alignment.translation[0];
+            FloatScalar const dy = point[1] * scale + offset - alignment.centre[1] - alignment.translation[1];
+            return toLevel(c * dx + s * dy + alignment.centre[0], -s * dx + c * dy + alignment.centre[1]);
+        };
+        // Points moved out of the domain get an upper bound of their distance.
+        auto const directed = [](auto const & points, auto const & motion, DistanceTransform const & distance)
+        {
+            Perimeter largest = 0.;
+            for (auto const & point : points)
+            {
+                largest = std::max(largest, distance(motion(point)));
+            }
+            return largest;
+        };
+
+        // Every level, the base one included, only holds the points of the components.
+        typename Pyramid::Level const & thisLevel  = getPyramid().getLevel(level);
+        typename Pyramid::Level const & otherLevel = other.getPyramid().getLevel(level);
+        Perimeter const largest = std::max(directed(otherLevel.points, forward, thisLevel.distance),
+                                           directed(thisLevel.points, backward, otherLevel.distance));
+        return largest * scale;
+    }
+
+    template <int dimension, class Topology_T>
+    typename CompositeDigitalObject<dimension, Topology_T>::Perimeter
+    CompositeDigitalObject<dimension, Topology_T>::computeHausdorffDistance(
+        CompositeDigitalObject const & other,
+        std::size_t                    level) const
+    {
+        Alignment const identity {0., RealPoint::zero, RealVector::zero, 0.};
+        return computeAlignmentDistance(other, identity, level);
+    }
+
+    template <int dimension, class Topology_T>
+    typename CompositeDigitalObject<dimension, Topology_T>::Perimeter
+    CompositeDigitalObject<dimension, Topology_T>::computeHausdorffDistance(
+        CompositeDigitalObject const & other,
+        Alignment const &              alignment,
+        std::size_t                    level) const
+    {
+        return computeAlignmentDistance(other, alignment, level);
+    }
+
+    template <int dimension, class Topology_T>
+    std::vector<typename CompositeDigitalObject<dimension, Topology_T>::Alignment>
+    CompositeDigitalObject<dimension, Topology_T>::searchAlignments(
+        CompositeDigitalObject const & other,
+        std::vector<Alignment>         candidates,
+        std::size_t                    numberSurvivors) const
+    {
+        ASSERT(numberSurvivors > 0);
+        std::size_t const numberLevels =
+          std::min(getPyramid().getNumberLevels(), other.getPyramid().getNumberLevels());
+        for (std::size_t level = numberLevels; level-- > 0 && !candidates.empty();)
+        {
+            for (auto & candidate : candidates)
+            {
+                candidate.distance = computeAlignmentDistance(other, candidate, level);
+            }
+            std::sort(candidates.begin(),
+                      candidates.end(),
+                      [](Alignment const & a1, Alignment const & a2) { return a1.distance < a2.distance; });
+            std::size_t const kept = std::min(numberSurvivors, candidates.size());
+            if (level == 0)
+            {
+                candidates.resize(kept);
+                break;
+            }
+            // A candidate is pruned if even its best case is worse than the worst case of the kept ones.
+            Perimeter const threshold = candidates[kept - 1].distance + 2. * Pyramid::getLevelError(level);
+            candidates.erase(std::upper_bound(candidates.begin(),
+                                              candidates.end(),
+                                              threshold,
+                                              [](Perimeter t, Alignment const & a) { return t < a.distance; }),
+                             candidates.end());
+        }
+        return candidates;
+    }
+
+    template <int dimension, class Topology_T>
+    typename CompositeDigitalObject<dimension, Topology_T>::Registration
+    CompositeDigitalObject<dimension, Topology_T>::computeRegistration(
+        CompositeDigitalObject const & other,
+        int                            maxIterations,
+        Perimeter                      tolerance) const
+    {
+        static_assert(dimension == 2, "Rotation angles are only defined in 2D.");
+        ASSERT(!components.empty() && !other.components.empty());
+
+        auto const toReal = [](Point const & point) { return RealPoint(point[0], point[1]); };
+        std::vector<RealPoint> target;
+        for (auto const & point : components.front().getBoundaryPoints())
+        {
+            target.push_back(toReal(point));
+        }
+        std::vector<RealPoint> source;
+        for (auto const & point : other.components.front().getBoundaryPoints())
+        {
+            source.push_back(toReal(point));
+        }
+        // Spatial index of the fixed boundary, built once for all iterations.
+        UniformGrid2D<RealPoint> const grid(target, c_registrationCellSize);
+
+        // Starting from the alignment of the centres.
+        Registration registration {};
+        registration.centre      = toReal(other.components.front().getGeometricCentre());
+        registration.translation = toReal(components.front().getGeometricCentre()) - registration.centre;
+        Matrix rotation          = Matrix::Identity();
+
+        auto const rotate = [](Matrix const & r, RealVector const & v)
+        { return RealVector(r(0, 0) * v[0] + r(0, 1) * v[1], r(1, 0) * v[0] + r(1, 1) * v[1]); };
+
+        std::size_t stride = std::max<std::size_t>(1, source.size() / c_registrationCoarsePoints);
+        while (true)
+        {
+            Perimeter previousRms = std::numeric_limits<Perimeter>::max();
+            for (int iteration = 0; iteration < maxIterations; ++iteration)
+            {
+                // Correspondences are accumulated as they are found, no point is stored.
+                CovarianceAccumulator<FloatScalar, dimension> accumulator;
+                Perimeter                                     sumSquared = 0.;
+                for (std::size_t i = 0; i < source.size(); i += stride)
+                {
+                    RealPoint const   y = rotate(rotation, source[i] - registration.centre) + registration.centre
+                                        + registration.translation;
+                    RealPoint const & x = grid.findNearest(y);
+                    accumulator.add(y, x);
+                    RealVector const d = x - y;
+                    sumSquared += d[0] * d[0] + d[1] * d[1];
+                }
+                registration.rms = std::sqrt(sumSquared / static_cast<FloatScalar>(accumulator.size()));
+                ++registration.iterations;
+                if (previousRms - registration.rms < tolerance)
+                {
+                    break;
+                }
+                previousRms = registration.rms;
+
+                // Kabsch on the centred correspondences.
+                Matrix const step =
+                  algorithms<FloatScalar>::template computeRotationKabsch<dimension>(accumulator.getCentredCovariance());
+                auto const movedMean   = accumulator.getFirstCentroid();
+                auto const matchedMean = accumulator.getSecondCentroid();
+                // x -> step (x - movedMean) + matchedMean, composed with the current transformation.
+                rotation = step * rotation;
+                registration.translation =
+                  rotate(step,
+                         registration.centre + registration.translation - RealVector(movedMean[0], movedMean[1]))
+                  + RealVector(matchedMean[0], matchedMean[1]) - registration.centre;
+            }
+            if (stride == 1)
+            {
+                break;
+            }
+            stride = std::max<std::size_t>(1, stride / c_registrationRefinement);
+        }
+        registration.angle = std::atan2(rotation(1, 0), rotation(0, 0));
+        return registration;
+    }
+
     template <int dimension, class Topology_T>
     void
       CompositeDigitalObject<dimension, Topology_T>::cullAllButLargestComponent()
@@ -232,29 +1099,57 @@ namespace td::util
           }
         );
         // keep only the max.
-        Component const maxComponent = std::move(*itMax);
+        // Moving shares the payloads of the component, nothing is copied.
+        static_assert(std::is_nothrow_move_constructible_v<Component>);
+        Component maxComponent = std::move(*itMax);
         components.clear();
-        components.push_back(maxComponent);
+        components.push_back(std::move(maxComponent));
+        // the pyramid included the other components.
+        m_pyramid.reset();
+        m_isCulled = true;
     }
 
     template <int dimension, class Topology_T>
     void
-    CompositeDigitalObject<dimension, Topology_T>::drawObjectComponents(DGtal::Board2D & board,
-                                                                        Colour const &   objectColour,
-                                                                        Colour const &   interestPointColour) const
+    CompositeDigitalObject<dimension, Topology_T>::drawObjectComponents(DrawingBuffer & drawing,
+                                                                        Colour const &  objectColour,
+                                                                        Colour const &  interestPointColour) const
     {
         for (auto const & component : components)
         {
-            component.drawObject(board, objectColour);
+            component.drawObject(drawing, objectColour);
         }
-        // Can't get this to work, too bad.
         if (m_interestPoint.has_value())
         {
-            board << DGtal::CustomStyle(m_interestPoint.value().className(), new DGtal::CustomFillColor(interestPointColour));
-            board << m_interestPoint.value();
+            drawing.beginPixels(interestPointColour);
+            drawing.addPoint(m_interestPoint.value()[0], m_interestPoint.value()[1]);
         }
     }
 
+    template <int dimension, class Topology_T>
+    std::vector<DrawingBuffer>
+    CompositeDigitalObject<dimension, Topology_T>::drawComponents(unsigned int numberThreads) const
+    {
+        std::vector<DrawingBuffer> drawings(components.size());
+        // The geometry of each component is computed on the way.
+        parallel::forEach(components.size(),
+                          numberThreads,
+                          [this, &drawings](std::size_t i)
+                          { components[i].draw(drawings[i], DrawingBuffer::getLabelColour(i)); });
+        return drawings;
+    }
+
+    template <int dimension, class Topology_T>
+    void
+    CompositeDigitalObject<dimension, Topology_T>::drawObjectComponents(DGtal::Board2D & board,
+                                                                        Colour const &   objectColour,
+                                                                        Colour const &   interestPointColour) const
+    {
+        DrawingBuffer drawing;
+        drawObjectComponents(drawing, objectColour, interestPointColour);
+        drawing.replay(board);
+    }
+
 }  // namespace td::util
 
 #endif  // TD_UTIL_DIGITALOBJECTWRAPPER_INL
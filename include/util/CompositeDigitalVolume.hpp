@@ -0,0 +1,67 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_COMPOSITEDIGITALVOLUME_HPP
+#define TD_UTIL_COMPOSITEDIGITALVOLUME_HPP
+
+#include <util/BinaryVolume.hpp>
+#include <util/DigitalComponent3D.hpp>
+
+namespace td::util
+{
+    /// A class for any 3D digital object, read from a binary volume.
+    /// \tparam Topology_T
+    template <class Topology_T>
+    class CompositeDigitalVolume
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef Topology_T                      DigitalTopology;
+        typedef DigitalComponent<3, Topology_T> Component;
+
+        typedef typename Component::Space  Space;
+        typedef typename Component::Domain Domain;
+        typedef typename Component::Point  Point;
+        typedef typename Component::Voxels Voxels;
+
+        // constraints
+        static_assert(std::is_same_v<Point, BinaryVolume::Point>);
+
+        /** --------- methods ------------- **/
+        // c-tor
+        inline explicit CompositeDigitalVolume(BinaryVolume volume);
+
+        /// Tracks the boundaries of all components, spread over threads.
+        /// \param numberThreads 0 to use all hardware threads.
+        void
+          computeGeometry(unsigned int numberThreads = 0) const;
+
+        [[nodiscard]] inline BinaryVolume const &
+          getVolume() const;
+
+        /** --------- data ------------- **/
+        std::vector<Component> components;
+
+       private:
+        /** --------- methods ------------- **/
+        /// Flood fill of the foreground of the volume, run by run along x.
+        /// Besides the voxels it returns, it takes two bits per voxel of the volume and the runs left to visit.
+        /// \return voxels of each component, over its bounding box and a margin.
+        [[nodiscard]] static std::vector<Voxels>
+          computeComponentVoxels(BinaryVolume const & volume);
+        /// Removes the components whose set of points include a border point.
+        void
+          cullBorderComponents();
+
+        /** --------- data ------------- **/
+        BinaryVolume m_volume;
+        // Topology object
+        inline static DigitalTopology const s_topology = DigitalTopology(
+          typename DigitalTopology::ForegroundAdjacency(), typename DigitalTopology::BackgroundAdjacency());
+    };
+}  // namespace td::util
+
+#include "CompositeDigitalVolume.inl"
+
+#endif  // TD_UTIL_COMPOSITEDIGITALVOLUME_HPP
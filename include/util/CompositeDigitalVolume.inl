@@ -0,0 +1,177 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_COMPOSITEDIGITALVOLUME_INL
+#define TD_UTIL_COMPOSITEDIGITALVOLUME_INL
+
+#include <util/parallel.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace td::util
+{
+    template <class Topology_T>
+    inline CompositeDigitalVolume<Topology_T>::CompositeDigitalVolume(BinaryVolume volume)
+        : components(), m_volume(std::move(volume))
+    {
+        std::vector<Voxels> componentVoxels = computeComponentVoxels(m_volume);
+        components.reserve(componentVoxels.size());
+        for (auto & voxels : componentVoxels)
+        {
+            components.emplace_back(std::move(voxels));
+        }
+        // we remove the components too close to the domain's rim.
+        cullBorderComponents();
+    }
+
+    template <class Topology_T>
+    void
+      CompositeDigitalVolume<Topology_T>::computeGeometry(unsigned int numberThreads) const
+    {
+        // Components are picked one at a time, large and small ones get mixed across threads.
+        parallel::forEach(
+          components.size(), numberThreads, [this](std::size_t i) { components[i].computeGeometry(); });
+    }
+
+    template <class Topology_T>
+    inline BinaryVolume const &
+      CompositeDigitalVolume<Topology_T>::getVolume() const
+    {
+        return m_volume;
+    }
+
+    template <class Topology_T>
+    void
+      CompositeDigitalVolume<Topology_T>::cullBorderComponents()
+    {
+        Domain const & compositeDomain = m_volume.domain();
+        components.erase(std::remove_if(components.begin(),
+                                        components.end(),
+                                        [&compositeDomain](Component const & component)
+                                        { return component.isBorderingRim(compositeDomain); }),
+                         components.end());
+    }
+
+    template <class Topology_T>
+    std::vector<typename CompositeDigitalVolume<Topology_T>::Voxels>
+      CompositeDigitalVolume<Topology_T>::computeComponentVoxels(BinaryVolume const & volume)
+    {
+        typedef typename Space::Integer Integer;
+        // Offsets of the foreground neighbours, from the adjacency of the topology.
+        std::vector<Point> offsets;
+        auto               offsetIt = std::back_inserter(offsets);
+        s_topology.kappa().writeNeighbors(offsetIt, Point::zero);
+
+        // The fill goes by runs along x, which every 3D adjacency includes.
+        // The neighbours of a run in another row lie in the run, widened by the x offsets towards that row.
+        struct RowOffset
+        {
+            Point   row;
+            Integer lower;
+            Integer upper;
+        };
+        std::vector<RowOffset> rowOffsets;
+        for (auto const & offset : offsets)
+        {
+            Point const row(0, offset[1], offset[2]);
+            if (row == Point::zero)
+            {
+                continue;
+            }
+            auto const it = std::find_if(rowOffsets.begin(),
+                                         rowOffsets.end(),
+                                         [&row](RowOffset const & rowOffset) { return rowOffset.row == row; });
+            if (it == rowOffsets.end())
+            {
+                rowOffsets.push_back({row, offset[0], offset[0]});
+            }
+            else
+            {
+                it->lower = std::min(it->lower, offset[0]);
+                it->upper = std::max(it->upper, offset[0]);
+            }
+        }
+
+        Domain const & domain = volume.domain();
+        // Voxels of the components already done, and of the one being filled, one bit each as for the volume.
+        // The voxels of a component are never listed: its bits are moved out of filling once it is done.
+        BinaryVolume visited(domain);
+        BinaryVolume filling(domain);
+        auto const   isFree = [&volume, &visited, &filling](Point const & point)
+        {
+            // out of the domain reads as background.
+            return volume(point) && !visited(point) && !filling(point);
+        };
+        // Runs left to visit, as their first voxel and last x.
+        std::vector<std::pair<Point, Integer>> runs;
+        // Fills the whole run through a free voxel and queues it, returns the last x of the run.
+        auto const fillRun = [&isFree, &filling, &runs](Point const & point)
+        {
+            Point first = point;
+            Point last  = point;
+            while (isFree(first - Point(1, 0, 0)))
+            {
+                --first[0];
+            }
+            while (isFree(last + Point(1, 0, 0)))
+            {
+                ++last[0];
+            }
+            for (Point voxel = first; voxel[0] <= last[0]; ++voxel[0])
+            {
+                filling.setValue(voxel, true);
+            }
+            runs.emplace_back(first, last[0]);
+            return last[0];
+        };
+
+        std::vector<Voxels> components;
+        for (auto const & seed : domain)
+        {
+            if (!isFree(seed))
+            {
+                continue;
+            }
+            // Flood fill, run by run, depth first.
+            fillRun(seed);
+            Point lower = seed;
+            Point upper = seed;
+            while (!runs.empty())
+            {
+                auto const [first, lastX] = runs.back();
+                runs.pop_back();
+                lower = lower.inf(first);
+                upper = upper.sup(Point(lastX, first[1], first[2]));
+                for (auto const & rowOffset : rowOffsets)
+                {
+                    Point         neighbour = first + rowOffset.row;
+                    Integer const end       = lastX + rowOffset.upper;
+                    for (neighbour[0] = first[0] + rowOffset.lower; neighbour[0] <= end; ++neighbour[0])
+                    {
+                        if (isFree(neighbour))
+                        {
+                            neighbour[0] = fillRun(neighbour);
+                        }
+                    }
+                }
+            }
+            // The domain of the component is its bounding box, with a margin for the surfels.
+            Voxels voxels(Domain(lower - Point::diagonal(), upper + Point::diagonal()));
+            for (auto const & point : Domain(lower, upper))
+            {
+                if (filling(point))
+                {
+                    voxels.setValue(point, true);
+                    filling.setValue(point, false);
+                    visited.setValue(point, true);
+                }
+            }
+            components.push_back(std::move(voxels));
+        }
+        return components;
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_COMPOSITEDIGITALVOLUME_INL
@@ -12,10 +12,23 @@
 
 #include <DGtal/images/IntervalForegroundPredicate.h>
 #include <DGtal/geometry/volumes/distance/DistanceTransformation.h>
+#include <DGtal/geometry/volumes/distance/ExactPredicateLpPowerSeparableMetric.h>
+#include <DGtal/geometry/volumes/distance/PowerMap.h>
+#include <DGtal/geometry/volumes/distance/ReducedMedialAxis.h>
 
 #include <DGtal/geometry/curves/GreedySegmentation.h>
 
+#include <array>
+#include <memory>
+#include <mutex>
+#include <optional>
 
+
+#include <util/DistanceMap.hpp>
+#include <util/DrawingBuffer.hpp>
+#include <util/FlatTopology2D.hpp>
+#include <util/Profiler.hpp>
+#include <util/ScanlineDigitizer.hpp>
 #include <util/eigen.hpp>
 
 namespace td::util
@@ -31,7 +44,7 @@ namespace td::util
         /** --------- typedefs ------------- **/
         // Topology
         typedef Topology_T                                  DigitalTopology;
-        typedef DGtal::Z2i::Integer                         Integer;
+        typedef typename DigitalTopology::Space::Integer    Integer;
         typedef DGtal::KhalimskySpaceND<dimension, Integer> KSpace;
         typedef DGtal::SpaceND<dimension, Integer>          Space;
         typedef DGtal::HyperRectDomain<Space>               Domain;
@@ -42,6 +55,7 @@ namespace td::util
         typedef typename KSpace::SCell   SCell;
         typedef typename Space::Point    Point;
         typedef typename Space::Vector   Vector;
+        typedef typename Space::RealPoint RealPoint;
         typedef DGtal::GridCurve<KSpace> Curve;
         // Digital object type
         typedef DGtal::Object<DigitalTopology, PointSet> Object;
@@ -79,27 +93,100 @@ namespace td::util
         typedef DGtal::ExactPredicateLpSeparableMetric<Space, c_metricOrder> Metric;
         typedef DGtal::functors::IntervalForegroundPredicate<Image> Binariser;
 
-        typedef DGtal::DistanceTransformation<Space, Binariser, Metric> DistanceTransform;
+        // Exact and parallel, over any subdomain.
+        typedef DistanceMap<Space> DistanceTransform;
+        typedef typename DistanceTransform::SquaredDistance SquaredDistance;
+        // Points along the rows, in the order of the buffers of the transforms.
+        typedef DigitalSpans<Space> Runs;
+
+        // Medial axis, from the power diagram of the interior balls.
+        typedef DGtal::ImageContainerBySTLVector<Domain, SquaredDistance>       WeightImage;
+        typedef DGtal::ExactPredicateLpPowerSeparableMetric<Space, c_metricOrder> PowerMetric;
+        typedef DGtal::PowerMap<WeightImage, PowerMetric>                        PowerMap;
 
         // things
         typedef DGtal::Color Colour;
 
+        /// Area of the polygons of the convex hull and the segmentation.
+        enum class PolygonArea
+        {
+            // Triangles from the edges to omega, see the report.
+            Omega,
+            // Shoelace formula over the vertices, with exact 64-bit cross products:
+            // no square root, no omega, the same result on every machine.
+            Shoelace
+        };
+
+        /// Stages of the geometry, each computed on first use, after the ones it depends on:
+        /// boundary -> convex hull -> omega, convex hull -> calipers, boundary -> segmentation.
+        enum class GeometryStage
+        {
+            Boundary,
+            ConvexHull,
+            Omega,
+            Calipers,
+            Segmentation
+        };
+
+        /// Measures of the convex hull, from rotating calipers, in grid units.
+        struct Calipers
+        {
+            // Feret diameters: smallest and largest widths of the hull over all directions.
+            Perimeter minimumWidth;
+            Perimeter maximumDiameter;
+            // Minimum-area bounding rectangle, one of its sides is along an edge of the hull.
+            Area        rectangleArea;
+            Perimeter   rectangleLength;
+            Perimeter   rectangleWidth;
+            // Direction of the side of length rectangleLength.
+            AngleRadian rectangleAngle;
+            // Counterclockwise.
+            std::array<RealPoint, 4> rectangleCorners;
+            // maximumDiameter / minimumWidth, at least 1.
+            FloatScalar aspectRatio;
+        };
+
 
         /** --------- methods ------------- **/
 
-        inline explicit DigitalComponent(Object const & object);
+        /// The object is shared by all the copies of the component, and never modified.
+        /// \param object its domain must be its window (see getWindow), so that it is never copied again.
+        /// Throws DGtal::InputException if it has no point.
+        inline explicit DigitalComponent(Object object);
+
+        /// Component of a shape too large for its points to be stored one by one, as digitised by ScanlineDigitizer.
+        /// The bounds, the count area, the moments and the boundary are computed from the runs.
+        /// The point set is only built by the methods which visit the points one by one
+        /// (getPointSet, the local window, the Fourier descriptors, the Hu moments, the closest point and the drawings).
+        /// \param runs must be a single connected component, their domain must include the window.
+        /// Throws DGtal::InputException if they have no point.
+        inline explicit DigitalComponent(Runs runs);
 
-        // copy constructor
-        inline  DigitalComponent(DigitalComponent const & component);
-        // need to explicitly define a move constructor...
-        inline DigitalComponent(DigitalComponent && component) noexcept;
+        // Copies share the object and the geometry, moves leave the source empty.
+        DigitalComponent(DigitalComponent const & component) = default;
+        DigitalComponent(DigitalComponent && component) noexcept = default;
+        DigitalComponent &
+          operator=(DigitalComponent const & other) = default;
+        DigitalComponent &
+          operator=(DigitalComponent && other) noexcept = default;
 
-        // and a copy operator...
-        inline DigitalComponent &
-          operator=(DigitalComponent const & other);
 
 
+        /// Records the pixels of the component, to be rendered later.
+        void
+        drawObject(DrawingBuffer & drawing,
+             const Colour &   objectColour     = Colour::None) const;
+
+        /// Records the pixels, the boundary, the convex hull (as triangles with omega / 2)
+        /// and the bounding boxes of the segments.
+        void
+          draw(DrawingBuffer & drawing,
+               const Colour &   objectColour     = Colour::None,
+               const Colour &   segmentColour    = Colour::Aqua,
+               const Colour &   convexHullColour = Colour::Red,
+               const Colour &   boundaryColour   = Colour::Black) const;
 
+        // Same, drawn on a board at once.
         void
         drawObject(DGtal::Board2D & board,
              const Colour &   objectColour     = Colour::None) const;
@@ -115,9 +202,13 @@ namespace td::util
         [[nodiscard]] inline Area
           getCountArea() const;
         [[nodiscard]] inline Area
-          getConvexHullArea() const;
+          getConvexHullArea(PolygonArea formula = PolygonArea::Omega) const;
+        /// Polygon of the end points of the segments.
         [[nodiscard]] inline Area
-          getSegmentationArea() const;
+          getSegmentationArea(PolygonArea formula = PolygonArea::Omega) const;
+        /// Area of the ellipse with the same second-order moments as the shape.
+        [[nodiscard]] inline Area
+          getMomentsArea() const;
 
         // Perimeter computations.
         [[nodiscard]] inline Perimeter
@@ -126,10 +217,89 @@ namespace td::util
           getConvexHullPerimeter() const;
         [[nodiscard]] inline Perimeter
           getSegmentationPerimeter() const;
+        /// Perimeter of the ellipse with the same second-order moments as the shape.
+        /// \return
+        [[nodiscard]] inline Perimeter
+          getMomentsPerimeter() const;
 
         [[nodiscard]] inline FloatScalar
           getCircularity() const;
 
+        /// Ratio of the principal axes of the equivalent ellipse (at least 1), from the cached moments.
+        [[nodiscard]] inline FloatScalar
+          getAspectRatio() const;
+
+        /// Feret diameters and minimum-area bounding rectangle of the convex hull, computed on first use.
+        [[nodiscard]] inline Calipers const &
+          getCalipers() const;
+
+        /// Bounding box of the points, computed with the component.
+        [[nodiscard]] inline Domain
+          getBoundingBox() const;
+
+        /// Cropped image of the component over its window,
+        /// with the distance from each point of the window to the background and to the component.
+        struct LocalWindow
+        {
+            inline explicit LocalWindow(Image a_mask);
+            LocalWindow(LocalWindow const &) = delete;
+            LocalWindow &
+              operator=(LocalWindow const &) = delete;
+
+            // 255 on the component, 0 elsewhere.
+            // Its domain is the bounding box grown by one pixel, so its lower bound is the offset of the window.
+            Image             mask;
+            // 0 outside of the component.
+            DistanceTransform interiorDistance;
+            // 0 on the component.
+            DistanceTransform exteriorDistance;
+        };
+
+        /// Centres and radii of the maximal balls of the component,
+        /// with the local thickness they give.
+        struct MedialAxis
+        {
+            std::vector<Point>           points;
+            std::vector<SquaredDistance> squaredRadii;
+            // Diameter of a ball minus a pixel, so that a straight band n pixels wide is n thick (n odd,
+            // an even band has no middle row of pixels and is n - 1 thick).
+            Perimeter maximumThickness;
+            Perimeter meanThickness;
+        };
+
+        /// The domain of the object of a component is its window:
+        /// the bounding box grown by one pixel of background.
+        [[nodiscard]] inline Domain
+          getWindow() const;
+
+        /// Local window, built on first use by the first thread which needs it.
+        /// Its cost depends on the size of the component, not of the composite image.
+        [[nodiscard]] LocalWindow const &
+          getLocalWindow() const;
+
+        /// Signed distance to the boundary, negative on the component.
+        /// Exact on the window, bounded from above outside of it.
+        /// \param point
+        /// \return
+        [[nodiscard]] inline Perimeter
+          getSignedDistance(Point const & point) const;
+
+        /// Reduced discrete medial axis, built on first use from the local window, by the first thread which needs it.
+        /// See Coeurjolly and Montanvert, "Optimal separable algorithms to compute the reverse
+        /// Euclidean distance transformation and discrete medial axis in arbitrary dimension", 2007.
+        [[nodiscard]] MedialAxis const &
+          getMedialAxis() const;
+
+        // Shape descriptors, invariant by rotation and translation.
+        /// Magnitudes of the Fourier coefficients 1 to count of the distance from the centroid to the boundary,
+        /// the boundary being resampled uniformly by arc length.
+        /// Divided by the mean distance, so they are invariant by scaling as well.
+        [[nodiscard]] std::vector<FloatScalar>
+          computeFourierDescriptors(std::size_t count) const;
+        /// The seven moment invariants of Hu.
+        [[nodiscard]] std::array<FloatScalar, 7>
+          computeHuMoments() const;
+
         [[nodiscard]] inline Point
           getPositionFromCentre(Point const & point) const;
 
@@ -142,12 +312,33 @@ namespace td::util
         [[nodiscard]] inline Point
           getGeometricCentre() const;
 
+        /// Pointels of the tracked boundary, in tracking order.
+        [[nodiscard]] inline std::vector<Point>
+          getBoundaryPoints() const;
+
+        /// Built on first use for a component built from runs.
+        [[nodiscard]] inline PointSet const &
+          getPointSet() const;
+
+        /// Points of the component as runs along the rows, in raster order, built on first use.
+        [[nodiscard]] inline Runs const &
+          getRuns() const;
+
+        /// Largest and average distances from the points of the component to another object.
+        /// Points outside of the domain of the transform get the upper bound of DistanceTransform::operator().
         [[nodiscard]] Perimeter computeLargestDistance(DistanceTransform const & otherBackgroundDistance) const;
         [[nodiscard]] Perimeter computeAverageDistance(DistanceTransform const & otherBackgroundDistance) const;
 
         [[nodiscard]] inline bool
           isBorderingRim(Domain const & compositeDomain) const;
 
+        /// Drops a stage of the geometry and the stages depending on it, to be computed again on next use.
+        /// Copies of the component keep theirs.
+        /// Unlike the queries, it must not run while another thread uses this component.
+        /// \param stage
+        inline void
+          invalidateGeometry(GeometryStage stage = GeometryStage::Boundary);
+
         [[nodiscard]] inline static AngleRadian computeRotationAngle(
           std::vector<Point> const & points1,
           std::vector<Point> const & points2);
@@ -155,38 +346,136 @@ namespace td::util
        private:
 
         /** --------- methods ------------- **/
+        /// \param object
+        /// \return any point of the object, which must not be empty.
+        [[nodiscard]] inline static Point
+          getFirstPoint(Object const & object);
         [[nodiscard]] inline static Curve
           computeBoundary(Object const & objectComponent);
+        /// Tracked from the lower crack of the first point of the lowest run,
+        /// reading only the runs along the boundary.
+        [[nodiscard]] inline static Curve
+          computeBoundary(Runs const & runs);
+        [[nodiscard]] inline static std::vector<Point>
+          trackBoundaryPoints(Object const & objectComponent);
+        [[nodiscard]] inline static std::vector<Point>
+          trackBoundaryPointsFlat(Object const & objectComponent);
         [[nodiscard]] inline static ConvexHull
           computeConvexHull(Curve const & boundary);
         [[nodiscard]] inline static Point
           computeOmega(ConvexHull const & convexHull);
-
-        /// Computes Boundary, Convex Hull and Segmentation.
-        inline void
-        computeGeometry() const;
+        /// Rotating calipers around the hull: one sweep of its edges,
+        /// each with its farthest vertex and its extreme projections, see Toussaint,
+        /// "Solving geometric problems with the rotating calipers", 1983.
+        [[nodiscard]] inline static Calipers
+          computeCalipers(ConvexHull const & convexHull);
+        /// Area of a closed polygon, the last vertex being joined to the first one.
+        /// Twice the area is an exact integer, halved only at the end.
+        [[nodiscard]] inline static Area
+          computeShoelaceArea(std::vector<Point> const & vertices);
+
+        // Stages of the geometry, computed on first use.
+        [[nodiscard]] inline Curve const &
+          getBoundary() const;
+        [[nodiscard]] inline ConvexHull const &
+          getConvexHull() const;
+        [[nodiscard]] inline Point const &
+          getOmega() const;
+        [[nodiscard]] inline Segmentation const &
+          getSegmentation() const;
 
         [[nodiscard]] Perimeter computeClosestPointDistance(Point  const & from) const;
 
-        inline void computeGeometryIfNotSet() const;
+        /// Visits the distances of the points of the component, in raster order (see getRuns).
+        /// \param distance
+        /// \param onRun called with the squared distances of each run of points in the domain of the transform,
+        ///        contiguous in memory, and their number.
+        /// \param onOutside called with the distance of each point outside of the domain.
+        template <class RunFunction, class PointFunction>
+        void
+          visitDistances(DistanceTransform const & distance,
+                         RunFunction const &       onRun,
+                         PointFunction const &     onOutside) const;
 
-        /** --------- data ------------- **/
-        Object m_object;
-        // Computed from the digital object.
-        Curve  mutable       m_boundary;
-        ConvexHull mutable   m_convexHull;
-        Segmentation mutable m_segmentation;
+        /// Covariance matrix of the points of the object (central moments of order 2).
+        [[nodiscard]] inline Matrix
+          computeSecondOrderMoments() const;
+        /// Same, summed in closed form along each run.
+        [[nodiscard]] inline static Matrix
+          computeSecondOrderMoments(Runs const & runs);
 
-        // we store twice I (omega) for the computations.
-        // see report for details.
-        Point mutable m_omega;
+        /// Object given to the constructor, or built from the runs on first use.
+        [[nodiscard]] inline Object const &
+          getObject() const;
 
-        // Computing geometry only if needed.
-        bool mutable m_isSet;
+        [[nodiscard]] static MedialAxis
+          computeMedialAxis(LocalWindow const & window);
+
+        /** --------- data ------------- **/
+        /// Value computed from the digital object by the first thread which needs it.
+        template <class T>
+        struct Stage
+        {
+            Stage() = default;
+            Stage(Stage const &) = delete;
+            Stage &
+              operator=(Stage const &) = delete;
+
+            /// \param compute () -> std::shared_ptr<T const>, called once.
+            template <class Compute>
+            T const &
+              get(Compute const & compute);
+            /// Takes the value of the other stage, if it was computed.
+            /// \param other
+            inline void
+              keep(Stage const & other);
+
+            std::once_flag flag;
+            // Kept on the heap: the segmentation holds iterators on the boundary, which must not move.
+            std::shared_ptr<T const> value;
+        };
+
+        /// Lazy values of a component, in one block: nothing is computed or allocated until used.
+        struct Geometry
+        {
+            Stage<Curve>      boundary;
+            Stage<ConvexHull> convexHull;
+            // we store twice I (omega) for the computations.
+            // see report for details.
+            Stage<Point>        omega;
+            Stage<Calipers>     calipers;
+            Stage<Segmentation> segmentation;
+            // Not stages of the geometry, the points never change.
+            // Only for a component built from runs, see m_object.
+            Stage<Object>      object;
+            Stage<Runs>        runs;
+            Stage<LocalWindow> localWindow;
+            Stage<MedialAxis>  medialAxis;
+        };
+
+        // Null for a component built from runs.
+        std::shared_ptr<Object const> m_object;
+        // Shared by the copies, replaced by invalidateGeometry.
+        std::shared_ptr<Geometry> m_geometry;
+        // Computed with the component, for cheap filtering.
+        Point  m_lower;
+        Point  m_upper;
+        Matrix m_secondOrderMoments;
+
+        // Number of samples of the boundary for the Fourier descriptors.
+        static constexpr std::size_t c_numberFourierSamples = 64;
+        // Distances summed at once by computeAverageDistance, on the stack.
+        static constexpr std::size_t c_distanceChunkSize = 256;
 
         // Adjacency object.
         // Interior to exterior only for adjacency pairs.
         inline static Adjacency const s_adjacency = {true};
+        // Topology of the objects built from runs.
+        inline static DigitalTopology const s_topology = DigitalTopology(
+          typename DigitalTopology::ForegroundAdjacency(), typename DigitalTopology::BackgroundAdjacency());
+
+        // Flat 2D implementation of tracking, if available for the topology.
+        typedef FlatTopologyTraits<dimension, DigitalTopology> FlatTraits;
 
     };
 
@@ -5,76 +5,456 @@
 #ifndef TD_UTIL_DIGITALCOMPONENT_INL
 #define TD_UTIL_DIGITALCOMPONENT_INL
 
-// cloning mechanism (deep copy)
-#include <DGtal/base/Clone.h>
-
 #include <util/common.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace td::util
 {
     template <int dimension, class Topology_T>
-    inline DigitalComponent<dimension, Topology_T>::DigitalComponent(const DigitalComponent::Object & a_object)
-        : m_object(a_object), m_isSet(false)
+    inline DigitalComponent<dimension, Topology_T>::DigitalComponent(Object a_object)
+        : m_object(std::make_shared<Object const>(std::move(a_object))),
+          m_geometry(std::make_shared<Geometry>()),
+          m_lower(getFirstPoint(*m_object)),
+          m_upper(m_lower),
+          m_secondOrderMoments()
+    {
+        for (auto const & point : m_object->pointSet())
+        {
+            m_lower = m_lower.inf(point);
+            m_upper = m_upper.sup(point);
+        }
+        // The Khalimsky space of the tracking is built over the domain of the object.
+        ASSERT(m_object->domain().lowerBound() == getWindow().lowerBound()
+               && m_object->domain().upperBound() == getWindow().upperBound());
+        m_secondOrderMoments = computeSecondOrderMoments();
+    }
+
+    template <int dimension, class Topology_T>
+    inline DigitalComponent<dimension, Topology_T>::DigitalComponent(Runs a_runs)
+        : m_object(),
+          m_geometry(std::make_shared<Geometry>()),
+          m_lower(),
+          m_upper(),
+          m_secondOrderMoments()
+    {
+        static_assert(dimension == 2, "Runs are only defined in 2D.");
+        if (a_runs.size() == 0)
+        {
+            DGtal::trace.error() << "DigitalComponent: can't build a component of empty runs" << std::endl;
+            throw DGtal::InputException();
+        }
+        Domain const box = a_runs.getBoundingBox();
+        m_lower          = box.lowerBound();
+        m_upper          = box.upperBound();
+        // The tracking reads the background around the component.
+        ASSERT(a_runs.domain().isInside(getWindow().lowerBound()) && a_runs.domain().isInside(getWindow().upperBound()));
+        m_secondOrderMoments = computeSecondOrderMoments(a_runs);
+        auto runs            = std::make_shared<Runs const>(std::move(a_runs));
+        m_geometry->runs.get([&runs]() { return runs; });
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Point
+      DigitalComponent<dimension, Topology_T>::getFirstPoint(Object const & object)
+    {
+        if (object.pointSet().empty())
+        {
+            DGtal::trace.error() << "DigitalComponent: can't build a component of an empty object" << std::endl;
+            throw DGtal::InputException();
+        }
+        return *object.pointSet().begin();
+    }
+
+    template <int dimension, class Topology_T>
+    inline DigitalComponent<dimension, Topology_T>::LocalWindow::LocalWindow(Image a_mask)
+        : mask(std::move(a_mask)),
+          // Windows are small, and may be built for many components at once: one thread each.
+          interiorDistance(mask.domain(), [this](Point const & point) { return mask(point) == 0; }, 1),
+          exteriorDistance(mask.domain(), [this](Point const & point) { return mask(point) != 0; }, 1)
     {}
 
     template <int dimension, class Topology_T>
-    inline DigitalComponent<dimension, Topology_T>::DigitalComponent(DigitalComponent const & component)
-      : m_object(DGtal::Clone(component.m_object)),
-          m_boundary(DGtal::Clone(component.m_boundary)),
-          m_segmentation(),
-        m_omega(DGtal::Clone(component.m_omega)),
-        m_isSet(component.m_isSet)
+    inline typename DigitalComponent<dimension, Topology_T>::Domain
+    DigitalComponent<dimension, Topology_T>::getWindow() const
     {
-        m_segmentation.setSubRange(m_boundary.getPointsRange().begin(), m_boundary.getPointsRange().end());
+        return Domain(m_lower - Point::diagonal(), m_upper + Point::diagonal());
     }
 
+    template <int dimension, class Topology_T>
+    typename DigitalComponent<dimension, Topology_T>::LocalWindow const &
+    DigitalComponent<dimension, Topology_T>::getLocalWindow() const
+    {
+        return m_geometry->localWindow.get(
+          [this]()
+          {
+              Image mask(getWindow());
+              for (auto const & point : getPointSet())
+              {
+                  mask.setValue(point, 255);
+              }
+              return std::make_shared<LocalWindow const>(std::move(mask));
+          });
+    }
 
     template <int dimension, class Topology_T>
-    inline DigitalComponent<dimension, Topology_T>::DigitalComponent(DigitalComponent && component) noexcept
-      : m_object(std::move(component.m_object)),
-          m_boundary(std::move(component.m_boundary)),
-          m_segmentation(),
-          m_omega(std::move(component.m_omega)),
-          m_isSet(component.m_isSet)
+    inline typename DigitalComponent<dimension, Topology_T>::Perimeter
+    DigitalComponent<dimension, Topology_T>::getSignedDistance(Point const & point) const
     {
-        m_segmentation.setSubRange(m_boundary.getPointsRange().begin(), m_boundary.getPointsRange().end());
+        LocalWindow const & window = getLocalWindow();
+        // One of the two is 0.
+        return window.exteriorDistance(point) - window.interiorDistance(point);
     }
 
     template <int dimension, class Topology_T>
-    inline DigitalComponent<dimension, Topology_T> &
-    DigitalComponent<dimension, Topology_T>::operator=(const DigitalComponent & other)
+    typename DigitalComponent<dimension, Topology_T>::MedialAxis const &
+    DigitalComponent<dimension, Topology_T>::getMedialAxis() const
     {
-        m_object   = other.m_object;
-        m_boundary = other.m_boundary;
-        m_convexHull = other.m_convexHull;
-        m_segmentation.setSubRange(m_boundary.getPointsRange().begin(), m_boundary.getPointsRange().end());
-        m_omega = other.m_omega;
-        m_isSet = other.m_isSet;
-        return *this;
+        LocalWindow const & window = getLocalWindow();
+        return m_geometry->medialAxis.get(
+          [&window]() { return std::make_shared<MedialAxis const>(computeMedialAxis(window)); });
     }
 
+    template <int dimension, class Topology_T>
+    typename DigitalComponent<dimension, Topology_T>::MedialAxis
+    DigitalComponent<dimension, Topology_T>::computeMedialAxis(LocalWindow const & window)
+    {
+        static_assert(dimension == 2, "Thickness is only defined in 2D.");
+        Domain const & domain = window.mask.domain();
+        // Balls of the component, points of the background have no weight and are not sites.
+        WeightImage weights(domain);
+        for (auto const & point : domain)
+        {
+            if (window.mask(point) != 0)
+            {
+                weights.setValue(point, window.interiorDistance.getSquaredDistance(point));
+            }
+        }
+        PowerMetric const power;
+        PowerMap const    powerMap(&domain, &weights, &power);
+        auto const        reduced = DGtal::ReducedMedialAxis<PowerMap>::getReducedMedialAxisFromPowerMap(powerMap);
+
+        MedialAxis axis {{}, {}, 0., 0.};
+        for (auto const & point : domain)
+        {
+            SquaredDistance const squaredRadius = reduced(point);
+            if (squaredRadius != 0)
+            {
+                Perimeter const thickness = 2. * std::sqrt(static_cast<Perimeter>(squaredRadius)) - 1.;
+                axis.points.push_back(point);
+                axis.squaredRadii.push_back(squaredRadius);
+                axis.maximumThickness = std::max(axis.maximumThickness, thickness);
+                axis.meanThickness += thickness;
+            }
+        }
+        if (!axis.points.empty())
+        {
+            axis.meanThickness /= static_cast<Perimeter>(axis.points.size());
+        }
+        return axis;
+    }
 
     template <int dimension, class Topology_T>
+    template <class T>
+    template <class Compute>
+    T const &
+      DigitalComponent<dimension, Topology_T>::Stage<T>::get(Compute const & compute)
+    {
+        // Other threads asking at the same time wait for the first one.
+        std::call_once(flag, [this, &compute]() { value = compute(); });
+        return *value;
+    }
+
+    template <int dimension, class Topology_T>
+    template <class T>
     inline void
-    DigitalComponent<dimension, Topology_T>::computeGeometry() const
+      DigitalComponent<dimension, Topology_T>::Stage<T>::keep(Stage const & other)
+    {
+        if (other.value)
+        {
+            std::call_once(flag, [this, &other]() { value = other.value; });
+        }
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Curve const &
+      DigitalComponent<dimension, Topology_T>::getBoundary() const
+    {
+        return m_geometry->boundary.get(
+          [this]()
+          { return std::make_shared<Curve const>(m_object ? computeBoundary(*m_object) : computeBoundary(getRuns())); });
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::ConvexHull const &
+      DigitalComponent<dimension, Topology_T>::getConvexHull() const
+    {
+        Curve const & boundary = getBoundary();
+        return m_geometry->convexHull.get(
+          [&boundary]() { return std::make_shared<ConvexHull const>(computeConvexHull(boundary)); });
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Point const &
+      DigitalComponent<dimension, Topology_T>::getOmega() const
+    {
+        ConvexHull const & convexHull = getConvexHull();
+        return m_geometry->omega.get([&convexHull]() { return std::make_shared<Point const>(computeOmega(convexHull)); });
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Segmentation const &
+      DigitalComponent<dimension, Topology_T>::getSegmentation() const
+    {
+        Curve const & boundary = getBoundary();
+        return m_geometry->segmentation.get(
+          [&boundary]()
+          {
+              TD_PROFILE_SCOPE("segmentation");
+              auto segmentation = std::make_shared<Segmentation>();
+              segmentation->setSubRange(boundary.getPointsRange().begin(), boundary.getPointsRange().end());
+              return std::shared_ptr<Segmentation const>(std::move(segmentation));
+          });
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Calipers const &
+      DigitalComponent<dimension, Topology_T>::getCalipers() const
+    {
+        ConvexHull const & convexHull = getConvexHull();
+        return m_geometry->calipers.get(
+          [&convexHull]() { return std::make_shared<Calipers const>(computeCalipers(convexHull)); });
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Calipers
+      DigitalComponent<dimension, Topology_T>::computeCalipers(ConvexHull const & convexHull)
+    {
+        static_assert(dimension == 2, "Calipers are 2D.");
+        TD_PROFILE_SCOPE("calipers");
+        // Strictly convex polygon: collinear and repeated vertices would make flat steps
+        // on which the calipers stop too early.
+        auto const cross = [](Point const & o, Point const & a, Point const & b)
+        {
+            return static_cast<std::int64_t>(a[0] - o[0]) * static_cast<std::int64_t>(b[1] - o[1])
+                   - static_cast<std::int64_t>(a[1] - o[1]) * static_cast<std::int64_t>(b[0] - o[0]);
+        };
+        auto const squaredDistance = [](Point const & a, Point const & b)
+        {
+            auto const dx = static_cast<std::int64_t>(a[0] - b[0]);
+            auto const dy = static_cast<std::int64_t>(a[1] - b[1]);
+            return dx * dx + dy * dy;
+        };
+        std::vector<Point> v;
+        for (auto const & point : convexHull)
+        {
+            while (v.size() >= 2 && cross(v[v.size() - 2], v.back(), point) == 0)
+            {
+                v.pop_back();
+            }
+            if (v.empty() || v.back() != point)
+            {
+                v.push_back(point);
+            }
+        }
+        while (v.size() >= 3 && cross(v[v.size() - 2], v.back(), v.front()) == 0)
+        {
+            v.pop_back();
+        }
+        while (v.size() >= 3 && cross(v.back(), v.front(), v[1]) == 0)
+        {
+            v.erase(v.begin());
+        }
+        ASSERT(!v.empty());
+        Calipers calipers {0., 0., 0., 0., 0., 0., {}, 1.};
+        std::size_t const n = v.size();
+        if (n < 3)
+        {
+            // Flat hull.
+            if (n == 2)
+            {
+                calipers.maximumDiameter = calipers.rectangleLength = (v[1] - v[0]).norm();
+                calipers.rectangleAngle = std::atan2(static_cast<AngleRadian>(v[1][1] - v[0][1]),
+                                                     static_cast<AngleRadian>(v[1][0] - v[0][0]));
+            }
+            for (std::size_t k = 0; k < 4; ++k)
+            {
+                Point const & corner = v[k < 2 ? 0 : n - 1];
+                calipers.rectangleCorners[k] = RealPoint(corner[0], corner[1]);
+            }
+            return calipers;
+        }
+        // Counterclockwise, the interior on the left of the edges.
+        if (cross(v[0], v[1], v[2]) < 0)
+        {
+            std::reverse(v.begin(), v.end());
+        }
+
+        auto const next = [n](std::size_t k) { return k + 1 == n ? 0 : k + 1; };
+        calipers.minimumWidth  = std::numeric_limits<Perimeter>::max();
+        calipers.rectangleArea = std::numeric_limits<Area>::max();
+        std::int64_t maximumSquaredDiameter = 0;
+        // Farthest vertex from the edge, largest and smallest projections on it.
+        // Each only moves forward, once around the polygon in total.
+        std::size_t far   = 1;
+        std::size_t right = 1;
+        std::size_t left  = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            Point const & p = v[i];
+            Point const & q = v[next(i)];
+            auto const    dot = [&p, &q](Point const & a)
+            {
+                return static_cast<std::int64_t>(q[0] - p[0]) * static_cast<std::int64_t>(a[0] - p[0])
+                       + static_cast<std::int64_t>(q[1] - p[1]) * static_cast<std::int64_t>(a[1] - p[1]);
+            };
+            while (cross(p, q, v[next(far)]) > cross(p, q, v[far]))
+            {
+                far = next(far);
+            }
+            while (dot(v[next(right)]) > dot(v[right]))
+            {
+                right = next(right);
+            }
+            if (i == 0)
+            {
+                left = far;
+            }
+            while (dot(v[next(left)]) < dot(v[left]))
+            {
+                left = next(left);
+            }
+            // Antipodal pairs, the next vertex covers an edge parallel to this one.
+            for (std::size_t k : {far, next(far)})
+            {
+                maximumSquaredDiameter =
+                  std::max({maximumSquaredDiameter, squaredDistance(v[k], p), squaredDistance(v[k], q)});
+            }
+
+            FloatScalar const edgeLength = (q - p).norm();
+            Perimeter const   width      = static_cast<FloatScalar>(cross(p, q, v[far])) / edgeLength;
+            FloatScalar const lower      = static_cast<FloatScalar>(dot(v[left])) / edgeLength;
+            FloatScalar const upper      = static_cast<FloatScalar>(dot(v[right])) / edgeLength;
+            calipers.minimumWidth        = std::min(calipers.minimumWidth, width);
+            if (width * (upper - lower) < calipers.rectangleArea)
+            {
+                calipers.rectangleArea   = width * (upper - lower);
+                calipers.rectangleLength = upper - lower;
+                calipers.rectangleWidth  = width;
+                FloatScalar const ux     = (q[0] - p[0]) / edgeLength;
+                FloatScalar const uy     = (q[1] - p[1]) / edgeLength;
+                calipers.rectangleAngle  = std::atan2(uy, ux);
+                // Along the edge, then towards the interior.
+                auto const corner = [&p, ux, uy](FloatScalar s, FloatScalar t)
+                { return RealPoint(p[0] + s * ux - t * uy, p[1] + s * uy + t * ux); };
+                calipers.rectangleCorners = {corner(lower, 0.), corner(upper, 0.), corner(upper, width), corner(lower, width)};
+            }
+        }
+        calipers.maximumDiameter = std::sqrt(static_cast<Perimeter>(maximumSquaredDiameter));
+        calipers.aspectRatio     = calipers.maximumDiameter / calipers.minimumWidth;
+        return calipers;
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Area
+      DigitalComponent<dimension, Topology_T>::computeShoelaceArea(std::vector<Point> const & vertices)
     {
-        m_boundary = computeBoundary(m_object);
-        m_convexHull = computeConvexHull(m_boundary);
-        m_segmentation.setSubRange(m_boundary.getPointsRange().begin(), m_boundary.getPointsRange().end());
-        m_omega = computeOmega(m_convexHull);
+        static_assert(dimension == 2, "Polygons are 2D.");
+        if (vertices.size() < 3)
+        {
+            return static_cast<Area>(0.);
+        }
+        // Relative to the first vertex, the cross products stay small.
+        // Independent products over contiguous vertices, the loop vectorises.
+        Point const        origin = vertices.front();
+        std::int64_t       twiceArea = 0;
+        std::size_t const  n = vertices.size();
+        for (std::size_t i = 1; i + 1 < n; ++i)
+        {
+            auto const x0 = static_cast<std::int64_t>(vertices[i][0] - origin[0]);
+            auto const y0 = static_cast<std::int64_t>(vertices[i][1] - origin[1]);
+            auto const x1 = static_cast<std::int64_t>(vertices[i + 1][0] - origin[0]);
+            auto const y1 = static_cast<std::int64_t>(vertices[i + 1][1] - origin[1]);
+            twiceArea += x0 * y1 - x1 * y0;
+        }
+        // Either orientation.
+        return static_cast<Area>(twiceArea < 0 ? -twiceArea : twiceArea) / static_cast<Area>(2.);
+    }
 
-        // The object is now set!
-        m_isSet = true;
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Runs const &
+      DigitalComponent<dimension, Topology_T>::getRuns() const
+    {
+        // Set by the constructor for a component built from runs.
+        return m_geometry->runs.get(
+          [this]()
+          {
+              ASSERT(m_object);
+              return std::make_shared<Runs const>(Runs::fromPoints(
+                getWindow(), std::vector<Point>(m_object->pointSet().begin(), m_object->pointSet().end())));
+          });
     }
 
     template <int dimension, class Topology_T>
     inline void
-      DigitalComponent<dimension, Topology_T>::computeGeometryIfNotSet() const
+      DigitalComponent<dimension, Topology_T>::invalidateGeometry(GeometryStage stage)
     {
-        if (!m_isSet)
+        // Stages dropped, in the order of the dependencies.
+        bool isBoundaryDropped     = false;
+        bool isConvexHullDropped   = false;
+        bool isOmegaDropped        = false;
+        bool isCalipersDropped     = false;
+        bool isSegmentationDropped = false;
+        switch (stage)
+        {
+            case GeometryStage::Boundary:
+                isBoundaryDropped     = true;
+                isSegmentationDropped = true;
+                [[fallthrough]];
+            case GeometryStage::ConvexHull:
+                isConvexHullDropped = true;
+                isCalipersDropped   = true;
+                [[fallthrough]];
+            case GeometryStage::Omega:
+                isOmegaDropped = true;
+                break;
+            case GeometryStage::Calipers:
+                isCalipersDropped = true;
+                break;
+            case GeometryStage::Segmentation:
+                isSegmentationDropped = true;
+                break;
+        }
+        // A fresh block, so that the copies keep the previous one. The values kept are shared, not copied.
+        Geometry const & previous = *m_geometry;
+        auto             geometry = std::make_shared<Geometry>();
+        if (!isBoundaryDropped)
+        {
+            geometry->boundary.keep(previous.boundary);
+        }
+        if (!isConvexHullDropped)
         {
-           computeGeometry();
+            geometry->convexHull.keep(previous.convexHull);
         }
+        if (!isOmegaDropped)
+        {
+            geometry->omega.keep(previous.omega);
+        }
+        if (!isCalipersDropped)
+        {
+            geometry->calipers.keep(previous.calipers);
+        }
+        if (!isSegmentationDropped)
+        {
+            geometry->segmentation.keep(previous.segmentation);
+        }
+        geometry->object.keep(previous.object);
+        geometry->runs.keep(previous.runs);
+        geometry->localWindow.keep(previous.localWindow);
+        geometry->medialAxis.keep(previous.medialAxis);
+        m_geometry = std::move(geometry);
     }
 
     template <int dimension, class Topology_T>
@@ -98,6 +478,62 @@ namespace td::util
     template <int dimension, class Topology_T>
     inline typename DigitalComponent<dimension, Topology_T>::Curve
     DigitalComponent<dimension, Topology_T>::computeBoundary(Object const & objectComponent)
+    {
+        TD_PROFILE_SCOPE("computeBoundary");
+        std::vector<Point> boundaryPoints;
+        if constexpr (FlatTraits::c_isSpecialised)
+        {
+            boundaryPoints = trackBoundaryPointsFlat(objectComponent);
+        }
+        else
+        {
+            boundaryPoints = trackBoundaryPoints(objectComponent);
+        }
+        Curve boundaryCurve;
+        // 3) Create a curve from a vector
+        boundaryCurve.initFromPointsVector(boundaryPoints);
+        return boundaryCurve;
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Curve
+      DigitalComponent<dimension, Topology_T>::computeBoundary(Runs const & runs)
+    {
+        TD_PROFILE_SCOPE("computeBoundary");
+        // The lowest, leftmost point: the point below it is outside.
+        Domain const box = runs.getBoundingBox();
+        Point const  start(runs.getRow(box.lowerBound()[1]).first->begin, box.lowerBound()[1]);
+        std::vector<Point> boundaryPoints;
+        if constexpr (FlatTraits::c_isSpecialised)
+        {
+            auto const isInside = [&runs](FlatPoint2D const & point)
+            { return runs(Point(static_cast<Integer>(point.x), static_cast<Integer>(point.y))); };
+            std::vector<FlatPoint2D> const pointels = FlatTopology2D<FlatTraits::c_foregroundAdjacency>::trackBoundary(
+              isInside, FlatPoint2D {static_cast<std::int32_t>(start[0]), static_cast<std::int32_t>(start[1])});
+            boundaryPoints.reserve(pointels.size());
+            for (auto const & pointel : pointels)
+            {
+                boundaryPoints.emplace_back(static_cast<Integer>(pointel.x), static_cast<Integer>(pointel.y));
+            }
+        }
+        else
+        {
+            // No stochastic search either: the bel is between the start and the point below it.
+            KSpace kSpace;
+            kSpace.init(runs.domain().lowerBound(), runs.domain().upperBound(), true);
+            SCell const boundaryCell =
+              DGtal::Surfaces<KSpace>::findABel(kSpace, runs, start, start - Point(0, 1));
+            DGtal::template Surfaces<KSpace>::track2DBoundaryPoints(
+              boundaryPoints, kSpace, s_adjacency, runs, boundaryCell);
+        }
+        Curve boundaryCurve;
+        boundaryCurve.initFromPointsVector(boundaryPoints);
+        return boundaryCurve;
+    }
+
+    template <int dimension, class Topology_T>
+    inline std::vector<typename DigitalComponent<dimension, Topology_T>::Point>
+    DigitalComponent<dimension, Topology_T>::trackBoundaryPoints(Object const & objectComponent)
     {
         // IMPORTANT:
         // objectComponent() returns a value,
@@ -112,6 +548,7 @@ namespace td::util
         // nope.
         // Point::diagonal is more general than subtracting Point(1, 1)
         // it works in any dimension.
+        // The domain of the object is the window of the component, so the space only covers the component.
         kSpace.init(objectComponent.domain().lowerBound(), objectComponent.domain().upperBound(), true);
 
         // 1) Call Surfaces::findABel() to find a cell which belongs to the border
@@ -130,7 +567,14 @@ namespace td::util
         int constexpr s_numberTries = 10000000;
         // On second thought, using random.
         // find the boundary cell.
+#ifdef TD_UTIL_PROFILING
+        // Each try evaluates the predicate, the count tells how long the search took.
+        Profiler::CountingPredicate<PointSet> const countingPointSet(objectComponent.pointSet());
+        SCell boundaryCell = DGtal::Surfaces<KSpace>::findABel(kSpace, countingPointSet, s_numberTries);
+        TD_PROFILE_COUNT("findABel evaluations", countingPointSet.getCount());
+#else
         SCell boundaryCell = DGtal::Surfaces<KSpace>::findABel(kSpace, objectComponent.pointSet(), s_numberTries);
+#endif
 
         // 2) Call Surfaces::track2DBoundaryPoints to extract the boundary of the object
         DGtal::template Surfaces<KSpace>::track2DBoundaryPoints(boundaryPoints,
@@ -139,16 +583,33 @@ namespace td::util
           // DigitalSets are models of PointPredicate, no worries.
                                                                 objectComponent.pointSet(),
                                                                 boundaryCell);
-        Curve boundaryCurve;
-        // 3) Create a curve from a vector
-        boundaryCurve.initFromPointsVector(boundaryPoints);
-        return boundaryCurve;
+        return boundaryPoints;
+    }
+
+    template <int dimension, class Topology_T>
+    inline std::vector<typename DigitalComponent<dimension, Topology_T>::Point>
+    DigitalComponent<dimension, Topology_T>::trackBoundaryPointsFlat(Object const & objectComponent)
+    {
+        // No stochastic search here:
+        // the raster of the bounding box gives a boundary cell right away.
+        FlatMask2D const mask(objectComponent.pointSet());
+        std::vector<FlatPoint2D> const pointels =
+          FlatTopology2D<FlatTraits::c_foregroundAdjacency>::trackBoundary(mask);
+
+        std::vector<Point> boundaryPoints;
+        boundaryPoints.reserve(pointels.size());
+        for (auto const & pointel : pointels)
+        {
+            boundaryPoints.emplace_back(static_cast<Integer>(pointel.x), static_cast<Integer>(pointel.y));
+        }
+        return boundaryPoints;
     }
 
     template <int dimension, class Topology_T>
     typename DigitalComponent<dimension, Topology_T>::ConvexHull
       DigitalComponent<dimension, Topology_T>::computeConvexHull(DigitalComponent::Curve const & boundary)
     {
+        TD_PROFILE_SCOPE("computeConvexHull");
         OrientationFunctor f;
         ConvexHull         convexHull{f};
         for (auto const & p : boundary.getPointsRange())
@@ -163,42 +624,56 @@ namespace td::util
     inline bool
     DigitalComponent<dimension, Topology_T>::isBorderingRim(Domain const & compositeDomain) const
     {
-        // compute domain without the borders.
+        // bounds of the domain without the borders, compared directly as they may cross for thin domains.
         // Point::diagonal is more general than subtracting Point(1, 1)
-        Domain borderless  = Domain(compositeDomain.lowerBound() + Point::diagonal(),
-                                    compositeDomain.upperBound() - Point::diagonal());
-        bool   isBordering = false;
-        for (auto const & point : m_object.pointSet())
-        {
-            // if the point is part of the domain's border, discard the whole component.
-            if (!borderless.isInside(point))
-            {
-                isBordering = true;
-                break;
-            }
-        }
-        return isBordering;
+        Point const lower = compositeDomain.lowerBound() + Point::diagonal();
+        Point const upper = compositeDomain.upperBound() - Point::diagonal();
+        // if a point is part of the domain's border, so is a corner of the bounding box.
+        return !lower.isLower(m_lower) || !m_upper.isLower(upper);
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Domain
+    DigitalComponent<dimension, Topology_T>::getBoundingBox() const
+    {
+        return Domain(m_lower, m_upper);
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::FloatScalar
+    DigitalComponent<dimension, Topology_T>::getAspectRatio() const
+    {
+        // Each pixel adds the variance of a unit square (1/12) along every axis,
+        // which keeps thin shapes finite.
+        Eigen::SelfAdjointEigenSolver<Matrix> solver(m_secondOrderMoments, Eigen::EigenvaluesOnly);
+        FloatScalar const pixelVariance = 1. / 12.;
+        return std::sqrt((solver.eigenvalues()[dimension - 1] + pixelVariance)
+                         / (std::max(solver.eigenvalues()[0], 0.) + pixelVariance));
     }
 
     template <int dimension, class Topology_T>
     typename DigitalComponent<dimension, Topology_T>::Area
       DigitalComponent<dimension, Topology_T>::getCountArea() const
     {
-        computeGeometryIfNotSet();
-        return static_cast<Area>(m_object.pointSet().size());
+        return static_cast<Area>(m_object ? m_object->pointSet().size() : getRuns().size());
     }
 
     template <int dimension, class Topology_T>
     typename DigitalComponent<dimension, Topology_T>::Area
-      DigitalComponent<dimension, Topology_T>::getConvexHullArea() const
+      DigitalComponent<dimension, Topology_T>::getConvexHullArea(PolygonArea formula) const
     {
-        computeGeometryIfNotSet();
+        ConvexHull const & convexHull = getConvexHull();
+        if (formula == PolygonArea::Shoelace)
+        {
+            return computeShoelaceArea(std::vector<Point>(convexHull.begin(), convexHull.end()));
+        }
+        Point const &      omega      = getOmega();
         // see report for first assignment for details.
         // answer_sheets/td1.md
         auto a = static_cast<Area>(0.);
 
-        auto begin = m_convexHull.begin();
-        auto end   = m_convexHull.end();
+        auto begin = convexHull.begin();
+        auto end   = convexHull.end();
 
         for (auto it = begin; it < end; ++it)
         {
@@ -206,7 +681,7 @@ namespace td::util
             Point const & p          = *it;
             Point const & q          = *(shouldLoop ? begin : std::next(it));
 
-            a += (p - q).norm() * (p + q - m_omega).norm();
+            a += (p - q).norm() * (p + q - omega).norm();
         }
         a /= static_cast<Area>(4.);
         return a;
@@ -214,16 +689,27 @@ namespace td::util
 
     template <int dimension, class Topology_T>
     typename DigitalComponent<dimension, Topology_T>::Area
-    DigitalComponent<dimension, Topology_T>::getSegmentationArea() const
+    DigitalComponent<dimension, Topology_T>::getSegmentationArea(PolygonArea formula) const
     {
-        computeGeometryIfNotSet();
+        if (formula == PolygonArea::Shoelace)
+        {
+            // Consecutive segments share an end point: the repeated vertices make null edges.
+            std::vector<Point> vertices;
+            for (auto const & segment : getSegmentation())
+            {
+                vertices.push_back(segment.front());
+                vertices.push_back(segment.back());
+            }
+            return computeShoelaceArea(vertices);
+        }
+        Point const & omega = getOmega();
         auto a = static_cast<Area>(0.);
-        for (auto const & segment : m_segmentation)
+        for (auto const & segment : getSegmentation())
         {
             Point const & p          = segment.front();
             Point const & q          = segment.back();
 
-            a += (p - q).norm() * (p + q - m_omega).norm();
+            a += (p - q).norm() * (p + q - omega).norm();
         }
         a /= static_cast<Area>(4.);
         return a;
@@ -231,27 +717,39 @@ namespace td::util
 
 
 
+    template <int dimension, class Topology_T>
+    typename DigitalComponent<dimension, Topology_T>::Area
+    DigitalComponent<dimension, Topology_T>::getMomentsArea() const
+    {
+        // Area of the ellipse with the same second-order moments, pi * a * b.
+        // The semi-axes are recovered as in getMomentsPerimeter,
+        // so the product of the eigenvalues is (a * b)^2 / 16.
+        // will only work in 2D.
+        FloatScalar const determinant = std::max(m_secondOrderMoments.determinant(), 0.);
+        return static_cast<Area>(4. * maths<FloatScalar>::pi() * std::sqrt(determinant));
+    }
+
     template <int dimension, class Topology_T>
     typename DigitalComponent<dimension, Topology_T>::Perimeter
       DigitalComponent<dimension, Topology_T>::getCountPerimeter() const
     {
-        computeGeometryIfNotSet();
-        return static_cast<Perimeter>(m_boundary.size());
+        // The boundary only, no hull nor segmentation.
+        return static_cast<Perimeter>(getBoundary().size());
     }
 
     template <int dimension, class Topology_T>
     typename DigitalComponent<dimension, Topology_T>::Perimeter
       DigitalComponent<dimension, Topology_T>::getConvexHullPerimeter() const
     {
-        computeGeometryIfNotSet();
+        ConvexHull const & convexHull = getConvexHull();
         // multiply by the surface of each cell.
         auto l  = static_cast<Perimeter>(0.);
-        for (auto it = m_convexHull.begin(); it < m_convexHull.end(); ++it)
+        for (auto it = convexHull.begin(); it < convexHull.end(); ++it)
         {
-            bool const shouldLoop = std::next(it) == m_convexHull.end();
+            bool const shouldLoop = std::next(it) == convexHull.end();
             // Will use L2 norm.
             Point const & p = *it;
-            Point const & q = *(shouldLoop ? m_convexHull.begin() : std::next(it));
+            Point const & q = *(shouldLoop ? convexHull.begin() : std::next(it));
             // Homography to set the scale of the diff in Real space.
             l += (p - q).norm();
         }
@@ -262,9 +760,8 @@ namespace td::util
     typename DigitalComponent<dimension, Topology_T>::Area
     DigitalComponent<dimension, Topology_T>::getSegmentationPerimeter() const
     {
-        computeGeometryIfNotSet();
         auto l  = static_cast<Perimeter>(0.);
-        for (auto const & segment : m_segmentation)
+        for (auto const & segment : getSegmentation())
         {
             // Will use L2 norm.
             Point const & p = segment.front();
@@ -275,11 +772,85 @@ namespace td::util
         return l;
     }
 
+    template <int dimension, class Topology_T>
+    typename DigitalComponent<dimension, Topology_T>::Perimeter
+    DigitalComponent<dimension, Topology_T>::getMomentsPerimeter() const
+    {
+        // The variance of a uniform ellipse along one of its axes is (semi-axis)^2 / 4,
+        // so the semi-axes are recovered from the eigenvalues of the covariance matrix.
+        // will only work in 2D.
+        Eigen::SelfAdjointEigenSolver<Matrix> solver(m_secondOrderMoments, Eigen::EigenvaluesOnly);
+        FloatScalar const a = 2. * std::sqrt(std::max(solver.eigenvalues()[dimension - 1], 0.));
+        FloatScalar const b = 2. * std::sqrt(std::max(solver.eigenvalues()[0], 0.));
+        // Ramanujan's approximation of the perimeter of an ellipse.
+        FloatScalar const pi = maths<FloatScalar>::pi();
+        return pi * (3. * (a + b) - std::sqrt((3. * a + b) * (a + 3. * b)));
+    }
+
+    template <int dimension, class Topology_T>
+    typename DigitalComponent<dimension, Topology_T>::Matrix
+    DigitalComponent<dimension, Topology_T>::computeSecondOrderMoments() const
+    {
+        typedef Eigen::Matrix<FloatScalar, dimension, 1> Column;
+        // Shifting the points by the first one keeps the sums small,
+        // the covariance does not depend on the origin.
+        Point const origin = *m_object->pointSet().begin();
+        Column sum    = Column::Zero();
+        Matrix sumSquared = Matrix::Zero();
+        for (auto const & point : m_object->pointSet())
+        {
+            Column const x = EigenUtility::dgtalPointToColumnVector<Point>(point - origin).template cast<FloatScalar>();
+            sum += x;
+            sumSquared += x * x.transpose();
+        }
+        auto const count = static_cast<FloatScalar>(m_object->pointSet().size());
+        Column const mean = sum / count;
+        return sumSquared / count - mean * mean.transpose();
+    }
+
+    template <int dimension, class Topology_T>
+    typename DigitalComponent<dimension, Topology_T>::Matrix
+      DigitalComponent<dimension, Topology_T>::computeSecondOrderMoments(Runs const & runs)
+    {
+        // Shifted by the first point as above. Along a run of n points from x,
+        // the sums of the powers of the abscissae are those of 0, ..., n - 1 shifted by x.
+        Domain const box    = runs.getBoundingBox();
+        Point const  origin = box.lowerBound();
+        FloatScalar  count = 0., sumX = 0., sumY = 0., sumXX = 0., sumXY = 0., sumYY = 0.;
+        for (Integer row = box.lowerBound()[1]; row <= box.upperBound()[1]; ++row)
+        {
+            auto const [first, last] = runs.getRow(row);
+            auto const y             = static_cast<FloatScalar>(row - origin[1]);
+            for (auto span = first; span != last; ++span)
+            {
+                auto const n  = static_cast<FloatScalar>(span->end - span->begin);
+                auto const x  = static_cast<FloatScalar>(span->begin - origin[0]);
+                // sums of k and k^2 for k in [0, n).
+                FloatScalar const k1  = n * (n - 1.) / 2.;
+                FloatScalar const k2  = (n - 1.) * n * (2. * n - 1.) / 6.;
+                FloatScalar const sx  = n * x + k1;
+                count += n;
+                sumX += sx;
+                sumY += n * y;
+                sumXX += n * x * x + 2. * x * k1 + k2;
+                sumXY += y * sx;
+                sumYY += n * y * y;
+            }
+        }
+        FloatScalar const meanX = sumX / count;
+        FloatScalar const meanY = sumY / count;
+        Matrix            moments;
+        moments(0, 0) = sumXX / count - meanX * meanX;
+        moments(0, 1) = sumXY / count - meanX * meanY;
+        moments(1, 0) = moments(0, 1);
+        moments(1, 1) = sumYY / count - meanY * meanY;
+        return moments;
+    }
+
     template <int dimension, class Topology_T>
     typename DigitalComponent<dimension, Topology_T>::FloatScalar
       DigitalComponent<dimension, Topology_T>::getCircularity() const
     {
-        computeGeometryIfNotSet();
         // We should use the segmentation to compute area and perimeter,
         // since it is more accurate.
         // See report for the rationale behind this definition.
@@ -291,6 +862,117 @@ namespace td::util
         return circularity;
     }
 
+    template <int dimension, class Topology_T>
+    std::vector<typename DigitalComponent<dimension, Topology_T>::FloatScalar>
+    DigitalComponent<dimension, Topology_T>::computeFourierDescriptors(std::size_t count) const
+    {
+        static_assert(dimension == 2, "Boundaries are only curves in 2D.");
+        typedef Eigen::Matrix<FloatScalar, dimension, 1> Column;
+
+        Column centroid = Column::Zero();
+        for (auto const & point : getPointSet())
+        {
+            centroid += EigenUtility::dgtalPointToColumnVector<Point>(point).template cast<FloatScalar>();
+        }
+        centroid /= static_cast<FloatScalar>(getPointSet().size());
+
+        // Resampling the closed boundary by arc length,
+        // so that the signature does not depend on how the pointels are spread.
+        std::vector<Column> vertices;
+        for (auto const & point : getBoundary().getPointsRange())
+        {
+            vertices.push_back(EigenUtility::dgtalPointToColumnVector<Point>(point).template cast<FloatScalar>());
+        }
+        std::vector<FloatScalar> lengths(vertices.size() + 1, 0.);
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+        {
+            lengths[i + 1] = lengths[i] + (vertices[(i + 1) % vertices.size()] - vertices[i]).norm();
+        }
+        std::vector<FloatScalar> radii(c_numberFourierSamples);
+        std::size_t              edge = 0;
+        for (std::size_t j = 0; j < c_numberFourierSamples; ++j)
+        {
+            FloatScalar const length =
+              lengths.back() * static_cast<FloatScalar>(j) / static_cast<FloatScalar>(c_numberFourierSamples);
+            while (lengths[edge + 1] < length)
+            {
+                ++edge;
+            }
+            FloatScalar const edgeLength = lengths[edge + 1] - lengths[edge];
+            FloatScalar const t          = edgeLength > 0. ? (length - lengths[edge]) / edgeLength : 0.;
+            Column const      sample =
+              (1. - t) * vertices[edge] + t * vertices[(edge + 1) % vertices.size()];
+            radii[j] = (sample - centroid).norm();
+        }
+
+        // A rotation of the shape shifts the samples, which only changes the phases.
+        FloatScalar const        pi = maths<FloatScalar>::pi();
+        FloatScalar const        n  = static_cast<FloatScalar>(c_numberFourierSamples);
+        FloatScalar const        mean = std::accumulate(radii.begin(), radii.end(), 0.) / n;
+        std::vector<FloatScalar> descriptors(count);
+        for (std::size_t k = 1; k <= count; ++k)
+        {
+            FloatScalar re = 0.;
+            FloatScalar im = 0.;
+            for (std::size_t j = 0; j < c_numberFourierSamples; ++j)
+            {
+                FloatScalar const phase = 2. * pi * static_cast<FloatScalar>(k * j) / n;
+                re += radii[j] * std::cos(phase);
+                im -= radii[j] * std::sin(phase);
+            }
+            descriptors[k - 1] = std::hypot(re, im) / (n * mean);
+        }
+        return descriptors;
+    }
+
+    template <int dimension, class Topology_T>
+    std::array<typename DigitalComponent<dimension, Topology_T>::FloatScalar, 7>
+    DigitalComponent<dimension, Topology_T>::computeHuMoments() const
+    {
+        static_assert(dimension == 2, "Hu moments are defined in 2D.");
+        // Central moments up to the third order, shifted by the first point as for the second order ones.
+        Point const origin = *getPointSet().begin();
+        FloatScalar sumX = 0.;
+        FloatScalar sumY = 0.;
+        for (auto const & point : getPointSet())
+        {
+            sumX += static_cast<FloatScalar>(point[0] - origin[0]);
+            sumY += static_cast<FloatScalar>(point[1] - origin[1]);
+        }
+        auto const        m00 = static_cast<FloatScalar>(getPointSet().size());
+        FloatScalar const cx  = sumX / m00;
+        FloatScalar const cy  = sumY / m00;
+        FloatScalar mu[4][4] = {};
+        for (auto const & point : getPointSet())
+        {
+            FloatScalar const x = static_cast<FloatScalar>(point[0] - origin[0]) - cx;
+            FloatScalar const y = static_cast<FloatScalar>(point[1] - origin[1]) - cy;
+            FloatScalar const x2 = x * x;
+            FloatScalar const y2 = y * y;
+            mu[2][0] += x2;
+            mu[1][1] += x * y;
+            mu[0][2] += y2;
+            mu[3][0] += x2 * x;
+            mu[2][1] += x2 * y;
+            mu[1][2] += x * y2;
+            mu[0][3] += y2 * y;
+        }
+        // Normalised by the area, for scale invariance.
+        auto const eta = [&mu, m00](int p, int q)
+        { return mu[p][q] / std::pow(m00, 1. + static_cast<FloatScalar>(p + q) / 2.); };
+        FloatScalar const n20 = eta(2, 0), n11 = eta(1, 1), n02 = eta(0, 2);
+        FloatScalar const n30 = eta(3, 0), n21 = eta(2, 1), n12 = eta(1, 2), n03 = eta(0, 3);
+        FloatScalar const a = n30 + n12;
+        FloatScalar const b = n21 + n03;
+        return {n20 + n02,
+                maths<FloatScalar>::power<2>(n20 - n02) + 4. * n11 * n11,
+                maths<FloatScalar>::power<2>(n30 - 3. * n12) + maths<FloatScalar>::power<2>(3. * n21 - n03),
+                a * a + b * b,
+                (n30 - 3. * n12) * a * (a * a - 3. * b * b) + (3. * n21 - n03) * b * (3. * a * a - b * b),
+                (n20 - n02) * (a * a - b * b) + 4. * n11 * a * b,
+                (3. * n21 - n03) * a * (a * a - 3. * b * b) - (n30 - 3. * n12) * b * (3. * a * a - b * b)};
+    }
+
     template <int dimension, class Topology_T>
     inline
     typename DigitalComponent<dimension, Topology_T>::Point
@@ -304,11 +986,45 @@ namespace td::util
         // Will most probably overflow here.
         // Should use dichotomy instead.
         // We would get an exact result since the coordinates are integers.
-        for (auto const& point : m_object.pointSet())
+        for (auto const& point : getPointSet())
         {
             sum += point;
         }
-        return sum / static_cast<Integer>(m_object.size());
+        return sum / static_cast<Integer>(getPointSet().size());
+    }
+
+    template <int dimension, class Topology_T>
+    inline std::vector<typename DigitalComponent<dimension, Topology_T>::Point>
+    DigitalComponent<dimension, Topology_T>::getBoundaryPoints() const
+    {
+        auto const & range = getBoundary().getPointsRange();
+        return std::vector<Point>(range.begin(), range.end());
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::PointSet const &
+    DigitalComponent<dimension, Topology_T>::getPointSet() const
+    {
+        return getObject().pointSet();
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename DigitalComponent<dimension, Topology_T>::Object const &
+      DigitalComponent<dimension, Topology_T>::getObject() const
+    {
+        if (m_object)
+        {
+            return *m_object;
+        }
+        return m_geometry->object.get(
+          [this]()
+          {
+              Runs const & runs = getRuns();
+              // Over the window, as the objects given to the constructor.
+              PointSet set(getWindow());
+              runs.insertInto(set);
+              return std::make_shared<Object const>(s_topology, set);
+          });
     }
 
     template <int dimension, class Topology_T>
@@ -317,6 +1033,7 @@ namespace td::util
         std::vector<Point> const & points1,
         std::vector<Point> const & points2)
     {
+        static_assert(dimension == 2, "Rotation angles are only defined in 2D.");
         // Will use Kabsch for the most accurate result.
         Matrix rotationMatrix = algorithms<FloatScalar>::computeRotationKabsch<Point>(points1, points2);
         // will only work in 2D.
@@ -329,17 +1046,15 @@ namespace td::util
     DigitalComponent<dimension, Topology_T>::computeLargestDistance(
         DistanceTransform const & otherBackgroundDistance) const
     {
-        auto it = std::max_element(
-          m_object.pointSet().begin(),
-          m_object.pointSet().end(),
-          [&otherBackgroundDistance](Point const & first, Point const & second) -> bool
-          {
-              Perimeter dist1 = otherBackgroundDistance(first);
-              Perimeter dist2 = otherBackgroundDistance(second);
-              return dist1 <= dist2;
-          }
-          );
-        return otherBackgroundDistance(*it);
+        // Exact comparisons, a single square root at the end.
+        SquaredDistance largestSquared = 0;
+        Perimeter       largestOutside = 0.;
+        visitDistances(
+          otherBackgroundDistance,
+          [&largestSquared](SquaredDistance const * run, std::size_t length)
+          { largestSquared = std::max(largestSquared, maths<SquaredDistance>::maximum(run, length)); },
+          [&largestOutside](Perimeter distance) { largestOutside = std::max(largestOutside, distance); });
+        return std::max(std::sqrt(static_cast<Perimeter>(largestSquared)), largestOutside);
     }
 
     template <int dimension, class Topology_T>
@@ -347,18 +1062,70 @@ namespace td::util
     DigitalComponent<dimension, Topology_T>::computeAverageDistance(
         DistanceTransform const & otherBackgroundDistance) const
     {
-        int count = 0;
-        return std::accumulate(
-          m_object.pointSet().begin(),
-          m_object.pointSet().end(),
-          static_cast<Perimeter>(0.),
-          [&otherBackgroundDistance, &count](Perimeter average, Point const & point) -> Perimeter
+        // The distances of a run are summed pairwise a chunk at a time, no buffer is allocated.
+        std::array<Perimeter, c_distanceChunkSize> chunk;
+        Perimeter                                  sum = 0.;
+        visitDistances(
+          otherBackgroundDistance,
+          [&chunk, &sum](SquaredDistance const * run, std::size_t length)
           {
-              Perimeter dist = otherBackgroundDistance(point);
-              average = (average * count + dist) / static_cast<Perimeter>(count + 1);
-              ++count;
-              return average;
-          });
+              for (std::size_t begin = 0; begin < length; begin += chunk.size())
+              {
+                  std::size_t const count = std::min(chunk.size(), length - begin);
+                  std::transform(run + begin,
+                                 run + begin + count,
+                                 chunk.begin(),
+                                 [](SquaredDistance squared) { return std::sqrt(static_cast<Perimeter>(squared)); });
+                  sum += maths<Perimeter>::sumPairwise(chunk.data(), count);
+              }
+          },
+          [&sum](Perimeter distance) { sum += distance; });
+        return sum / getCountArea();
+    }
+
+    template <int dimension, class Topology_T>
+    template <class RunFunction, class PointFunction>
+    void
+    DigitalComponent<dimension, Topology_T>::visitDistances(DistanceTransform const & distance,
+                                                            RunFunction const &       onRun,
+                                                            PointFunction const &     onOutside) const
+    {
+        // Each distance is read once, the reductions run on contiguous memory.
+        // The point set is sorted by columns first, which would jump a row of the transform at each point:
+        // the runs follow its rows, each one is a contiguous read.
+        Runs const &  runs   = getRuns();
+        Point const & dLower = distance.domain().lowerBound();
+        Point const & dUpper = distance.domain().upperBound();
+        for (Integer row = runs.domain().lowerBound()[1]; row <= runs.domain().upperBound()[1]; ++row)
+        {
+            bool const isRowInside = row >= dLower[1] && row <= dUpper[1];
+            // The next row starts a whole row of the transform further,
+            // its first run is fetched while this one is read.
+            auto const [nextFirst, nextLast] = runs.getRow(row + 1);
+            if (nextFirst != nextLast && distance.domain().isInside(Point(nextFirst->begin, row + 1)))
+            {
+                TD_UTIL_PREFETCH(distance.getRun(Point(nextFirst->begin, row + 1)));
+            }
+            auto const [first, last] = runs.getRow(row);
+            for (auto span = first; span != last; ++span)
+            {
+                // The part of the run in the domain, possibly empty.
+                Integer const begin = isRowInside ? std::max(span->begin, dLower[0]) : span->end;
+                Integer const end   = isRowInside ? std::min(span->end, dUpper[0] + 1) : span->end;
+                if (begin < end)
+                {
+                    onRun(distance.getRun(Point(begin, row)), static_cast<std::size_t>(end - begin));
+                }
+                // The others, clamped as in DistanceTransform::operator().
+                for (Integer x = span->begin; x < span->end; ++x)
+                {
+                    if (x < begin || x >= end)
+                    {
+                        onOutside(distance(Point(x, row)));
+                    }
+                }
+            }
+        }
     }
 
     template <int dimension, class Topology_T>
@@ -367,8 +1134,8 @@ namespace td::util
     {
         // find the min element.
         auto it = std::max_element(
-          m_object.pointSet().begin(),
-          m_object.pointSet().end(),
+          getPointSet().begin(),
+          getPointSet().end(),
           [&from](Point const & first, Point const & second) -> bool
           {
               // return true if first is greater,
@@ -395,54 +1162,92 @@ namespace td::util
 
     template <int dimension, class Topology_T>
     void
-    DigitalComponent<dimension, Topology_T>::drawObject(DGtal::Board2D & board, Colour const & objectColour) const
+    DigitalComponent<dimension, Topology_T>::drawObject(DrawingBuffer & drawing, Colour const & objectColour) const
     {
         // no need to compute geometry here.
-        board << DGtal::CustomStyle(m_object.className(), new DGtal::CustomFillColor(objectColour));
-        board << m_object;
+        drawing.addPixels(getPointSet(), objectColour);
     }
 
-
-        template <int dimension, class Topology_T>
+    template <int dimension, class Topology_T>
     void
-      DigitalComponent<dimension, Topology_T>::draw(DGtal::Board2D & board,
-                                                    Colour const &   objectColour,
-                                                    Colour const &   segmentColour,
-                                                    Colour const &   convexHullColour,
-                                                    Colour const &   boundaryColour) const
+      DigitalComponent<dimension, Topology_T>::draw(DrawingBuffer & drawing,
+                                                    Colour const &  objectColour,
+                                                    Colour const &  segmentColour,
+                                                    Colour const &  convexHullColour,
+                                                    Colour const &  boundaryColour) const
     {
-        computeGeometryIfNotSet();
+        static_assert(dimension == 2, "Drawings are 2D.");
+        Point const &        omega        = getOmega();
+        Segmentation const & segmentation = getSegmentation();
+
+        // there is a little +1/2 shift in the board exporter:
+        // pointel p is the lower left corner of pixel p.
+        double const offset = 0.5;
 
         // draw object and boundary
-        draw(board, objectColour);
-        board << DGtal::CustomStyle(m_boundary.className(), new DGtal::CustomFillColor(boundaryColour));
-        board << m_boundary;
+        drawObject(drawing, objectColour);
+        drawing.beginPolygon(boundaryColour);
+        for (auto const & point : getBoundary().getPointsRange())
+        {
+            drawing.addPoint(point[0] - offset, point[1] - offset);
+        }
 
         // draw Convex Hull (with segmentation, actually.)
-        board.setPenColor(convexHullColour);
-        board.setFillColor(Colour::None);
-        for (auto const & segment : m_segmentation)
+        for (auto const & segment : segmentation)
         {
-            Point const & p          = segment.front();
-            Point const & q          = segment.back();
-
-            // there is a little +1/2 shift in the board exporter
-            double offset = 0.5;
-            board.drawTriangle(
-              p[0] - offset,           p[1] - offset,
-              q[0] - offset,           q[1] - offset,
-              m_omega[0] / 2 - offset, m_omega[1] / 2 - offset
-              );
+            Point const & p = segment.front();
+            Point const & q = segment.back();
+            drawing.beginPolygon(convexHullColour);
+            drawing.addPoint(p[0] - offset, p[1] - offset);
+            drawing.addPoint(q[0] - offset, q[1] - offset);
+            drawing.addPoint(omega[0] / 2. - offset, omega[1] / 2. - offset);
         }
         // save segmentation
-        for (auto const & segment : m_segmentation)
+        for (auto const & segment : segmentation)
         {
-            board << DGtal::SetMode("ArithmeticalDSS", "BoundingBox");
-            board << DGtal::CustomStyle("ArithmeticalDSS/BoundingBox", new DGtal::CustomPenColor(segmentColour));
-            board << segment.primitive();
+            // Bounding box: the first and last points projected on both leaning lines,
+            // mu <= a x - b y <= mu + omega - 1.
+            auto const & dss     = segment.primitive();
+            auto const   a       = static_cast<double>(dss.a());
+            auto const   b       = static_cast<double>(dss.b());
+            double const norm    = a * a + b * b;
+            auto const   project = [&](Point const & point, double remainder)
+            {
+                double const t = (remainder - (a * point[0] - b * point[1])) / norm;
+                drawing.addPoint(point[0] + t * a - offset, point[1] - t * b - offset);
+            };
+            auto const lower = static_cast<double>(dss.mu());
+            auto const upper = static_cast<double>(dss.mu() + dss.omega() - 1);
+            drawing.beginPolygon(segmentColour);
+            project(dss.back(), lower);
+            project(dss.front(), lower);
+            project(dss.front(), upper);
+            project(dss.back(), upper);
         }
     }
 
+    template <int dimension, class Topology_T>
+    void
+    DigitalComponent<dimension, Topology_T>::drawObject(DGtal::Board2D & board, Colour const & objectColour) const
+    {
+        DrawingBuffer drawing;
+        drawObject(drawing, objectColour);
+        drawing.replay(board);
+    }
+
+    template <int dimension, class Topology_T>
+    void
+      DigitalComponent<dimension, Topology_T>::draw(DGtal::Board2D & board,
+                                                    Colour const &   objectColour,
+                                                    Colour const &   segmentColour,
+                                                    Colour const &   convexHullColour,
+                                                    Colour const &   boundaryColour) const
+    {
+        DrawingBuffer drawing;
+        draw(drawing, objectColour, segmentColour, convexHullColour, boundaryColour);
+        drawing.replay(board);
+    }
+
 }  // namespace td::util
 
 #endif  // TD_UTIL_DIGITALCOMPONENT_INL
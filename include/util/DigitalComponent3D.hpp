@@ -0,0 +1,125 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_DIGITALCOMPONENT3D_HPP
+#define TD_UTIL_DIGITALCOMPONENT3D_HPP
+
+#include <util/BinaryVolume.hpp>
+#include <util/DigitalComponent.hpp>
+
+#include <set>
+
+namespace td::util
+{
+    /// Closed digital objects in 3D, made of voxels.
+    /// The voxels are kept as a one-bit mask over the bounding box of the component and a margin,
+    /// rather than as a set of points: a voxel takes one bit instead of a tree node.
+    /// The boundary is the set of surfels between the component and the background, cavities included.
+    /// \tparam Topology_T (6, 26), (6, 18), ...
+    template <class Topology_T>
+    class DigitalComponent<3, Topology_T>
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        static constexpr int dimension = 3;
+
+        // Topology
+        typedef Topology_T                                  DigitalTopology;
+        typedef typename DigitalTopology::Space::Integer    Integer;
+        typedef DGtal::KhalimskySpaceND<dimension, Integer> KSpace;
+        typedef DGtal::SpaceND<dimension, Integer>          Space;
+        typedef DGtal::HyperRectDomain<Space>               Domain;
+
+        typedef typename KSpace::SCell      SCell;
+        typedef typename Space::Point       Point;
+        typedef typename Space::Vector      Vector;
+        typedef typename Space::RealPoint   RealPoint;
+        typedef std::set<SCell>             SurfelSet;
+        // Voxels of the component, a model of point predicate.
+        typedef BinaryVolume Voxels;
+
+        typedef double FloatScalar;
+        // Volume and surface area, in voxel units.
+        typedef double Volume;
+        typedef double Area;
+
+        // matrix and vector types
+        typedef Eigen::Matrix<FloatScalar, dimension, dimension> Matrix;
+        typedef Eigen::Matrix<FloatScalar, dimension, 1>         ColumnVector;
+
+        // constraints
+        static_assert(std::is_same_v<Point, Voxels::Point>);
+
+        /** --------- methods ------------- **/
+        /// \param voxels domain is the bounding box of the component and a margin of one voxel.
+        inline explicit DigitalComponent(Voxels voxels);
+
+        // Volume computations.
+        [[nodiscard]] inline Volume
+          getCountVolume() const;
+
+        // Surface area computations.
+        /// Number of surfels, not an estimate of the area:
+        /// a plane of unit normal n is overestimated by a factor |n|_1, up to sqrt(3).
+        [[nodiscard]] inline Area
+          getCountSurfaceArea() const;
+        /// Sum over the surfels of the estimated normal projected on the surfel's own normal.
+        /// The normal of a surfel is the mean outward normal of the surfels within radius of its centre,
+        /// which tends to the normal of a plane as the radius grows: tilted surfaces are no longer overestimated.
+        /// Each call sorts the surfels and visits the neighbourhood of each one.
+        /// \param radius in voxels.
+        /// \return
+        [[nodiscard]] Area
+          computeNormalSurfaceArea(FloatScalar radius = c_normalRadius) const;
+
+        // Moments.
+        [[nodiscard]] inline RealPoint
+          getCentroid() const;
+        /// Covariance matrix of the voxels (central moments of order 2).
+        [[nodiscard]] inline Matrix
+          getSecondOrderMoments() const;
+        /// Eigenvalues of the covariance matrix, in increasing order.
+        [[nodiscard]] inline ColumnVector
+          getPrincipalMoments() const;
+
+        [[nodiscard]] inline SurfelSet const &
+          getBoundary() const;
+
+        [[nodiscard]] inline Voxels const &
+          getVoxels() const;
+
+        [[nodiscard]] inline bool
+          isBorderingRim(Domain const & compositeDomain) const;
+
+        /// Tracks the boundary now, rather than when first needed.
+        /// Components do not share anything, so this can be called from several threads
+        /// on different components.
+        inline void
+          computeGeometry() const;
+
+       private:
+        /** --------- methods ------------- **/
+        [[nodiscard]] inline static SurfelSet
+          computeBoundary(Voxels const & voxels);
+
+        inline void
+          computeGeometryIfNotSet() const;
+
+        /** --------- data ------------- **/
+        Voxels      m_voxels;
+        std::size_t m_count;
+        // Computed from the digital object.
+        SurfelSet mutable m_boundary;
+
+        // Computing geometry only if needed.
+        bool mutable m_isSet;
+
+        // Radius of the neighbourhood averaging the normals of the surfels, in voxels.
+        static constexpr FloatScalar c_normalRadius = 3.;
+    };
+}  // namespace td::util
+
+#include "DigitalComponent3D.inl"
+
+#endif  // TD_UTIL_DIGITALCOMPONENT3D_HPP
@@ -0,0 +1,233 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_DIGITALCOMPONENT3D_INL
+#define TD_UTIL_DIGITALCOMPONENT3D_INL
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace td::util
+{
+    template <class Topology_T>
+    inline DigitalComponent<3, Topology_T>::DigitalComponent(Voxels voxels)
+        : m_voxels(std::move(voxels)), m_count(m_voxels.count()), m_boundary(), m_isSet(false)
+    {}
+
+    template <class Topology_T>
+    inline void
+      DigitalComponent<3, Topology_T>::computeGeometry() const
+    {
+        m_boundary = computeBoundary(m_voxels);
+        // The object is now set!
+        m_isSet = true;
+    }
+
+    template <class Topology_T>
+    inline void
+      DigitalComponent<3, Topology_T>::computeGeometryIfNotSet() const
+    {
+        if (!m_isSet)
+        {
+            computeGeometry();
+        }
+    }
+
+    template <class Topology_T>
+    inline typename DigitalComponent<3, Topology_T>::SurfelSet
+      DigitalComponent<3, Topology_T>::computeBoundary(Voxels const & voxels)
+    {
+        // Khalimsky space over the domain of the component only.
+        KSpace kSpace;
+        kSpace.init(voxels.domain().lowerBound(), voxels.domain().upperBound(), true);
+
+        // Tracking from one bel would only follow the surface it lies on, missing those of the cavities.
+        // Every pair of face-adjacent voxels of the box is visited instead:
+        // the mask only holds the component, so each pair of different values is a surfel of its boundary.
+        SurfelSet boundary;
+        DGtal::Surfaces<KSpace>::sMakeBoundary(
+          boundary, kSpace, voxels, voxels.domain().lowerBound(), voxels.domain().upperBound());
+        return boundary;
+    }
+
+    template <class Topology_T>
+    inline typename DigitalComponent<3, Topology_T>::Volume
+      DigitalComponent<3, Topology_T>::getCountVolume() const
+    {
+        return static_cast<Volume>(m_count);
+    }
+
+    template <class Topology_T>
+    inline typename DigitalComponent<3, Topology_T>::Area
+      DigitalComponent<3, Topology_T>::getCountSurfaceArea() const
+    {
+        computeGeometryIfNotSet();
+        return static_cast<Area>(m_boundary.size());
+    }
+
+    template <class Topology_T>
+    typename DigitalComponent<3, Topology_T>::Area
+      DigitalComponent<3, Topology_T>::computeNormalSurfaceArea(FloatScalar radius) const
+    {
+        computeGeometryIfNotSet();
+        KSpace kSpace;
+        kSpace.init(m_voxels.domain().lowerBound(), m_voxels.domain().upperBound(), true);
+
+        // Centre of each surfel in Khalimsky coordinates, twice the voxel ones, from the corner of the mask.
+        Point const               lower = m_voxels.domain().lowerBound();
+        std::vector<Point>        centres;
+        std::vector<ColumnVector> normals;
+        centres.reserve(m_boundary.size());
+        normals.reserve(m_boundary.size());
+        for (auto const & surfel : m_boundary)
+        {
+            // The outward normal of a surfel points away from its voxel of the component.
+            DGtal::Dimension const axis           = kSpace.sOrthDir(surfel);
+            bool const             isDirectInside = m_voxels(kSpace.sCoords(kSpace.sDirectIncident(surfel, axis)));
+            ColumnVector           normal         = ColumnVector::Zero();
+            normal[axis] = kSpace.sDirect(surfel, axis) == isDirectInside ? -1. : 1.;
+            centres.push_back(kSpace.sKCoords(surfel) - lower - lower);
+            normals.push_back(normal);
+        }
+
+        // The surfels are sorted by cells of a grid, as wide as the neighbourhood,
+        // so the neighbours of a surfel are in the 27 cells around its own.
+        auto const  kRadius = static_cast<Integer>(std::ceil(2. * radius));
+        Point const extent  = m_voxels.domain().upperBound() - lower + Point::diagonal();
+        Point       numberCells;
+        for (DGtal::Dimension k = 0; k < dimension; ++k)
+        {
+            numberCells[k] = 2 * extent[k] / kRadius + 1;
+        }
+        auto const getCell = [kRadius](Point const & centre)
+        {
+            Point cell;
+            for (DGtal::Dimension k = 0; k < dimension; ++k)
+            {
+                cell[k] = centre[k] / kRadius;
+            }
+            return cell;
+        };
+        auto const getKey = [&numberCells](Point const & cell)
+        {
+            return (static_cast<std::size_t>(cell[2]) * static_cast<std::size_t>(numberCells[1])
+                    + static_cast<std::size_t>(cell[1]))
+                     * static_cast<std::size_t>(numberCells[0])
+                   + static_cast<std::size_t>(cell[0]);
+        };
+        std::vector<std::pair<std::size_t, std::size_t>> keys(centres.size());
+        for (std::size_t i = 0; i < centres.size(); ++i)
+        {
+            keys[i] = {getKey(getCell(centres[i])), i};
+        }
+        std::sort(keys.begin(), keys.end());
+        auto const isKeyLess = [](auto const & a, auto const & b) { return a.first < b.first; };
+
+        auto const squaredRadius = static_cast<std::int64_t>(kRadius) * kRadius;
+        Area       area          = 0.;
+        for (std::size_t i = 0; i < centres.size(); ++i)
+        {
+            Point const  cell = getCell(centres[i]);
+            ColumnVector mean = ColumnVector::Zero();
+            Domain const around((cell - Point::diagonal()).sup(Point::zero),
+                                (cell + Point::diagonal()).inf(numberCells - Point::diagonal()));
+            for (auto const & neighbourCell : around)
+            {
+                auto const range = std::equal_range(
+                  keys.begin(), keys.end(), std::make_pair(getKey(neighbourCell), std::size_t {0}), isKeyLess);
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    Point const        offset          = centres[it->second] - centres[i];
+                    std::int64_t const squaredDistance = std::inner_product(
+                      offset.begin(), offset.end(), offset.begin(), std::int64_t {0});
+                    if (squaredDistance <= squaredRadius)
+                    {
+                        mean += normals[it->second];
+                    }
+                }
+            }
+            // The surfel itself is in its neighbourhood, the mean only vanishes on thin parts.
+            FloatScalar const norm = mean.norm();
+            area += norm > 0. ? mean.dot(normals[i]) / norm : 1.;
+        }
+        return area;
+    }
+
+    template <class Topology_T>
+    inline typename DigitalComponent<3, Topology_T>::RealPoint
+      DigitalComponent<3, Topology_T>::getCentroid() const
+    {
+        // Summing in floating point, the coordinates of large volumes would overflow.
+        ColumnVector sum = ColumnVector::Zero();
+        m_voxels.forEachPoint(
+          [&sum](Point const & point)
+          { sum += EigenUtility::dgtalPointToColumnVector<Point>(point).template cast<FloatScalar>(); });
+        sum /= static_cast<FloatScalar>(m_count);
+        return RealPoint(sum[0], sum[1], sum[2]);
+    }
+
+    template <class Topology_T>
+    inline typename DigitalComponent<3, Topology_T>::Matrix
+      DigitalComponent<3, Topology_T>::getSecondOrderMoments() const
+    {
+        // Shifting the points by the corner of the mask keeps the sums small,
+        // the covariance does not depend on the origin.
+        Point const  origin     = m_voxels.domain().lowerBound();
+        ColumnVector sum        = ColumnVector::Zero();
+        Matrix       sumSquared = Matrix::Zero();
+        m_voxels.forEachPoint(
+          [&origin, &sum, &sumSquared](Point const & point)
+          {
+              ColumnVector const x =
+                EigenUtility::dgtalPointToColumnVector<Point>(point - origin).template cast<FloatScalar>();
+              sum += x;
+              sumSquared += x * x.transpose();
+          });
+        auto const         count = static_cast<FloatScalar>(m_count);
+        ColumnVector const mean  = sum / count;
+        return sumSquared / count - mean * mean.transpose();
+    }
+
+    template <class Topology_T>
+    inline typename DigitalComponent<3, Topology_T>::ColumnVector
+      DigitalComponent<3, Topology_T>::getPrincipalMoments() const
+    {
+        // Fixed size solver, no allocation.
+        Eigen::SelfAdjointEigenSolver<Matrix> solver(getSecondOrderMoments(), Eigen::EigenvaluesOnly);
+        return solver.eigenvalues();
+    }
+
+    template <class Topology_T>
+    inline typename DigitalComponent<3, Topology_T>::SurfelSet const &
+      DigitalComponent<3, Topology_T>::getBoundary() const
+    {
+        computeGeometryIfNotSet();
+        return m_boundary;
+    }
+
+    template <class Topology_T>
+    inline typename DigitalComponent<3, Topology_T>::Voxels const &
+      DigitalComponent<3, Topology_T>::getVoxels() const
+    {
+        return m_voxels;
+    }
+
+    template <class Topology_T>
+    inline bool
+      DigitalComponent<3, Topology_T>::isBorderingRim(Domain const & compositeDomain) const
+    {
+        Domain const borderless = Domain(compositeDomain.lowerBound() + Point::diagonal(),
+                                         compositeDomain.upperBound() - Point::diagonal());
+        // The bounding box has voxels on each of its faces,
+        // it leaves the borderless domain only if a voxel does.
+        return !borderless.isInside(m_voxels.domain().lowerBound() + Point::diagonal())
+               || !borderless.isInside(m_voxels.domain().upperBound() - Point::diagonal());
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_DIGITALCOMPONENT3D_INL
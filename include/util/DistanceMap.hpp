@@ -0,0 +1,118 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_DISTANCEMAP_HPP
+#define TD_UTIL_DISTANCEMAP_HPP
+
+#include <util/BandedRaster.hpp>
+
+#include <DGtal/helpers/StdDefs.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace td::util
+{
+    /// Exact Euclidean distance transform of a 2D domain, after Meijster et al.,
+    /// "A general algorithm for computing distance transforms in linear time", 2000.
+    /// Rows are scanned in parallel in the first phase, columns in the second,
+    /// the intermediate buffers being transposed tile by tile to keep both phases on contiguous memory.
+    /// \tparam Space_T
+    template <class Space_T>
+    class DistanceMap
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef Space_T                       Space;
+        typedef typename Space::Point         Point;
+        typedef typename Space::Integer       Integer;
+        typedef DGtal::HyperRectDomain<Space> Domain;
+
+        // Squared distances are exact integers.
+        typedef std::int64_t SquaredDistance;
+        typedef double       Distance;
+
+        // constraints
+        static_assert(Space::dimension == 2, "DistanceMap is implemented in 2D.");
+
+        /** --------- methods ------------- **/
+        /// \tparam SitePredicate Point -> bool, called from several threads.
+        /// \param domain of the map.
+        /// \param isSite points at distance 0.
+        /// \param numberThreads 0 to use all hardware threads.
+        template <class SitePredicate>
+        DistanceMap(Domain const & domain, SitePredicate const & isSite, unsigned int numberThreads = 0);
+
+        /// Map over a box grown by a margin (and clipped by the domain) only.
+        /// Sites outside of the window are ignored: the distances are exact when the nearest site
+        /// is in the window, which holds for any point of the box if the margin is background.
+        /// \param domain
+        /// \param isSite
+        /// \param box
+        /// \param margin
+        /// \param numberThreads
+        /// \return
+        template <class SitePredicate>
+        [[nodiscard]] static DistanceMap
+          computeLocal(Domain const &        domain,
+                       SitePredicate const & isSite,
+                       Domain const &        box,
+                       Integer               margin,
+                       unsigned int          numberThreads = 0);
+
+        /// Copies the distances of another map over a box, to update a region after its sites changed.
+        /// Only the bands of rows of the box are copied from the maps sharing them (see BandedRaster).
+        /// \param other map over the same sites, exact over the box (see computeLocal).
+        /// \param box must be in both domains.
+        inline void
+          paste(DistanceMap const & other, Domain const & box);
+
+        /// Squared distance to the nearest site.
+        /// \param point must be in the domain.
+        [[nodiscard]] inline SquaredDistance
+          getSquaredDistance(Point const & point) const;
+
+        /// Squared distances of a run of points along the first axis, contiguous in memory.
+        /// \param first point of the run, the whole run must be in the domain.
+        [[nodiscard]] inline SquaredDistance const *
+          getRun(Point const & first) const;
+
+        /// Distance to the nearest site.
+        /// Outside of the domain, an upper bound: the distance to the closest point of the domain
+        /// plus the distance there.
+        [[nodiscard]] inline Distance
+          operator()(Point const & point) const;
+
+        [[nodiscard]] inline Domain const &
+          domain() const;
+
+       private:
+        /** --------- methods ------------- **/
+        /// Copies a (rows x columns) matrix into its (columns x rows) transpose, tile by tile.
+        /// \param outputRow j -> pointer to row j of the transpose, of rows values.
+        template <typename T, class OutputRow>
+        static void
+          transpose(std::vector<T> const & in,
+                    OutputRow const &      outputRow,
+                    std::size_t            rows,
+                    std::size_t            columns,
+                    unsigned int           numberThreads);
+
+        /** --------- data ------------- **/
+        Domain                        m_domain;
+        std::size_t                   m_width;
+        std::size_t                   m_height;
+        // In bands of rows, so that copies share them until paste writes them.
+        BandedRaster<SquaredDistance> m_squaredDistances;
+
+        // Side of the square tiles of the transpositions (fits in L1 for 64-bit values).
+        static constexpr std::size_t c_tileSize = 32;
+        // Under this number of pixels, a single thread is faster.
+        static constexpr std::size_t c_minimumParallelSize = std::size_t {1} << 16;
+    };
+}  // namespace td::util
+
+#include "DistanceMap.inl"
+
+#endif  // TD_UTIL_DISTANCEMAP_HPP
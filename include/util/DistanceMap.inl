@@ -0,0 +1,237 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_DISTANCEMAP_INL
+#define TD_UTIL_DISTANCEMAP_INL
+
+#include <util/Profiler.hpp>
+#include <util/parallel.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace td::util
+{
+    template <class Space_T>
+    template <class SitePredicate>
+    DistanceMap<Space_T>::DistanceMap(Domain const & domain, SitePredicate const & isSite, unsigned int numberThreads)
+        : m_domain(domain),
+          // Empty domains have an upper bound below their lower bound.
+          m_width(static_cast<std::size_t>(
+            std::max<Integer>(domain.upperBound()[0] - domain.lowerBound()[0] + 1, 0))),
+          m_height(static_cast<std::size_t>(
+            std::max<Integer>(domain.upperBound()[1] - domain.lowerBound()[1] + 1, 0))),
+          m_squaredDistances()
+    {
+        TD_PROFILE_SCOPE("distanceTransform");
+        // Nothing to compute, and the backward scans below start at m_width - 1.
+        if (m_width == 0 || m_height == 0)
+        {
+            return;
+        }
+        // The row distances and their transpose, the squared distances and their transpose,
+        // and the two stacks of each column.
+        TD_PROFILE_COUNT("distance transform bytes allocated",
+                         m_width * m_height
+                           * (2 * sizeof(std::int32_t) + 2 * sizeof(SquaredDistance) + 2 * sizeof(std::int64_t)));
+        if (m_width * m_height < c_minimumParallelSize)
+        {
+            numberThreads = 1;
+        }
+        Point const lower = domain.lowerBound();
+        // Larger than any distance in the domain, small enough to be squared.
+        auto const infinity = static_cast<std::int32_t>(m_width + m_height);
+
+        // Phase 1: distance to the nearest site of the same row, one row per task.
+        std::vector<std::int32_t> g(m_width * m_height);
+        parallel::forEach(m_height,
+                          numberThreads,
+                          [&](std::size_t y)
+                          {
+                              std::int32_t * const row = g.data() + y * m_width;
+                              Point                point(lower[0], lower[1] + static_cast<Integer>(y));
+                              std::int32_t         last = infinity;
+                              for (std::size_t x = 0; x < m_width; ++x, ++point[0])
+                              {
+                                  last   = isSite(point) ? 0 : std::min(last + 1, infinity);
+                                  row[x] = last;
+                              }
+                              for (std::size_t x = m_width - 1; x-- > 0;)
+                              {
+                                  row[x] = std::min(row[x], row[x + 1] + 1);
+                              }
+                          });
+
+        // Columns become rows.
+        std::vector<std::int32_t> gT(g.size());
+        transpose(
+          g, [&gT, this](std::size_t column) { return gT.data() + column * m_height; }, m_height, m_width, numberThreads);
+        g = std::vector<std::int32_t>();
+
+        // Phase 2: lower envelope of the parabolas of each column, one column per task.
+        std::vector<SquaredDistance> dT(gT.size());
+        std::size_t const            n = m_height;
+        parallel::forEach(
+          m_width,
+          numberThreads,
+          [&](std::size_t x)
+          {
+              std::int32_t const * const column = gT.data() + x * n;
+              SquaredDistance * const    out    = dT.data() + x * n;
+              // Each task has its own stacks.
+              std::vector<std::int64_t> s(n);
+              std::vector<std::int64_t> t(n);
+              auto const f = [column](std::int64_t u, std::int64_t i)
+              { return (u - i) * (u - i) + static_cast<std::int64_t>(column[i]) * column[i]; };
+              auto const sep = [column](std::int64_t i, std::int64_t u)
+              {
+                  std::int64_t const gi = column[i];
+                  std::int64_t const gu = column[u];
+                  return (u * u - i * i + gu * gu - gi * gi) / (2 * (u - i));
+              };
+              std::int64_t q = 0;
+              s[0]           = 0;
+              t[0]           = 0;
+              for (std::int64_t u = 1; u < static_cast<std::int64_t>(n); ++u)
+              {
+                  while (q >= 0 && f(t[q], s[q]) > f(t[q], u))
+                  {
+                      --q;
+                  }
+                  if (q < 0)
+                  {
+                      q    = 0;
+                      s[0] = u;
+                  }
+                  else
+                  {
+                      std::int64_t const w = 1 + sep(s[q], u);
+                      if (w < static_cast<std::int64_t>(n))
+                      {
+                          ++q;
+                          s[q] = u;
+                          t[q] = w;
+                      }
+                  }
+              }
+              for (std::int64_t u = static_cast<std::int64_t>(n) - 1; u >= 0; --u)
+              {
+                  out[u] = f(u, s[q]);
+                  if (u == t[q])
+                  {
+                      --q;
+                  }
+              }
+          });
+        gT = std::vector<std::int32_t>();
+
+        // And back to rows.
+        m_squaredDistances = BandedRaster<SquaredDistance>(m_width, m_height);
+        transpose(
+          dT, [this](std::size_t row) { return m_squaredDistances.getMutableRow(row); }, m_width, m_height, numberThreads);
+    }
+
+    template <class Space_T>
+    template <class SitePredicate>
+    DistanceMap<Space_T>
+      DistanceMap<Space_T>::computeLocal(Domain const &        domain,
+                                         SitePredicate const & isSite,
+                                         Domain const &        box,
+                                         Integer               margin,
+                                         unsigned int          numberThreads)
+    {
+        Point const lower = (box.lowerBound() - Point::diagonal(margin)).sup(domain.lowerBound());
+        Point const upper = (box.upperBound() + Point::diagonal(margin)).inf(domain.upperBound());
+        return DistanceMap(Domain(lower, upper), isSite, numberThreads);
+    }
+
+    template <class Space_T>
+    template <typename T, class OutputRow>
+    void
+      DistanceMap<Space_T>::transpose(std::vector<T> const & in,
+                                      OutputRow const &      outputRow,
+                                      std::size_t            rows,
+                                      std::size_t            columns,
+                                      unsigned int           numberThreads)
+    {
+        // One band of tile rows per task, each tile read and written while it is in cache.
+        std::size_t const numberBands = (rows + c_tileSize - 1) / c_tileSize;
+        parallel::forEach(numberBands,
+                          numberThreads,
+                          [&](std::size_t band)
+                          {
+                              std::size_t const rowBegin = band * c_tileSize;
+                              std::size_t const rowEnd   = std::min(rowBegin + c_tileSize, rows);
+                              for (std::size_t columnBegin = 0; columnBegin < columns; columnBegin += c_tileSize)
+                              {
+                                  std::size_t const columnEnd = std::min(columnBegin + c_tileSize, columns);
+                                  for (std::size_t j = columnBegin; j < columnEnd; ++j)
+                                  {
+                                      T * const out = outputRow(j);
+                                      for (std::size_t i = rowBegin; i < rowEnd; ++i)
+                                      {
+                                          out[i] = in[i * columns + j];
+                                      }
+                                  }
+                              }
+                          });
+    }
+
+    template <class Space_T>
+    inline void
+      DistanceMap<Space_T>::paste(DistanceMap const & other, Domain const & box)
+    {
+        ASSERT(m_domain.isInside(box.lowerBound()) && m_domain.isInside(box.upperBound()));
+        ASSERT(other.m_domain.isInside(box.lowerBound()) && other.m_domain.isInside(box.upperBound()));
+        auto const width = static_cast<std::ptrdiff_t>(box.upperBound()[0] - box.lowerBound()[0] + 1);
+        // One contiguous segment per row of the box.
+        for (Point point = box.lowerBound(); point[1] <= box.upperBound()[1]; ++point[1])
+        {
+            Point const                   local  = point - m_domain.lowerBound();
+            SquaredDistance const * const source = other.getRun(point);
+            std::copy(source,
+                      source + width,
+                      m_squaredDistances.getMutableRow(static_cast<std::size_t>(local[1])) + local[0]);
+        }
+    }
+
+    template <class Space_T>
+    inline typename DistanceMap<Space_T>::SquaredDistance
+      DistanceMap<Space_T>::getSquaredDistance(Point const & point) const
+    {
+        ASSERT(m_domain.isInside(point));
+        Point const local = point - m_domain.lowerBound();
+        return m_squaredDistances.getRow(static_cast<std::size_t>(local[1]))[local[0]];
+    }
+
+    template <class Space_T>
+    inline typename DistanceMap<Space_T>::SquaredDistance const *
+      DistanceMap<Space_T>::getRun(Point const & first) const
+    {
+        ASSERT(m_domain.isInside(first));
+        Point const local = first - m_domain.lowerBound();
+        return m_squaredDistances.getRow(static_cast<std::size_t>(local[1])) + local[0];
+    }
+
+    template <class Space_T>
+    inline typename DistanceMap<Space_T>::Distance
+      DistanceMap<Space_T>::operator()(Point const & point) const
+    {
+        if (m_domain.isInside(point))
+        {
+            return std::sqrt(static_cast<Distance>(getSquaredDistance(point)));
+        }
+        Point const clamped = point.sup(m_domain.lowerBound()).inf(m_domain.upperBound());
+        return std::sqrt(static_cast<Distance>(getSquaredDistance(clamped))) + (point - clamped).norm();
+    }
+
+    template <class Space_T>
+    inline typename DistanceMap<Space_T>::Domain const &
+      DistanceMap<Space_T>::domain() const
+    {
+        return m_domain;
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_DISTANCEMAP_INL
@@ -0,0 +1,109 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_DRAWINGBUFFER_HPP
+#define TD_UTIL_DRAWINGBUFFER_HPP
+
+#include <DGtal/helpers/StdDefs.h>
+#include <DGtal/io/boards/Board2D.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace td::util
+{
+    /// Draw commands, recorded during the analysis and rendered later (see DrawingWriter).
+    /// A command is a style and a run of coordinates, all runs sharing one buffer:
+    /// recording a component costs a few bytes per pixel and no DGtal style object.
+    /// Coordinates are those of Board2D, pixel (x, y) being the unit square centred on (x, y).
+    class DrawingBuffer
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef DGtal::Color Colour;
+
+        struct Coordinate
+        {
+            float x;
+            float y;
+        };
+
+        enum class Shape : std::uint8_t
+        {
+            // Unit squares centred on each coordinate.
+            Pixels,
+            // Closed polygon through the coordinates.
+            Polygon
+        };
+
+        struct Command
+        {
+            Shape         shape;
+            Colour        pen;
+            Colour        fill;
+            std::uint32_t first;
+            std::uint32_t count;
+        };
+
+        struct Bounds
+        {
+            Coordinate lower;
+            Coordinate upper;
+        };
+
+        /** --------- methods ------------- **/
+        DrawingBuffer() = default;
+
+        /// Starts a run of pixels, see addPoint.
+        inline void
+          beginPixels(Colour const & fill, Colour const & pen = Colour::None);
+
+        /// Starts a polygon, see addPoint.
+        inline void
+          beginPolygon(Colour const & pen, Colour const & fill = Colour::None);
+
+        /// Adds a coordinate to the last command.
+        inline void
+          addPoint(double x, double y);
+
+        /// Adds all the points of a range as pixels.
+        /// \tparam PointRange range of 2D points with operator[].
+        template <class PointRange>
+        inline void
+          addPixels(PointRange const & points, Colour const & fill, Colour const & pen = Colour::None);
+
+        /// Draws the commands on a board, in order.
+        inline void
+          replay(DGtal::Board2D & board) const;
+
+        /// Smallest box containing every shape, pixels included.
+        /// \return undefined if the buffer is empty.
+        [[nodiscard]] inline Bounds
+          getBounds() const;
+
+        [[nodiscard]] inline std::vector<Command> const &
+          getCommands() const;
+        [[nodiscard]] inline std::vector<Coordinate> const &
+          getCoordinates() const;
+
+        [[nodiscard]] inline bool
+          empty() const;
+
+        /// Colours of labels, distinct for close labels (golden angle steps of hue).
+        [[nodiscard]] inline static Colour
+          getLabelColour(std::size_t label);
+
+        inline void
+          clear();
+
+       private:
+        /** --------- data ------------- **/
+        std::vector<Command>    m_commands;
+        std::vector<Coordinate> m_coordinates;
+    };
+}  // namespace td::util
+
+#include "DrawingBuffer.inl"
+
+#endif  // TD_UTIL_DRAWINGBUFFER_HPP
@@ -0,0 +1,143 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_DRAWINGBUFFER_INL
+#define TD_UTIL_DRAWINGBUFFER_INL
+
+#include <algorithm>
+#include <cmath>
+
+namespace td::util
+{
+    inline void
+      DrawingBuffer::beginPixels(Colour const & fill, Colour const & pen)
+    {
+        m_commands.push_back({Shape::Pixels, pen, fill, static_cast<std::uint32_t>(m_coordinates.size()), 0});
+    }
+
+    inline void
+      DrawingBuffer::beginPolygon(Colour const & pen, Colour const & fill)
+    {
+        m_commands.push_back({Shape::Polygon, pen, fill, static_cast<std::uint32_t>(m_coordinates.size()), 0});
+    }
+
+    inline void
+      DrawingBuffer::addPoint(double x, double y)
+    {
+        ASSERT(!m_commands.empty());
+        m_coordinates.push_back({static_cast<float>(x), static_cast<float>(y)});
+        ++m_commands.back().count;
+    }
+
+    template <class PointRange>
+    inline void
+      DrawingBuffer::addPixels(PointRange const & points, Colour const & fill, Colour const & pen)
+    {
+        beginPixels(fill, pen);
+        for (auto const & point : points)
+        {
+            addPoint(point[0], point[1]);
+        }
+    }
+
+    inline void
+      DrawingBuffer::replay(DGtal::Board2D & board) const
+    {
+        std::vector<LibBoard::Point> polygon;
+        for (Command const & command : m_commands)
+        {
+            board.setPenColor(command.pen);
+            board.setFillColor(command.fill);
+            Coordinate const * const coordinates = m_coordinates.data() + command.first;
+            if (command.shape == Shape::Pixels)
+            {
+                for (std::uint32_t i = 0; i < command.count; ++i)
+                {
+                    // left, top, width, height.
+                    board.drawRectangle(coordinates[i].x - 0.5, coordinates[i].y + 0.5, 1., 1.);
+                }
+            }
+            else
+            {
+                polygon.clear();
+                for (std::uint32_t i = 0; i < command.count; ++i)
+                {
+                    polygon.emplace_back(coordinates[i].x, coordinates[i].y);
+                }
+                board.drawClosedPolyline(polygon);
+            }
+        }
+    }
+
+    inline DrawingBuffer::Bounds
+      DrawingBuffer::getBounds() const
+    {
+        Bounds bounds = {{0.f, 0.f}, {0.f, 0.f}};
+        bool   isSet  = false;
+        for (Command const & command : m_commands)
+        {
+            // Pixels stick out of their centres by half a pixel.
+            float const margin = command.shape == Shape::Pixels ? 0.5f : 0.f;
+            for (std::uint32_t i = command.first; i < command.first + command.count; ++i)
+            {
+                Coordinate const & c = m_coordinates[i];
+                if (!isSet)
+                {
+                    bounds = {{c.x - margin, c.y - margin}, {c.x + margin, c.y + margin}};
+                    isSet  = true;
+                }
+                bounds.lower.x = std::min(bounds.lower.x, c.x - margin);
+                bounds.lower.y = std::min(bounds.lower.y, c.y - margin);
+                bounds.upper.x = std::max(bounds.upper.x, c.x + margin);
+                bounds.upper.y = std::max(bounds.upper.y, c.y + margin);
+            }
+        }
+        return bounds;
+    }
+
+    inline std::vector<DrawingBuffer::Command> const &
+      DrawingBuffer::getCommands() const
+    {
+        return m_commands;
+    }
+
+    inline std::vector<DrawingBuffer::Coordinate> const &
+      DrawingBuffer::getCoordinates() const
+    {
+        return m_coordinates;
+    }
+
+    inline bool
+      DrawingBuffer::empty() const
+    {
+        return m_commands.empty();
+    }
+
+    inline DrawingBuffer::Colour
+      DrawingBuffer::getLabelColour(std::size_t label)
+    {
+        // HSV with full saturation and value.
+        double const hue    = std::fmod(static_cast<double>(label) * 137.50776405, 360.) / 60.;
+        double const x      = 1. - std::abs(std::fmod(hue, 2.) - 1.);
+        auto const   toByte = [](double c) { return static_cast<int>(std::lround(255. * c)); };
+        switch (static_cast<int>(hue))
+        {
+            case 0: return Colour(255, toByte(x), 0);
+            case 1: return Colour(toByte(x), 255, 0);
+            case 2: return Colour(0, 255, toByte(x));
+            case 3: return Colour(0, toByte(x), 255);
+            case 4: return Colour(toByte(x), 0, 255);
+            default: return Colour(255, 0, toByte(x));
+        }
+    }
+
+    inline void
+      DrawingBuffer::clear()
+    {
+        m_commands.clear();
+        m_coordinates.clear();
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_DRAWINGBUFFER_INL
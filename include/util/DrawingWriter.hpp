@@ -0,0 +1,135 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_DRAWINGWRITER_HPP
+#define TD_UTIL_DRAWINGWRITER_HPP
+
+#include <util/DrawingBuffer.hpp>
+
+#include <DGtal/io/boards/Board2D.h>
+
+#ifdef WITH_CAIRO
+#include <cairo/cairo.h>
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace td::util
+{
+    /// Pool of threads writing drawings to files, so that the analysis never waits for rendering.
+    /// Files are queued with the save methods, which return at once,
+    /// and are all written when wait() returns or the writer is destroyed.
+    /// PDF and PNG files need Cairo (WITH_CAIRO), the other formats are written by Board2D alone.
+    class DrawingWriter
+    {
+       public:
+        /** --------- methods ------------- **/
+        /// \param numberThreads 0 to use all hardware threads.
+        inline explicit DrawingWriter(unsigned int numberThreads = 1);
+        /// Writes the files left in the queue.
+        /// An error not rethrown by wait() is reported on the DGtal trace, it can't be thrown from here.
+        inline ~DrawingWriter();
+
+        DrawingWriter(DrawingWriter const &) = delete;
+        DrawingWriter &
+          operator=(DrawingWriter const &) = delete;
+
+        /// Renders a drawing through Board2D.
+        /// \param drawing
+        /// \param path the extension gives the format: .eps, .svg, .pdf or .png.
+        inline void
+          save(DrawingBuffer drawing, std::filesystem::path path);
+
+        /// Saves a board drawn directly, see save(DrawingBuffer, path).
+        /// The board is shared, so one board can be saved in several formats at once.
+        inline void
+          save(std::shared_ptr<DGtal::Board2D const> board, std::filesystem::path path);
+
+        /// One drawing per page of a PDF file, each scaled to fit its page. Needs Cairo.
+        /// \param drawings
+        /// \param path
+        inline void
+          saveDocument(std::vector<DrawingBuffer> drawings, std::filesystem::path path);
+
+        /// Drawings side by side on a grid, in a PNG (or PDF) file. Needs Cairo.
+        /// \param drawings
+        /// \param path
+        /// \param numberColumns
+        /// \param tileSize side of each tile, in pixels (or points).
+        inline void
+          saveOverview(std::vector<DrawingBuffer> drawings,
+                       std::filesystem::path      path,
+                       std::size_t                numberColumns,
+                       int                        tileSize = c_tileSize);
+
+        /// Blocks until the queue is empty.
+        /// Rethrows the first error of the writers, if any.
+        inline void
+          wait();
+
+       private:
+        /** --------- methods ------------- **/
+        inline void
+          push(std::function<void()> task);
+
+        inline void
+          work();
+
+        inline static void
+          saveBoard(DGtal::Board2D const & board, std::filesystem::path const & path);
+
+#ifdef WITH_CAIRO
+        /// Draws a buffer into a rectangle of a Cairo context, scaled to fit with a margin.
+        inline static void
+          render(cairo_t *             context,
+                 DrawingBuffer const & drawing,
+                 double                left,
+                 double                top,
+                 double                width,
+                 double                height,
+                 double                margin);
+
+        /// Destroys the surface, throws if it or the status is an error.
+        inline static void
+          checkStatus(cairo_surface_t *             surface,
+                      std::filesystem::path const & path,
+                      cairo_status_t                status = CAIRO_STATUS_SUCCESS);
+#else
+        /// Throws: the format needs Cairo.
+        [[noreturn]] inline static void
+          failWithoutCairo(std::filesystem::path const & path);
+#endif
+
+        /** --------- data ------------- **/
+        std::mutex                        m_mutex;
+        std::condition_variable           m_hasTask;
+        std::condition_variable           m_isIdle;
+        std::deque<std::function<void()>> m_tasks;
+        std::size_t                       m_numberBusy;
+        bool                              m_isStopping;
+        // First error of a writer, rethrown by wait().
+        std::exception_ptr       m_error;
+        std::vector<std::thread> m_threads;
+
+        // A4, in points.
+        static constexpr double c_pageWidth  = 595.;
+        static constexpr double c_pageHeight = 842.;
+        static constexpr double c_pageMargin = 20.;
+        static constexpr int    c_tileSize   = 256;
+        // Width of the pen, in pixels of the drawing.
+        static constexpr double c_lineWidth = 0.1;
+    };
+}  // namespace td::util
+
+#include "DrawingWriter.inl"
+
+#endif  // TD_UTIL_DRAWINGWRITER_HPP
@@ -0,0 +1,338 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_DRAWINGWRITER_INL
+#define TD_UTIL_DRAWINGWRITER_INL
+
+#include <DGtal/base/Exceptions.h>
+
+#ifdef WITH_CAIRO
+#include <cairo/cairo-pdf.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+namespace td::util
+{
+    inline DrawingWriter::DrawingWriter(unsigned int numberThreads)
+        : m_mutex(), m_hasTask(), m_isIdle(), m_tasks(), m_numberBusy(0), m_isStopping(false), m_error(), m_threads()
+    {
+        if (numberThreads == 0)
+        {
+            numberThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        m_threads.reserve(numberThreads);
+        for (unsigned int t = 0; t < numberThreads; ++t)
+        {
+            m_threads.emplace_back([this]() { work(); });
+        }
+    }
+
+    inline DrawingWriter::~DrawingWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopping = true;
+        }
+        m_hasTask.notify_all();
+        for (auto & thread : m_threads)
+        {
+            thread.join();
+        }
+        if (m_error)
+        {
+            try
+            {
+                std::rethrow_exception(m_error);
+            }
+            catch (std::exception const & error)
+            {
+                DGtal::trace.error() << "DrawingWriter: a file was not written: " << error.what() << std::endl;
+            }
+            catch (...)
+            {
+                DGtal::trace.error() << "DrawingWriter: a file was not written" << std::endl;
+            }
+        }
+    }
+
+    inline void
+      DrawingWriter::save(DrawingBuffer drawing, std::filesystem::path path)
+    {
+        push(
+          [drawing = std::move(drawing), path = std::move(path)]()
+          {
+              DGtal::Board2D board;
+              drawing.replay(board);
+              saveBoard(board, path);
+          });
+    }
+
+    inline void
+      DrawingWriter::save(std::shared_ptr<DGtal::Board2D const> board, std::filesystem::path path)
+    {
+        push([board = std::move(board), path = std::move(path)]() { saveBoard(*board, path); });
+    }
+
+    inline void
+      DrawingWriter::saveDocument(std::vector<DrawingBuffer> drawings, std::filesystem::path path)
+    {
+        push(
+          [drawings = std::move(drawings), path = std::move(path)]()
+          {
+#ifdef WITH_CAIRO
+              cairo_surface_t * surface = cairo_pdf_surface_create(path.c_str(), c_pageWidth, c_pageHeight);
+              cairo_t *         context = cairo_create(surface);
+              for (auto const & drawing : drawings)
+              {
+                  render(context, drawing, 0., 0., c_pageWidth, c_pageHeight, c_pageMargin);
+                  cairo_show_page(context);
+              }
+              cairo_destroy(context);
+              cairo_surface_finish(surface);
+              checkStatus(surface, path);
+#else
+              static_cast<void>(drawings);
+              failWithoutCairo(path);
+#endif
+          });
+    }
+
+    inline void
+      DrawingWriter::saveOverview(std::vector<DrawingBuffer> drawings,
+                                  std::filesystem::path      path,
+                                  std::size_t                numberColumns,
+                                  int                        tileSize)
+    {
+        ASSERT(numberColumns > 0);
+        push(
+          [drawings = std::move(drawings), path = std::move(path), numberColumns, tileSize]()
+          {
+#ifdef WITH_CAIRO
+              std::size_t const numberRows = (drawings.size() + numberColumns - 1) / numberColumns;
+              int const         width      = static_cast<int>(numberColumns) * tileSize;
+              int const         height     = static_cast<int>(std::max<std::size_t>(numberRows, 1)) * tileSize;
+              bool const        isPDF      = path.extension() == ".pdf";
+              cairo_surface_t * surface    = isPDF
+                                               ? cairo_pdf_surface_create(path.c_str(), width, height)
+                                               : cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+              cairo_t * context = cairo_create(surface);
+              cairo_set_source_rgb(context, 1., 1., 1.);
+              cairo_paint(context);
+              auto const margin = static_cast<double>(tileSize) / 32.;
+              for (std::size_t i = 0; i < drawings.size(); ++i)
+              {
+                  render(context,
+                         drawings[i],
+                         static_cast<double>((i % numberColumns) * static_cast<std::size_t>(tileSize)),
+                         static_cast<double>((i / numberColumns) * static_cast<std::size_t>(tileSize)),
+                         tileSize,
+                         tileSize,
+                         margin);
+              }
+              cairo_destroy(context);
+              cairo_status_t const status =
+                isPDF ? CAIRO_STATUS_SUCCESS : cairo_surface_write_to_png(surface, path.c_str());
+              cairo_surface_finish(surface);
+              checkStatus(surface, path, status);
+#else
+              static_cast<void>(drawings);
+              static_cast<void>(numberColumns);
+              static_cast<void>(tileSize);
+              failWithoutCairo(path);
+#endif
+          });
+    }
+
+    inline void
+      DrawingWriter::wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isIdle.wait(lock, [this]() { return m_tasks.empty() && m_numberBusy == 0; });
+        if (m_error)
+        {
+            std::exception_ptr error = m_error;
+            m_error                  = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    inline void
+      DrawingWriter::push(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_hasTask.notify_one();
+    }
+
+    inline void
+      DrawingWriter::work()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_hasTask.wait(lock, [this]() { return m_isStopping || !m_tasks.empty(); });
+            // The queue is emptied before stopping.
+            if (m_tasks.empty())
+            {
+                return;
+            }
+            std::function<void()> task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            ++m_numberBusy;
+            lock.unlock();
+            std::exception_ptr error;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !m_error)
+            {
+                m_error = error;
+            }
+            --m_numberBusy;
+            if (m_tasks.empty() && m_numberBusy == 0)
+            {
+                m_isIdle.notify_all();
+            }
+        }
+    }
+
+    inline void
+      DrawingWriter::saveBoard(DGtal::Board2D const & board, std::filesystem::path const & path)
+    {
+        std::filesystem::path const extension = path.extension();
+        if (extension == ".eps")
+        {
+            board.saveEPS(path.c_str());
+        }
+        else if (extension == ".svg")
+        {
+            board.saveSVG(path.c_str());
+        }
+        else if (extension == ".pdf")
+        {
+#ifdef WITH_CAIRO
+            board.saveCairo(path.c_str(), DGtal::Board2D::CairoPDF);
+#else
+            failWithoutCairo(path);
+#endif
+        }
+        else if (extension == ".png")
+        {
+#ifdef WITH_CAIRO
+            board.saveCairo(path.c_str(), DGtal::Board2D::CairoPNG);
+#else
+            failWithoutCairo(path);
+#endif
+        }
+        else
+        {
+            DGtal::trace.error() << "DrawingWriter: unknown format " << path << std::endl;
+            throw DGtal::IOException();
+        }
+    }
+
+#ifdef WITH_CAIRO
+    inline void
+      DrawingWriter::render(cairo_t *             context,
+                            DrawingBuffer const & drawing,
+                            double                left,
+                            double                top,
+                            double                width,
+                            double                height,
+                            double                margin)
+    {
+        if (drawing.empty())
+        {
+            return;
+        }
+        DrawingBuffer::Bounds const bounds = drawing.getBounds();
+        double const extentX = std::max(1., static_cast<double>(bounds.upper.x - bounds.lower.x));
+        double const extentY = std::max(1., static_cast<double>(bounds.upper.y - bounds.lower.y));
+        double const scale   = std::min((width - 2. * margin) / extentX, (height - 2. * margin) / extentY);
+        // Centred in the rectangle, y pointing up as on the board.
+        double const originX = left + (width - scale * extentX) / 2.;
+        double const originY = top + (height + scale * extentY) / 2.;
+        auto const   toX     = [&](float x) { return originX + scale * (static_cast<double>(x) - bounds.lower.x); };
+        auto const   toY     = [&](float y) { return originY - scale * (static_cast<double>(y) - bounds.lower.y); };
+        auto const   setColour = [context](DGtal::Color const & colour)
+        {
+            cairo_set_source_rgba(
+              context, colour.red() / 255., colour.green() / 255., colour.blue() / 255., colour.alpha() / 255.);
+        };
+
+        cairo_save(context);
+        cairo_set_line_width(context, std::max(0.5, c_lineWidth * scale));
+        cairo_set_line_join(context, CAIRO_LINE_JOIN_ROUND);
+        auto const & coordinates = drawing.getCoordinates();
+        for (auto const & command : drawing.getCommands())
+        {
+            // One path per command, filled and stroked at once.
+            cairo_new_path(context);
+            for (std::uint32_t i = command.first; i < command.first + command.count; ++i)
+            {
+                DrawingBuffer::Coordinate const & c = coordinates[i];
+                if (command.shape == DrawingBuffer::Shape::Pixels)
+                {
+                    cairo_rectangle(context, toX(c.x - 0.5f), toY(c.y + 0.5f), scale, scale);
+                }
+                else
+                {
+                    cairo_line_to(context, toX(c.x), toY(c.y));
+                }
+            }
+            if (command.shape == DrawingBuffer::Shape::Polygon)
+            {
+                cairo_close_path(context);
+            }
+            if (command.fill.alpha() != 0)
+            {
+                setColour(command.fill);
+                cairo_fill_preserve(context);
+            }
+            if (command.pen.alpha() != 0)
+            {
+                setColour(command.pen);
+                cairo_stroke_preserve(context);
+            }
+        }
+        cairo_new_path(context);
+        cairo_restore(context);
+    }
+
+    inline void
+      DrawingWriter::checkStatus(cairo_surface_t * surface, std::filesystem::path const & path, cairo_status_t status)
+    {
+        if (status == CAIRO_STATUS_SUCCESS)
+        {
+            status = cairo_surface_status(surface);
+        }
+        cairo_surface_destroy(surface);
+        if (status != CAIRO_STATUS_SUCCESS)
+        {
+            DGtal::trace.error() << "DrawingWriter: can't write " << path << ": " << cairo_status_to_string(status)
+                                 << std::endl;
+            throw DGtal::IOException();
+        }
+    }
+#else
+    inline void
+      DrawingWriter::failWithoutCairo(std::filesystem::path const & path)
+    {
+        DGtal::trace.error() << "DrawingWriter: can't write " << path << ", built without Cairo" << std::endl;
+        throw DGtal::IOException();
+    }
+#endif
+}  // namespace td::util
+
+#endif  // TD_UTIL_DRAWINGWRITER_INL
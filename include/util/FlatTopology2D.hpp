@@ -0,0 +1,150 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_FLATTOPOLOGY2D_HPP
+#define TD_UTIL_FLATTOPOLOGY2D_HPP
+
+#include <DGtal/helpers/StdDefs.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace td::util
+{
+    /// Whether a digital topology has a flat 2D implementation of tracking and labelling.
+    /// The generic DGtal path is used otherwise.
+    /// Define TD_UTIL_GENERIC_TOPOLOGY to always use the generic path.
+    /// \tparam dimension
+    /// \tparam Topology_T
+    template <int dimension, class Topology_T>
+    struct FlatTopologyTraits
+    {
+        static constexpr bool c_isSpecialised = false;
+    };
+
+#ifndef TD_UTIL_GENERIC_TOPOLOGY
+    template <>
+    struct FlatTopologyTraits<2, DGtal::Z2i::DT4_8>
+    {
+        static constexpr bool c_isSpecialised = true;
+        static constexpr int  c_foregroundAdjacency = 4;
+    };
+
+    template <>
+    struct FlatTopologyTraits<2, DGtal::Z2i::DT8_4>
+    {
+        static constexpr bool c_isSpecialised = true;
+        static constexpr int  c_foregroundAdjacency = 8;
+    };
+#endif
+
+    /// Flat coordinate pair.
+    struct FlatPoint2D
+    {
+        std::int32_t x;
+        std::int32_t y;
+    };
+
+    /// Binary raster of a set of 2D points, over its bounding box.
+    /// A one-pixel background frame surrounds the box,
+    /// so that neighbours can be read without bound checks.
+    class FlatMask2D
+    {
+       public:
+        /** --------- methods ------------- **/
+        /// \tparam PointRange range of points with operator[] (DGtal points, ...)
+        /// \param points
+        template <class PointRange>
+        inline explicit FlatMask2D(PointRange const & points);
+
+        /// \param lower lower bound of the box (without the frame)
+        /// \param upper upper bound of the box (without the frame)
+        inline FlatMask2D(FlatPoint2D lower, FlatPoint2D upper);
+
+        inline void
+          set(FlatPoint2D point);
+
+        [[nodiscard]] inline std::uint8_t
+          operator()(FlatPoint2D point) const;
+
+        /// Index of a point in the raster.
+        [[nodiscard]] inline std::int32_t
+          getIndex(FlatPoint2D point) const;
+        [[nodiscard]] inline FlatPoint2D
+          getPoint(std::int32_t index) const;
+
+        [[nodiscard]] inline std::int32_t
+          getWidth() const;
+        [[nodiscard]] inline std::int32_t
+          getHeight() const;
+        [[nodiscard]] inline std::uint8_t const *
+          getData() const;
+
+       private:
+        /** --------- data ------------- **/
+        // Point of the raster at index 0 (lower bound of the box minus the frame).
+        FlatPoint2D               m_origin;
+        std::int32_t              m_width;
+        std::int32_t              m_height;
+        std::vector<std::uint8_t> m_data;
+    };
+
+    /// Tracking and labelling on a flat raster,
+    /// with the neighbourhoods unrolled at compile time.
+    /// \tparam foregroundAdjacency 4 or 8, the background has the other one.
+    template <int foregroundAdjacency>
+    class FlatTopology2D
+    {
+       public:
+        // constraints
+        static_assert(foregroundAdjacency == 4 || foregroundAdjacency == 8);
+
+        /** --------- methods ------------- **/
+        /// Tracks the outer boundary of the connected set of the mask.
+        /// The boundary is followed counterclockwise along the cracks between pixels,
+        /// starting from the lowest, leftmost pixel.
+        /// \param mask must contain a single connected component.
+        /// \return pointels of the boundary, pointel (x, y) being the lower left corner of pixel (x, y).
+        [[nodiscard]] static std::vector<FlatPoint2D>
+          trackBoundary(FlatMask2D const & mask);
+
+        /// Same tracking, the pixels being read through a predicate instead of a raster,
+        /// for sets too large to be rasterised: only the pixels along the boundary are read.
+        /// \tparam Predicate (FlatPoint2D) -> bool
+        /// \param isInside must hold on a single connected component.
+        /// \param start lowest, leftmost pixel of the component.
+        /// \return pointels of the boundary, as above.
+        template <class Predicate>
+        [[nodiscard]] static std::vector<FlatPoint2D>
+          trackBoundary(Predicate const & isInside, FlatPoint2D start);
+
+        /// Labels the connected components of the mask.
+        /// \param mask
+        /// \return points of each component, components being ordered by their lowest, leftmost point.
+        [[nodiscard]] static std::vector<std::vector<FlatPoint2D>>
+          labelComponents(FlatMask2D const & mask);
+
+       private:
+        /** --------- data ------------- **/
+        // Directions along the cracks, counterclockwise: +x, +y, -x, -y.
+        static constexpr std::array<FlatPoint2D, 4> c_directions = {{{1, 0}, {0, 1}, {-1, 0}, {0, -1}}};
+        // Pixels ahead of a pointel, on the left and on the right of each direction.
+        static constexpr std::array<FlatPoint2D, 4> c_aheadLeft  = {{{0, 0}, {-1, 0}, {-1, -1}, {0, -1}}};
+        static constexpr std::array<FlatPoint2D, 4> c_aheadRight = {{{0, -1}, {0, 0}, {-1, 0}, {-1, -1}}};
+        // Turn to take (in quarter turns, counterclockwise),
+        // indexed by (ahead left is set) << 1 | (ahead right is set).
+        // Only the diagonal configuration (0b01) depends on the adjacency:
+        // 4-connected objects are split there, 8-connected ones are joined.
+        static constexpr std::array<std::int32_t, 4> c_turns = {1, foregroundAdjacency == 4 ? 1 : 3, 0, 3};
+        // Neighbours already visited by a raster scan (rows from bottom to top, left to right),
+        // the first two are the 4-neighbours.
+        static constexpr std::size_t c_numberPriorNeighbours = foregroundAdjacency == 4 ? 2 : 4;
+        static constexpr std::array<FlatPoint2D, 4> c_priorNeighbours = {{{-1, 0}, {0, -1}, {-1, -1}, {1, -1}}};
+    };
+}  // namespace td::util
+
+#include "FlatTopology2D.inl"
+
+#endif  // TD_UTIL_FLATTOPOLOGY2D_HPP
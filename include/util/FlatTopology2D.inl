@@ -0,0 +1,228 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_FLATTOPOLOGY2D_INL
+#define TD_UTIL_FLATTOPOLOGY2D_INL
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace td::util
+{
+    /** --------- FlatMask2D ------------- **/
+    template <class PointRange>
+    inline FlatMask2D::FlatMask2D(PointRange const & points)
+        : m_origin(), m_width(0), m_height(0), m_data()
+    {
+        // bounding box first.
+        FlatPoint2D lower = {std::numeric_limits<std::int32_t>::max(), std::numeric_limits<std::int32_t>::max()};
+        FlatPoint2D upper = {std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::min()};
+        for (auto const & point : points)
+        {
+            auto const x = static_cast<std::int32_t>(point[0]);
+            auto const y = static_cast<std::int32_t>(point[1]);
+            lower        = {std::min(lower.x, x), std::min(lower.y, y)};
+            upper        = {std::max(upper.x, x), std::max(upper.y, y)};
+        }
+        if (lower.x > upper.x)
+        {
+            // no points.
+            lower = upper = {0, 0};
+        }
+        *this = FlatMask2D(lower, upper);
+        for (auto const & point : points)
+        {
+            set({static_cast<std::int32_t>(point[0]), static_cast<std::int32_t>(point[1])});
+        }
+    }
+
+    inline FlatMask2D::FlatMask2D(FlatPoint2D lower, FlatPoint2D upper)
+        : m_origin({lower.x - 1, lower.y - 1}),
+          m_width(std::max(upper.x - lower.x + 3, 2)),
+          m_height(std::max(upper.y - lower.y + 3, 2)),
+          m_data(static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height), 0)
+    {}
+
+    inline void
+      FlatMask2D::set(FlatPoint2D point)
+    {
+        m_data[static_cast<std::size_t>(getIndex(point))] = 1;
+    }
+
+    inline std::uint8_t
+      FlatMask2D::operator()(FlatPoint2D point) const
+    {
+        return m_data[static_cast<std::size_t>(getIndex(point))];
+    }
+
+    inline std::int32_t
+      FlatMask2D::getIndex(FlatPoint2D point) const
+    {
+        return (point.y - m_origin.y) * m_width + (point.x - m_origin.x);
+    }
+
+    inline FlatPoint2D
+      FlatMask2D::getPoint(std::int32_t index) const
+    {
+        return {m_origin.x + index % m_width, m_origin.y + index / m_width};
+    }
+
+    inline std::int32_t
+      FlatMask2D::getWidth() const
+    {
+        return m_width;
+    }
+
+    inline std::int32_t
+      FlatMask2D::getHeight() const
+    {
+        return m_height;
+    }
+
+    inline std::uint8_t const *
+      FlatMask2D::getData() const
+    {
+        return m_data.data();
+    }
+
+    /** --------- FlatTopology2D ------------- **/
+    template <int foregroundAdjacency>
+    std::vector<FlatPoint2D>
+      FlatTopology2D<foregroundAdjacency>::trackBoundary(FlatMask2D const & mask)
+    {
+        std::uint8_t const * data  = mask.getData();
+        std::int32_t const   width = mask.getWidth();
+        std::int32_t const   size  = width * mask.getHeight();
+
+        // The lowest, leftmost pixel has its lower crack on the outer boundary.
+        std::int32_t const startIndex =
+          static_cast<std::int32_t>(std::find(data, data + size, std::uint8_t {1}) - data);
+        ASSERT(startIndex < size);
+
+        // offsets of the pixels ahead, in the raster.
+        std::array<std::int32_t, 4> aheadLeft {};
+        std::array<std::int32_t, 4> aheadRight {};
+        std::array<std::int32_t, 4> step {};
+        for (std::size_t d = 0; d < 4; ++d)
+        {
+            aheadLeft[d]  = c_aheadLeft[d].y * width + c_aheadLeft[d].x;
+            aheadRight[d] = c_aheadRight[d].y * width + c_aheadRight[d].x;
+            step[d]       = c_directions[d].y * width + c_directions[d].x;
+        }
+
+        // Pointels are tracked through the index of the pixel they are the lower left corner of.
+        std::vector<FlatPoint2D> pointels;
+        std::int32_t             index     = startIndex;
+        std::size_t              direction = 0;
+        do
+        {
+            pointels.push_back(mask.getPoint(index));
+            index += step[direction];
+            // No branching on the configuration, the turn is read from the table.
+            auto const configuration =
+              static_cast<std::size_t>((data[index + aheadLeft[direction]] << 1) | data[index + aheadRight[direction]]);
+            direction = (direction + static_cast<std::size_t>(c_turns[configuration])) & 3u;
+        } while (index != startIndex || direction != 0);
+
+        return pointels;
+    }
+
+    template <int foregroundAdjacency>
+    template <class Predicate>
+    std::vector<FlatPoint2D>
+      FlatTopology2D<foregroundAdjacency>::trackBoundary(Predicate const & isInside, FlatPoint2D start)
+    {
+        // The lower crack of the start pixel is on the outer boundary, as for the raster.
+        std::vector<FlatPoint2D> pointels;
+        FlatPoint2D              pointel   = start;
+        std::size_t              direction = 0;
+        do
+        {
+            pointels.push_back(pointel);
+            pointel = {pointel.x + c_directions[direction].x, pointel.y + c_directions[direction].y};
+            bool const isLeft =
+              isInside(FlatPoint2D {pointel.x + c_aheadLeft[direction].x, pointel.y + c_aheadLeft[direction].y});
+            bool const isRight =
+              isInside(FlatPoint2D {pointel.x + c_aheadRight[direction].x, pointel.y + c_aheadRight[direction].y});
+            auto const configuration = static_cast<std::size_t>((isLeft ? 2 : 0) | (isRight ? 1 : 0));
+            direction                = (direction + static_cast<std::size_t>(c_turns[configuration])) & 3u;
+        } while (pointel.x != start.x || pointel.y != start.y || direction != 0);
+
+        return pointels;
+    }
+
+    template <int foregroundAdjacency>
+    std::vector<std::vector<FlatPoint2D>>
+      FlatTopology2D<foregroundAdjacency>::labelComponents(FlatMask2D const & mask)
+    {
+        std::uint8_t const * data  = mask.getData();
+        std::int32_t const   width = mask.getWidth();
+        std::int32_t const   size  = width * mask.getHeight();
+
+        std::array<std::int32_t, c_numberPriorNeighbours> offsets {};
+        for (std::size_t i = 0; i < c_numberPriorNeighbours; ++i)
+        {
+            offsets[i] = c_priorNeighbours[i].y * width + c_priorNeighbours[i].x;
+        }
+
+        // union-find over the pixels, each pixel is its own parent at first.
+        // The frame is background, so the neighbours are always in the raster.
+        std::vector<std::int32_t> parents(static_cast<std::size_t>(size));
+        std::iota(parents.begin(), parents.end(), 0);
+        auto const findRoot = [&parents](std::int32_t i) -> std::int32_t
+        {
+            while (parents[static_cast<std::size_t>(i)] != i)
+            {
+                // path halving.
+                parents[static_cast<std::size_t>(i)] =
+                  parents[static_cast<std::size_t>(parents[static_cast<std::size_t>(i)])];
+                i = parents[static_cast<std::size_t>(i)];
+            }
+            return i;
+        };
+
+        // first pass: merge each pixel with its already visited neighbours.
+        for (std::int32_t i = width; i < size - width; ++i)
+        {
+            if (data[i] == 0)
+            {
+                continue;
+            }
+            for (std::size_t k = 0; k < c_numberPriorNeighbours; ++k)
+            {
+                std::int32_t const j = i + offsets[k];
+                if (data[j] != 0)
+                {
+                    // the smallest root wins, so that roots are the first pixels of their component.
+                    std::int32_t const rootI = findRoot(i);
+                    std::int32_t const rootJ = findRoot(j);
+                    parents[static_cast<std::size_t>(std::max(rootI, rootJ))] = std::min(rootI, rootJ);
+                }
+            }
+        }
+
+        // second pass: gather the points, components in order of their root.
+        std::vector<std::vector<FlatPoint2D>> components;
+        std::vector<std::int32_t>             componentOfRoot(static_cast<std::size_t>(size), -1);
+        for (std::int32_t i = width; i < size - width; ++i)
+        {
+            if (data[i] == 0)
+            {
+                continue;
+            }
+            std::int32_t const root = findRoot(i);
+            std::int32_t &     id   = componentOfRoot[static_cast<std::size_t>(root)];
+            if (id < 0)
+            {
+                id = static_cast<std::int32_t>(components.size());
+                components.emplace_back();
+            }
+            components[static_cast<std::size_t>(id)].push_back(mask.getPoint(i));
+        }
+        return components;
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_FLATTOPOLOGY2D_INL
@@ -0,0 +1,166 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_GRAINFIELDGENERATOR_HPP
+#define TD_UTIL_GRAINFIELDGENERATOR_HPP
+
+#include <util/ImplicitShapes2D.hpp>
+#include <util/common.hpp>
+#include <util/ScanlineDigitizer.hpp>
+
+#include <DGtal/helpers/StdDefs.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+namespace td::util
+{
+    /// Binary masks of grains, in the manner of the rice images of TD2, of any size.
+    /// The grains are discs and squares (as in TD1), ellipses and rotated rectangles,
+    /// placed at random without overlapping, unless they are asked to touch.
+    /// The same parameters and seed give the same mask with the same platform and toolchain:
+    /// the random numbers are drawn from the engine directly, not through the standard distributions,
+    /// but the radii, positions and digitisations go through std::exp, std::log, std::cos and std::sin,
+    /// whose last bit may differ between standard libraries and flip a pixel on the border of a grain.
+    /// The mask is produced band by band from the top row down, it never needs to fit in memory.
+    class GrainFieldGenerator
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef DGtal::Z2i::Space     Space;
+        typedef DGtal::Z2i::Domain    Domain;
+        typedef DGtal::Z2i::Integer   Integer;
+        typedef DGtal::Z2i::Point     Point;
+        typedef DGtal::Z2i::RealPoint RealPoint;
+        typedef DigitalSpans<Space>   Spans;
+        typedef std::uint8_t          Value;
+
+        enum class Shape
+        {
+            Disc,
+            Square,
+            Ellipse,
+            Rectangle
+        };
+        static constexpr std::size_t c_numberShapes = 4;
+
+        struct Grain
+        {
+            Shape     shape;
+            RealPoint centre;
+            // Half of the length of the grain, along its own axis.
+            double radius;
+            // Length over width, 1 for discs and squares.
+            double elongation;
+            // Of the length with the first axis, counterclockwise. Squares are not rotated.
+            double angle;
+        };
+
+        struct Parameters
+        {
+            Integer     width        = 1024;
+            Integer     height       = 1024;
+            std::size_t numberGrains = 500;
+            // Radii follow a log-normal law of median meanRadius and shape radiusSpread,
+            // clamped to [minimumRadius, maximumRadius].
+            double meanRadius    = 8.;
+            double radiusSpread  = 0.25;
+            double minimumRadius = 2.;
+            double maximumRadius = 24.;
+            // Elongations are uniform in [1, maximumElongation].
+            double maximumElongation = 2.5;
+            // Relative frequencies of the shapes, in the order of Shape.
+            std::array<double, c_numberShapes> shapeWeights = {1., 1., 1., 1.};
+            // Smallest distance between the bounding circles of two grains.
+            // From 1.5 up, grains are separate components whatever the adjacency.
+            double gap = 2.;
+            // Fraction of the grains set against an earlier one, their bounding circles tangent.
+            // They may then form a single component, as the clumps of the rice images.
+            // Their bounding circles reach into the mask, as for the grains of the rim.
+            double touchingFraction = 0.;
+            // Fraction of the grains centred on the rim of the mask, so that they are cut.
+            double rimFraction = 0.02;
+            // Probability for each pixel to be flipped (salt and pepper).
+            double        noise = 0.;
+            std::uint64_t seed  = 0;
+        };
+
+        /** --------- methods ------------- **/
+        /// Places the grains, the mask is only digitised when written.
+        /// Grains that can't be placed after a few tries are dropped,
+        /// so a crowded mask has fewer grains than asked for.
+        inline explicit GrainFieldGenerator(Parameters parameters);
+
+        [[nodiscard]] inline std::vector<Grain> const &
+          getGrains() const;
+        [[nodiscard]] inline Parameters const &
+          getParameters() const;
+        [[nodiscard]] inline Domain
+          getDomain() const;
+
+        /// Calls function(row, data) for each row, from the top one (height - 1) down,
+        /// data holding the width values of the row (0 or 255).
+        /// Only the grains crossing the current band of rows are digitised.
+        /// \tparam RowFunction
+        /// \param function
+        template <class RowFunction>
+        void
+          forEachRow(RowFunction const & function) const;
+
+        /// Streams the mask to a binary PGM file,
+        /// top row first, as read by DGtal's PGMReader.
+        inline void
+          writePGM(std::filesystem::path const & path) const;
+
+        /// Whole mask in memory.
+        /// \tparam Image_T DGtal image over a 2D domain.
+        template <class Image_T>
+        [[nodiscard]] Image_T
+          createImage() const;
+
+        /// Radius of the smallest centred circle enclosing the grain.
+        [[nodiscard]] inline static double
+          getBoundingRadius(Grain const & grain);
+
+        /// Gauss digitisation of a grain, with the scanline digitiser.
+        [[nodiscard]] inline static Spans
+          digitizeGrain(Grain const & grain);
+
+       private:
+        /** --------- typedefs ------------- **/
+        // Specified by the standard, unlike the distributions.
+        typedef std::mt19937_64 Engine;
+
+        /** --------- methods ------------- **/
+        inline void
+          placeGrains();
+
+        template <class Shape_T>
+        [[nodiscard]] static Spans
+          digitizeShape(Shape_T const & shape);
+
+        /// Uniform in [0, 1).
+        [[nodiscard]] inline static double
+          drawUniform(Engine & engine);
+        /// Standard normal, by Box-Muller.
+        [[nodiscard]] inline static double
+          drawNormal(Engine & engine);
+
+        /** --------- data ------------- **/
+        Parameters         m_parameters;
+        std::vector<Grain> m_grains;
+
+        // Rows digitised at once.
+        static constexpr Integer c_bandHeight = 64;
+        // Positions tried for a grain before dropping it.
+        static constexpr int c_maximumTries = 32;
+    };
+}  // namespace td::util
+
+#include "GrainFieldGenerator.inl"
+
+#endif  // TD_UTIL_GRAINFIELDGENERATOR_HPP
@@ -0,0 +1,338 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_GRAINFIELDGENERATOR_INL
+#define TD_UTIL_GRAINFIELDGENERATOR_INL
+
+#include <DGtal/base/Common.h>
+#include <DGtal/base/Exceptions.h>
+#include <DGtal/shapes/GaussDigitizer.h>
+#include <DGtal/shapes/ShapeFactory.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+
+namespace td::util
+{
+    inline GrainFieldGenerator::GrainFieldGenerator(Parameters parameters)
+        : m_parameters(std::move(parameters)), m_grains()
+    {
+        ASSERT(m_parameters.width > 0 && m_parameters.height > 0);
+        ASSERT(m_parameters.minimumRadius > 0. && m_parameters.minimumRadius <= m_parameters.maximumRadius);
+        ASSERT(m_parameters.maximumElongation >= 1.);
+        placeGrains();
+    }
+
+    inline std::vector<GrainFieldGenerator::Grain> const &
+      GrainFieldGenerator::getGrains() const
+    {
+        return m_grains;
+    }
+
+    inline GrainFieldGenerator::Parameters const &
+      GrainFieldGenerator::getParameters() const
+    {
+        return m_parameters;
+    }
+
+    inline GrainFieldGenerator::Domain
+      GrainFieldGenerator::getDomain() const
+    {
+        return Domain(Point(0, 0), Point(m_parameters.width - 1, m_parameters.height - 1));
+    }
+
+    inline void
+      GrainFieldGenerator::placeGrains()
+    {
+        Parameters const & p = m_parameters;
+        Engine             engine(p.seed);
+
+        // Uniform grid over the centres, with cells large enough that
+        // a grain can only collide with the grains of the 3x3 cells around it.
+        double const    cellSize     = 2. * p.maximumRadius * std::sqrt(2.) + std::max(p.gap, 0.);
+        auto const      toCell       = [cellSize](double x, Integer count)
+        { return std::clamp(static_cast<Integer>(std::floor(x / cellSize)), Integer {0}, count - 1); };
+        Integer const   numberColumns = static_cast<Integer>(std::ceil(p.width / cellSize)) + 1;
+        Integer const   numberRows    = static_cast<Integer>(std::ceil(p.height / cellSize)) + 1;
+        // Grains of each cell, as linked lists.
+        std::vector<std::int64_t> cellHeads(static_cast<std::size_t>(numberColumns * numberRows), -1);
+        std::vector<std::int64_t> next;
+        std::vector<double>       boundingRadii;
+
+        double const totalWeight = std::accumulate(p.shapeWeights.begin(), p.shapeWeights.end(), 0.);
+        ASSERT(totalWeight > 0.);
+
+        m_grains.clear();
+        m_grains.reserve(p.numberGrains);
+        next.reserve(p.numberGrains);
+        boundingRadii.reserve(p.numberGrains);
+        for (std::size_t i = 0; i < p.numberGrains; ++i)
+        {
+            // The grain itself is drawn once, only its position is tried again.
+            Grain  grain {};
+            double weight = drawUniform(engine) * totalWeight;
+            std::size_t shape = 0;
+            while (shape + 1 < c_numberShapes && weight >= p.shapeWeights[shape])
+            {
+                weight -= p.shapeWeights[shape];
+                ++shape;
+            }
+            grain.shape  = static_cast<Shape>(shape);
+            grain.radius = std::clamp(p.meanRadius * std::exp(p.radiusSpread * drawNormal(engine)),
+                                      p.minimumRadius,
+                                      p.maximumRadius);
+            bool const isElongated = grain.shape == Shape::Ellipse || grain.shape == Shape::Rectangle;
+            grain.elongation = isElongated ? 1. + (p.maximumElongation - 1.) * drawUniform(engine) : 1.;
+            grain.angle      = grain.shape == Shape::Square ? 0. : drawUniform(engine) * maths<double>::pi();
+            double const radius     = getBoundingRadius(grain);
+            bool const   isTouching = !m_grains.empty() && drawUniform(engine) < p.touchingFraction;
+            bool const   isOnRim    = !isTouching && drawUniform(engine) < p.rimFraction;
+            double const gap        = isTouching ? 0. : p.gap;
+
+            bool isPlaced = false;
+            for (int t = 0; t < c_maximumTries && !isPlaced; ++t)
+            {
+                double x = drawUniform(engine) * (p.width - 1);
+                double y = drawUniform(engine) * (p.height - 1);
+                if (isTouching)
+                {
+                    auto const   j     = std::min(static_cast<std::size_t>(drawUniform(engine) * m_grains.size()),
+                                            m_grains.size() - 1);
+                    double const theta = drawUniform(engine) * 2. * maths<double>::pi();
+                    x = m_grains[j].centre[0] + (boundingRadii[j] + radius) * std::cos(theta);
+                    y = m_grains[j].centre[1] + (boundingRadii[j] + radius) * std::sin(theta);
+                    // Against a grain of the rim, it may be entirely out of the mask: tried again.
+                    if (x < -radius || x > p.width - 1 + radius || y < -radius || y > p.height - 1 + radius)
+                    {
+                        continue;
+                    }
+                }
+                else if (isOnRim)
+                {
+                    // across the rim by up to half the radius, either way.
+                    double const across = (drawUniform(engine) - 0.5) * radius;
+                    switch (static_cast<int>(drawUniform(engine) * 4.))
+                    {
+                    case 0: x = across; break;
+                    case 1: x = p.width - 1 + across; break;
+                    case 2: y = across; break;
+                    default: y = p.height - 1 + across; break;
+                    }
+                }
+                Integer const column = toCell(x, numberColumns);
+                Integer const row    = toCell(y, numberRows);
+                bool          isFree = true;
+                for (Integer v = std::max(row - 1, Integer {0}); isFree && v <= std::min(row + 1, numberRows - 1); ++v)
+                {
+                    for (Integer u = std::max(column - 1, Integer {0});
+                         isFree && u <= std::min(column + 1, numberColumns - 1);
+                         ++u)
+                    {
+                        for (std::int64_t k = cellHeads[static_cast<std::size_t>(v * numberColumns + u)]; k >= 0;
+                             k              = next[static_cast<std::size_t>(k)])
+                        {
+                            Grain const & other    = m_grains[static_cast<std::size_t>(k)];
+                            double const  dx       = other.centre[0] - x;
+                            double const  dy       = other.centre[1] - y;
+                            double const  distance = radius + boundingRadii[static_cast<std::size_t>(k)] + gap;
+                            // Tangent circles are not colliding, whatever the rounding.
+                            if (dx * dx + dy * dy < distance * distance - 1e-6)
+                            {
+                                isFree = false;
+                                break;
+                            }
+                        }
+                    }
+                }
+                if (isFree)
+                {
+                    grain.centre = RealPoint(x, y);
+                    auto & head  = cellHeads[static_cast<std::size_t>(row * numberColumns + column)];
+                    next.push_back(head);
+                    head = static_cast<std::int64_t>(m_grains.size());
+                    boundingRadii.push_back(radius);
+                    m_grains.push_back(grain);
+                    isPlaced = true;
+                }
+            }
+        }
+    }
+
+    inline double
+      GrainFieldGenerator::getBoundingRadius(Grain const & grain)
+    {
+        switch (grain.shape)
+        {
+        case Shape::Square: return grain.radius * std::sqrt(2.);
+        case Shape::Rectangle: return grain.radius * std::sqrt(1. + 1. / (grain.elongation * grain.elongation));
+        default: return grain.radius;
+        }
+    }
+
+    inline GrainFieldGenerator::Spans
+      GrainFieldGenerator::digitizeGrain(Grain const & grain)
+    {
+        switch (grain.shape)
+        {
+        case Shape::Disc: return digitizeShape(DGtal::ImplicitBall<Space>(grain.centre, grain.radius));
+        case Shape::Square: return digitizeShape(DGtal::ImplicitHyperCube<Space>(grain.centre, grain.radius));
+        case Shape::Ellipse:
+            return digitizeShape(
+              ImplicitEllipse<Space>(grain.centre, grain.radius, grain.radius / grain.elongation, grain.angle));
+        case Shape::Rectangle:
+            return digitizeShape(
+              ImplicitRotatedRectangle<Space>(grain.centre, grain.radius, grain.radius / grain.elongation, grain.angle));
+        }
+        return Spans(Domain());
+    }
+
+    template <class Shape_T>
+    GrainFieldGenerator::Spans
+      GrainFieldGenerator::digitizeShape(Shape_T const & shape)
+    {
+        // Unit grid step: the mask is the Gauss digitisation of the grains, as in TD1.
+        DGtal::GaussDigitizer<Space, Shape_T> dig;
+        dig.attach(shape);
+        dig.init(shape.getLowerBound(), shape.getUpperBound(), 1.);
+        return ScanlineDigitizer<Space>::digitize(shape, dig);
+    }
+
+    template <class RowFunction>
+    void
+      GrainFieldGenerator::forEachRow(RowFunction const & function) const
+    {
+        Parameters const & p     = m_parameters;
+        auto const         width = static_cast<std::size_t>(p.width);
+
+        // Grains from the top down, by the highest row they may reach.
+        std::vector<std::size_t> order(m_grains.size());
+        std::vector<Integer>     tops(m_grains.size());
+        for (std::size_t i = 0; i < m_grains.size(); ++i)
+        {
+            order[i] = i;
+            tops[i]  = static_cast<Integer>(std::ceil(m_grains[i].centre[1] + getBoundingRadius(m_grains[i])));
+        }
+        std::sort(order.begin(), order.end(), [&tops](std::size_t i, std::size_t j) { return tops[i] > tops[j]; });
+
+        // The noise goes through the mask in the order of the rows, skipping to the next flipped pixel.
+        Engine       engine(p.seed ^ 0x9e3779b97f4a7c15ull);
+        double const logKeep    = p.noise > 0. ? std::log1p(-std::min(p.noise, 1. - 1e-12)) : 0.;
+        auto const   drawSkip   = [&engine, logKeep]() -> std::uint64_t
+        {
+            double const skip = std::floor(std::log1p(-drawUniform(engine)) / logKeep);
+            return skip < 1e18 ? static_cast<std::uint64_t>(skip) : std::uint64_t {1} << 62;
+        };
+        std::uint64_t nextFlip = p.noise > 0. ? drawSkip() : ~std::uint64_t {0};
+
+        std::vector<Spans>  active;
+        std::vector<Value>  band(width * static_cast<std::size_t>(c_bandHeight));
+        std::size_t         nextGrain = 0;
+        for (Integer bandTop = p.height - 1; bandTop >= 0; bandTop -= c_bandHeight)
+        {
+            Integer const bandBottom = std::max(bandTop - c_bandHeight + 1, Integer {0});
+            while (nextGrain < order.size() && tops[order[nextGrain]] >= bandBottom)
+            {
+                active.push_back(digitizeGrain(m_grains[order[nextGrain]]));
+                ++nextGrain;
+            }
+
+            std::fill(band.begin(), band.end(), Value {0});
+            for (auto const & spans : active)
+            {
+                Integer const first = std::min(bandTop, spans.domain().upperBound()[1]);
+                Integer const last  = std::max(bandBottom, spans.domain().lowerBound()[1]);
+                for (Integer row = first; row >= last; --row)
+                {
+                    Value * const data         = band.data() + static_cast<std::size_t>(bandTop - row) * width;
+                    auto const [begin, end] = spans.getRow(row);
+                    for (auto span = begin; span != end; ++span)
+                    {
+                        Integer const x0 = std::max(span->begin, Integer {0});
+                        Integer const x1 = std::min(span->end, p.width);
+                        if (x0 < x1)
+                        {
+                            std::fill(data + x0, data + x1, Value {255});
+                        }
+                    }
+                }
+            }
+            // Grains entirely above the next band are done.
+            active.erase(std::remove_if(active.begin(),
+                                        active.end(),
+                                        [bandBottom](Spans const & spans)
+                                        { return spans.domain().lowerBound()[1] >= bandBottom; }),
+                         active.end());
+
+            auto const size = static_cast<std::uint64_t>(bandTop - bandBottom + 1) * width;
+            while (nextFlip < size)
+            {
+                band[nextFlip] = static_cast<Value>(255 - band[nextFlip]);
+                nextFlip += 1 + drawSkip();
+            }
+            if (nextFlip != ~std::uint64_t {0})
+            {
+                nextFlip -= size;
+            }
+            for (Integer row = bandTop; row >= bandBottom; --row)
+            {
+                function(row, band.data() + static_cast<std::size_t>(bandTop - row) * width);
+            }
+        }
+    }
+
+    inline void
+      GrainFieldGenerator::writePGM(std::filesystem::path const & path) const
+    {
+        std::ofstream os(path, std::ios::binary);
+        if (!os)
+        {
+            DGtal::trace.error() << "GrainFieldGenerator: can't open " << path << std::endl;
+            throw DGtal::IOException();
+        }
+        os << "P5\n# " << m_grains.size() << " grains, seed " << m_parameters.seed << "\n"
+           << m_parameters.width << " " << m_parameters.height << "\n255\n";
+        forEachRow([&os, this](Integer, Value const * data)
+                   { os.write(reinterpret_cast<char const *>(data), static_cast<std::streamsize>(m_parameters.width)); });
+        if (!os)
+        {
+            DGtal::trace.error() << "GrainFieldGenerator: can't write " << path << std::endl;
+            throw DGtal::IOException();
+        }
+    }
+
+    template <class Image_T>
+    Image_T
+      GrainFieldGenerator::createImage() const
+    {
+        Image_T image(getDomain());
+        forEachRow(
+          [&image, this](Integer row, Value const * data)
+          {
+              for (Integer x = 0; x < m_parameters.width; ++x)
+              {
+                  image.setValue(Point(x, row), static_cast<typename Image_T::Value>(data[x]));
+              }
+          });
+        return image;
+    }
+
+    inline double
+      GrainFieldGenerator::drawUniform(Engine & engine)
+    {
+        // the 53 high bits, as a double.
+        return static_cast<double>(engine() >> 11) * 0x1.0p-53;
+    }
+
+    inline double
+      GrainFieldGenerator::drawNormal(Engine & engine)
+    {
+        double const u = 1. - drawUniform(engine);
+        double const v = drawUniform(engine);
+        return std::sqrt(-2. * std::log(u)) * std::cos(2. * maths<double>::pi() * v);
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_GRAINFIELDGENERATOR_INL
@@ -0,0 +1,146 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_IMPLICITSHAPES2D_HPP
+#define TD_UTIL_IMPLICITSHAPES2D_HPP
+
+#include <util/ScanlineDigitizer.hpp>
+
+#include <DGtal/helpers/StdDefs.h>
+#include <DGtal/shapes/ShapeFactory.h>
+
+#include <optional>
+#include <utility>
+
+namespace td::util
+{
+    /// Ellipse of any orientation, in the manner of DGtal's ImplicitBall.
+    /// Model of DGtal's Euclidean oriented shape, so it can be given to the Gauss digitiser.
+    /// \tparam Space_T
+    template <class Space_T>
+    class ImplicitEllipse
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef Space_T                   Space;
+        typedef typename Space::Integer   Integer;
+        typedef typename Space::Point     Point;
+        typedef typename Space::RealPoint RealPoint;
+        typedef double                    Value;
+
+        // constraints
+        static_assert(Space::dimension == 2);
+
+        /** --------- methods ------------- **/
+        /// \param centre
+        /// \param semiMajorAxis
+        /// \param semiMinorAxis
+        /// \param angle of the major axis with the first axis, counterclockwise.
+        inline ImplicitEllipse(RealPoint const & centre, double semiMajorAxis, double semiMinorAxis, double angle);
+
+        /// Negative inside, 0 on the ellipse, positive outside.
+        [[nodiscard]] inline Value
+          operator()(RealPoint const & point) const;
+        [[nodiscard]] inline bool
+          isInside(RealPoint const & point) const;
+        [[nodiscard]] inline DGtal::Orientation
+          orientation(RealPoint const & point) const;
+
+        [[nodiscard]] inline RealPoint
+          getLowerBound() const;
+        [[nodiscard]] inline RealPoint
+          getUpperBound() const;
+
+        /// \return the real interval [a, b] of the ellipse at ordinate y, if any.
+        [[nodiscard]] inline std::optional<std::pair<double, double>>
+          computeRowInterval(double y) const;
+
+       private:
+        /** --------- data ------------- **/
+        RealPoint m_centre;
+        double    m_semiMajorAxis;
+        double    m_semiMinorAxis;
+        double    m_cos;
+        double    m_sin;
+    };
+
+    /// Rectangle of any orientation, ImplicitHyperCube being the axis-aligned square.
+    /// Model of DGtal's Euclidean oriented shape.
+    /// \tparam Space_T
+    template <class Space_T>
+    class ImplicitRotatedRectangle
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef Space_T                   Space;
+        typedef typename Space::Integer   Integer;
+        typedef typename Space::Point     Point;
+        typedef typename Space::RealPoint RealPoint;
+        typedef double                    Value;
+
+        // constraints
+        static_assert(Space::dimension == 2);
+
+        /** --------- methods ------------- **/
+        /// \param centre
+        /// \param halfLength half of the side along the direction of the angle.
+        /// \param halfWidth half of the other side.
+        /// \param angle counterclockwise.
+        inline ImplicitRotatedRectangle(RealPoint const & centre, double halfLength, double halfWidth, double angle);
+
+        /// Negative inside, 0 on the rectangle, positive outside.
+        [[nodiscard]] inline Value
+          operator()(RealPoint const & point) const;
+        [[nodiscard]] inline bool
+          isInside(RealPoint const & point) const;
+        [[nodiscard]] inline DGtal::Orientation
+          orientation(RealPoint const & point) const;
+
+        [[nodiscard]] inline RealPoint
+          getLowerBound() const;
+        [[nodiscard]] inline RealPoint
+          getUpperBound() const;
+
+        /// \return the real interval [a, b] of the rectangle at ordinate y, if any.
+        [[nodiscard]] inline std::optional<std::pair<double, double>>
+          computeRowInterval(double y) const;
+
+       private:
+        /** --------- data ------------- **/
+        RealPoint m_centre;
+        double    m_halfLength;
+        double    m_halfWidth;
+        double    m_cos;
+        double    m_sin;
+    };
+
+    // Both have a closed-form intersection with a row, for the scanline digitiser.
+    template <class Space_T>
+    struct RowIntervalTraits<ImplicitEllipse<Space_T>>
+    {
+        static constexpr bool c_isClosedForm = true;
+
+        [[nodiscard]] inline static std::optional<std::pair<double, double>>
+          computeInterval(ImplicitEllipse<Space_T> const & shape, double y)
+        {
+            return shape.computeRowInterval(y);
+        }
+    };
+
+    template <class Space_T>
+    struct RowIntervalTraits<ImplicitRotatedRectangle<Space_T>>
+    {
+        static constexpr bool c_isClosedForm = true;
+
+        [[nodiscard]] inline static std::optional<std::pair<double, double>>
+          computeInterval(ImplicitRotatedRectangle<Space_T> const & shape, double y)
+        {
+            return shape.computeRowInterval(y);
+        }
+    };
+}  // namespace td::util
+
+#include "ImplicitShapes2D.inl"
+
+#endif  // TD_UTIL_IMPLICITSHAPES2D_HPP
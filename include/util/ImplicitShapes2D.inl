@@ -0,0 +1,180 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_IMPLICITSHAPES2D_INL
+#define TD_UTIL_IMPLICITSHAPES2D_INL
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace td::util
+{
+    /** --------- ImplicitEllipse ------------- **/
+    template <class Space_T>
+    inline ImplicitEllipse<Space_T>::ImplicitEllipse(RealPoint const & centre,
+                                                     double            semiMajorAxis,
+                                                     double            semiMinorAxis,
+                                                     double            angle)
+        : m_centre(centre),
+          m_semiMajorAxis(semiMajorAxis),
+          m_semiMinorAxis(semiMinorAxis),
+          m_cos(std::cos(angle)),
+          m_sin(std::sin(angle))
+    {
+        ASSERT(semiMajorAxis > 0. && semiMinorAxis > 0.);
+    }
+
+    template <class Space_T>
+    inline typename ImplicitEllipse<Space_T>::Value
+      ImplicitEllipse<Space_T>::operator()(RealPoint const & point) const
+    {
+        // coordinates along the axes.
+        double const dx = point[0] - m_centre[0];
+        double const dy = point[1] - m_centre[1];
+        double const u  = (m_cos * dx + m_sin * dy) / m_semiMajorAxis;
+        double const v  = (m_cos * dy - m_sin * dx) / m_semiMinorAxis;
+        return u * u + v * v - 1.;
+    }
+
+    template <class Space_T>
+    inline bool
+      ImplicitEllipse<Space_T>::isInside(RealPoint const & point) const
+    {
+        return (*this)(point) < 0.;
+    }
+
+    template <class Space_T>
+    inline DGtal::Orientation
+      ImplicitEllipse<Space_T>::orientation(RealPoint const & point) const
+    {
+        Value const value = (*this)(point);
+        return value < 0. ? DGtal::INSIDE : (value > 0. ? DGtal::OUTSIDE : DGtal::ON);
+    }
+
+    template <class Space_T>
+    inline typename ImplicitEllipse<Space_T>::RealPoint
+      ImplicitEllipse<Space_T>::getLowerBound() const
+    {
+        double const a = m_semiMajorAxis;
+        double const b = m_semiMinorAxis;
+        return m_centre
+               - RealPoint(std::sqrt(a * a * m_cos * m_cos + b * b * m_sin * m_sin),
+                           std::sqrt(a * a * m_sin * m_sin + b * b * m_cos * m_cos));
+    }
+
+    template <class Space_T>
+    inline typename ImplicitEllipse<Space_T>::RealPoint
+      ImplicitEllipse<Space_T>::getUpperBound() const
+    {
+        return m_centre + (m_centre - getLowerBound());
+    }
+
+    template <class Space_T>
+    inline std::optional<std::pair<double, double>>
+      ImplicitEllipse<Space_T>::computeRowInterval(double y) const
+    {
+        // Roots in dx of (u / a)^2 + (v / b)^2 = 1 at dy = y - centre.
+        double const dy = y - m_centre[1];
+        double const a2 = m_semiMajorAxis * m_semiMajorAxis;
+        double const b2 = m_semiMinorAxis * m_semiMinorAxis;
+        double const qa = m_cos * m_cos / a2 + m_sin * m_sin / b2;
+        double const qb = 2. * dy * m_cos * m_sin * (1. / a2 - 1. / b2);
+        double const qc = dy * dy * (m_sin * m_sin / a2 + m_cos * m_cos / b2) - 1.;
+        double const discriminant = qb * qb - 4. * qa * qc;
+        if (discriminant < 0.)
+        {
+            return std::nullopt;
+        }
+        double const root = std::sqrt(discriminant);
+        return std::make_pair(m_centre[0] + (-qb - root) / (2. * qa), m_centre[0] + (-qb + root) / (2. * qa));
+    }
+
+    /** --------- ImplicitRotatedRectangle ------------- **/
+    template <class Space_T>
+    inline ImplicitRotatedRectangle<Space_T>::ImplicitRotatedRectangle(RealPoint const & centre,
+                                                                       double            halfLength,
+                                                                       double            halfWidth,
+                                                                       double            angle)
+        : m_centre(centre),
+          m_halfLength(halfLength),
+          m_halfWidth(halfWidth),
+          m_cos(std::cos(angle)),
+          m_sin(std::sin(angle))
+    {
+        ASSERT(halfLength > 0. && halfWidth > 0.);
+    }
+
+    template <class Space_T>
+    inline typename ImplicitRotatedRectangle<Space_T>::Value
+      ImplicitRotatedRectangle<Space_T>::operator()(RealPoint const & point) const
+    {
+        double const dx = point[0] - m_centre[0];
+        double const dy = point[1] - m_centre[1];
+        double const u  = std::abs(m_cos * dx + m_sin * dy) / m_halfLength;
+        double const v  = std::abs(m_cos * dy - m_sin * dx) / m_halfWidth;
+        return std::max(u, v) - 1.;
+    }
+
+    template <class Space_T>
+    inline bool
+      ImplicitRotatedRectangle<Space_T>::isInside(RealPoint const & point) const
+    {
+        return (*this)(point) < 0.;
+    }
+
+    template <class Space_T>
+    inline DGtal::Orientation
+      ImplicitRotatedRectangle<Space_T>::orientation(RealPoint const & point) const
+    {
+        Value const value = (*this)(point);
+        return value < 0. ? DGtal::INSIDE : (value > 0. ? DGtal::OUTSIDE : DGtal::ON);
+    }
+
+    template <class Space_T>
+    inline typename ImplicitRotatedRectangle<Space_T>::RealPoint
+      ImplicitRotatedRectangle<Space_T>::getLowerBound() const
+    {
+        double const c = std::abs(m_cos);
+        double const s = std::abs(m_sin);
+        return m_centre - RealPoint(m_halfLength * c + m_halfWidth * s, m_halfLength * s + m_halfWidth * c);
+    }
+
+    template <class Space_T>
+    inline typename ImplicitRotatedRectangle<Space_T>::RealPoint
+      ImplicitRotatedRectangle<Space_T>::getUpperBound() const
+    {
+        return m_centre + (m_centre - getLowerBound());
+    }
+
+    template <class Space_T>
+    inline std::optional<std::pair<double, double>>
+      ImplicitRotatedRectangle<Space_T>::computeRowInterval(double y) const
+    {
+        // Intersection of the two slabs |cos dx + sin dy| <= l and |cos dy - sin dx| <= w along the row.
+        double const dy    = y - m_centre[1];
+        double       first = -std::numeric_limits<double>::infinity();
+        double       last  = std::numeric_limits<double>::infinity();
+        auto const   clip  = [&first, &last](double slope, double offset, double halfSize) -> bool
+        {
+            // slope dx + offset in [-halfSize, halfSize]
+            if (slope == 0.)
+            {
+                return std::abs(offset) <= halfSize;
+            }
+            double const a = (-halfSize - offset) / slope;
+            double const b = (halfSize - offset) / slope;
+            first          = std::max(first, std::min(a, b));
+            last           = std::min(last, std::max(a, b));
+            return true;
+        };
+        if (!clip(m_cos, m_sin * dy, m_halfLength) || !clip(-m_sin, m_cos * dy, m_halfWidth) || first > last)
+        {
+            return std::nullopt;
+        }
+        return std::make_pair(m_centre[0] + first, m_centre[0] + last);
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_IMPLICITSHAPES2D_INL
@@ -0,0 +1,150 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_MULTIGRIDBENCHMARK_HPP
+#define TD_UTIL_MULTIGRIDBENCHMARK_HPP
+
+#include <util/DigitalComponent.hpp>
+#include <util/ScanlineDigitizer.hpp>
+
+#include <DGtal/shapes/GaussDigitizer.h>
+#include <DGtal/shapes/ShapeFactory.h>
+
+#include <array>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace td::util
+{
+    /// Whether the estimator of the moments converges to the area and perimeter of a shape,
+    /// which is only the case of ellipses.
+    /// \tparam Shape_T
+    template <class Shape_T>
+    struct MomentsTraits
+    {
+        static constexpr bool c_isEllipse = false;
+    };
+
+    template <class Space_T>
+    struct MomentsTraits<DGtal::ImplicitBall<Space_T>>
+    {
+        static constexpr bool c_isEllipse = true;
+    };
+
+    /// Multigrid convergence study of the area and perimeter estimators
+    /// of DigitalComponent, for any Euclidean shape of the Gauss digitiser.
+    /// Each grid step is digitised, tracked and measured independently,
+    /// so the grid steps are spread over threads.
+    /// \tparam Shape_T an implicit shape (ImplicitBall, ImplicitHyperCube, ...)
+    template <class Shape_T>
+    class MultigridBenchmark
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef Shape_T                                     Shape;
+        typedef DGtal::Z2i::DT4_8                           DigitalTopology;
+        typedef DigitalComponent<2, DigitalTopology>        Component;
+        typedef typename Component::Space                   Space;
+        typedef typename Component::Domain                  Domain;
+        typedef typename Component::Point                   Point;
+        typedef DGtal::GaussDigitizer<Space, Shape>         Digitizer;
+
+        typedef typename Component::Area      Area;
+        typedef typename Component::Perimeter Perimeter;
+        typedef double                        Seconds;
+
+        enum class Estimator
+        {
+            Count,
+            ConvexHull,
+            Segmentation,
+            // Area and perimeter of the ellipse with the same second-order moments as the shape.
+            // They only converge for ellipses: on a square, they tend to pi / 3 (about 1.047) times its area
+            // and pi / (2 sqrt(3)) (about 0.907) times its perimeter. Their errors are not finite for other shapes
+            // (see MomentsTraits), so that this bias never joins the error curves.
+            Moments,
+            // Same polygons, areas from the shoelace formula.
+            ConvexHullShoelace,
+            SegmentationShoelace
+        };
+        static constexpr std::size_t c_numberEstimators = 6;
+
+        /// One estimator evaluated at one grid step.
+        /// Area and perimeter are scaled back to the Euclidean space.
+        struct Estimation
+        {
+            Area      area;
+            Perimeter perimeter;
+            Area      areaError;
+            Perimeter perimeterError;
+            Seconds   seconds;
+        };
+
+        /// All estimators evaluated at one grid step.
+        struct Sample
+        {
+            double gridStep;
+            // Time spent in the stages shared by the estimators.
+            Seconds digitisationSeconds;
+            Seconds geometrySeconds;
+            std::array<Estimation, c_numberEstimators> estimations;
+        };
+
+        /** --------- methods ------------- **/
+        /// \param name used to label the output.
+        /// \param shape
+        /// \param area analytic area of the shape.
+        /// \param perimeter analytic perimeter of the shape.
+        inline MultigridBenchmark(std::string name, Shape const & shape, Area area, Perimeter perimeter);
+
+        /// Runs the study for each grid step.
+        /// \param gridSteps
+        /// \param numberThreads 0 to use all hardware threads.
+        /// \return one sample per grid step, in the same order.
+        [[nodiscard]] std::vector<Sample>
+          run(std::vector<double> const & gridSteps, unsigned int numberThreads = 0) const;
+
+        /// Geometric progression of grid steps, from coarse to fine.
+        /// \param hMax coarsest grid step.
+        /// \param hMin finest grid step.
+        /// \param count
+        /// \return
+        [[nodiscard]] inline static std::vector<double>
+          computeGridSteps(double hMax, double hMin, int count);
+
+        void
+          writeCsv(std::ostream & os, std::vector<Sample> const & samples, bool withHeader = true) const;
+        void
+          writeJson(std::ostream & os, std::vector<Sample> const & samples) const;
+
+        [[nodiscard]] inline static char const *
+          getEstimatorName(Estimator estimator);
+
+       private:
+        /** --------- methods ------------- **/
+        [[nodiscard]] Sample
+          computeSample(double gridStep) const;
+
+        [[nodiscard]] inline Digitizer
+          createDigitizer(double gridStep) const;
+
+        /// JSON has no literal for NaN nor infinities, they are written as null.
+        inline static void
+          writeJsonNumber(std::ostream & os, double value);
+        /// Same in CSV, as n/a.
+        inline static void
+          writeCsvNumber(std::ostream & os, double value);
+
+        /** --------- data ------------- **/
+        std::string m_name;
+        Shape       m_shape;
+        Area        m_area;
+        Perimeter   m_perimeter;
+    };
+}  // namespace td::util
+
+#include "MultigridBenchmark.inl"
+
+#endif  // TD_UTIL_MULTIGRIDBENCHMARK_HPP
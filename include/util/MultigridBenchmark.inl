@@ -0,0 +1,252 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_MULTIGRIDBENCHMARK_INL
+#define TD_UTIL_MULTIGRIDBENCHMARK_INL
+
+#include <util/parallel.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace td::util
+{
+    template <class Shape_T>
+    inline MultigridBenchmark<Shape_T>::MultigridBenchmark(std::string name,
+                                                           Shape const & shape,
+                                                           Area          area,
+                                                           Perimeter     perimeter)
+        : m_name(std::move(name)), m_shape(shape), m_area(area), m_perimeter(perimeter)
+    {}
+
+    template <class Shape_T>
+    std::vector<typename MultigridBenchmark<Shape_T>::Sample>
+      MultigridBenchmark<Shape_T>::run(std::vector<double> const & gridSteps, unsigned int numberThreads) const
+    {
+        std::vector<Sample> samples(gridSteps.size());
+        // Fine grid steps are the longest, so they should be picked first.
+        std::vector<std::size_t> order(gridSteps.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(),
+                  order.end(),
+                  [&gridSteps](std::size_t i, std::size_t j) { return gridSteps[i] < gridSteps[j]; });
+        // The grid steps do not share anything, the threads pick them in that order.
+        parallel::forEach(order.size(),
+                          numberThreads,
+                          [this, &gridSteps, &samples, &order](std::size_t i)
+                          { samples[order[i]] = computeSample(gridSteps[order[i]]); });
+        return samples;
+    }
+
+    template <class Shape_T>
+    typename MultigridBenchmark<Shape_T>::Sample
+      MultigridBenchmark<Shape_T>::computeSample(double gridStep) const
+    {
+        typedef std::chrono::steady_clock Clock;
+        auto const secondsSince = [](Clock::time_point const & start) -> Seconds
+        {
+            return std::chrono::duration<Seconds>(Clock::now() - start).count();
+        };
+
+        Sample sample {};
+        sample.gridStep = gridStep;
+
+        auto start = Clock::now();
+        Digitizer const dig = createDigitizer(gridStep);
+        // Measured from its runs: the points are never materialised, the count of a fine grid step being too large.
+        Component const component(ScanlineDigitizer<Space>::digitize(m_shape, dig));
+        sample.digitisationSeconds = secondsSince(start);
+
+        // Boundary, hull and segmentation are shared by the estimators,
+        // all the stages are computed here so that the estimations time the estimators only.
+        start = Clock::now();
+        (void)component.getConvexHullArea();
+        (void)component.getSegmentationPerimeter();
+        sample.geometrySeconds = secondsSince(start);
+
+        // Estimations are computed in grid units, scale them back to the Euclidean space.
+        Area const areaScale = gridStep * gridStep;
+        auto const estimate =
+          [this, &sample, &secondsSince, gridStep, areaScale](Estimator estimator, auto const & area, auto const & perimeter)
+        {
+            auto const estimationStart = Clock::now();
+            Estimation estimation {};
+            estimation.area           = area() * areaScale;
+            estimation.perimeter      = perimeter() * gridStep;
+            estimation.seconds        = secondsSince(estimationStart);
+            estimation.areaError      = std::abs(estimation.area - m_area) / m_area;
+            estimation.perimeterError = std::abs(estimation.perimeter - m_perimeter) / m_perimeter;
+            sample.estimations[static_cast<std::size_t>(estimator)] = estimation;
+        };
+
+        estimate(Estimator::Count,
+                 [&component]() { return component.getCountArea(); },
+                 [&component]() { return component.getCountPerimeter(); });
+        estimate(Estimator::ConvexHull,
+                 [&component]() { return component.getConvexHullArea(); },
+                 [&component]() { return component.getConvexHullPerimeter(); });
+        estimate(Estimator::Segmentation,
+                 [&component]() { return component.getSegmentationArea(); },
+                 [&component]() { return component.getSegmentationPerimeter(); });
+        estimate(Estimator::Moments,
+                 [&component]() { return component.getMomentsArea(); },
+                 [&component]() { return component.getMomentsPerimeter(); });
+        if constexpr (!MomentsTraits<Shape>::c_isEllipse)
+        {
+            // The equivalent ellipse is not the shape: its errors would level off at a bias instead of converging.
+            Estimation & moments   = sample.estimations[static_cast<std::size_t>(Estimator::Moments)];
+            moments.areaError      = std::numeric_limits<Area>::quiet_NaN();
+            moments.perimeterError = std::numeric_limits<Perimeter>::quiet_NaN();
+        }
+        estimate(Estimator::ConvexHullShoelace,
+                 [&component]() { return component.getConvexHullArea(Component::PolygonArea::Shoelace); },
+                 [&component]() { return component.getConvexHullPerimeter(); });
+        estimate(Estimator::SegmentationShoelace,
+                 [&component]() { return component.getSegmentationArea(Component::PolygonArea::Shoelace); },
+                 [&component]() { return component.getSegmentationPerimeter(); });
+        return sample;
+    }
+
+    template <class Shape_T>
+    inline typename MultigridBenchmark<Shape_T>::Digitizer
+      MultigridBenchmark<Shape_T>::createDigitizer(double gridStep) const
+    {
+        // same margin as td1.
+        Digitizer dig;
+        dig.attach(m_shape);
+        dig.init(m_shape.getLowerBound() - Point::diagonal(), m_shape.getUpperBound() + Point::diagonal(), gridStep);
+        return dig;
+    }
+
+    template <class Shape_T>
+    inline void
+      MultigridBenchmark<Shape_T>::writeJsonNumber(std::ostream & os, double value)
+    {
+        if (std::isfinite(value))
+        {
+            os << value;
+        }
+        else
+        {
+            os << "null";
+        }
+    }
+
+    template <class Shape_T>
+    inline void
+      MultigridBenchmark<Shape_T>::writeCsvNumber(std::ostream & os, double value)
+    {
+        if (std::isfinite(value))
+        {
+            os << value;
+        }
+        else
+        {
+            os << "n/a";
+        }
+    }
+
+    template <class Shape_T>
+    inline std::vector<double>
+      MultigridBenchmark<Shape_T>::computeGridSteps(double hMax, double hMin, int count)
+    {
+        ASSERT(hMax > 0. && hMin > 0. && count > 0);
+        std::vector<double> gridSteps;
+        gridSteps.reserve(static_cast<std::size_t>(count));
+        double const ratio = count > 1 ? std::pow(hMin / hMax, 1. / static_cast<double>(count - 1)) : 1.;
+        double       h     = hMax;
+        for (int i = 0; i < count; ++i)
+        {
+            gridSteps.push_back(h);
+            h *= ratio;
+        }
+        return gridSteps;
+    }
+
+    template <class Shape_T>
+    inline char const *
+      MultigridBenchmark<Shape_T>::getEstimatorName(Estimator estimator)
+    {
+        switch (estimator)
+        {
+        case Estimator::Count: return "count";
+        case Estimator::ConvexHull: return "convex_hull";
+        case Estimator::Segmentation: return "segmentation";
+        case Estimator::Moments: return "moments";
+        case Estimator::ConvexHullShoelace: return "convex_hull_shoelace";
+        case Estimator::SegmentationShoelace: return "segmentation_shoelace";
+        }
+        return "";
+    }
+
+    template <class Shape_T>
+    void
+      MultigridBenchmark<Shape_T>::writeCsv(std::ostream &              os,
+                                            std::vector<Sample> const & samples,
+                                            bool                        withHeader) const
+    {
+        if (withHeader)
+        {
+            os << "shape,h,estimator,area,area_error,perimeter,perimeter_error,seconds,"
+                  "digitisation_seconds,geometry_seconds\n";
+        }
+        for (auto const & sample : samples)
+        {
+            for (std::size_t i = 0; i < c_numberEstimators; ++i)
+            {
+                Estimation const & estimation = sample.estimations[i];
+                os << m_name << ',' << sample.gridStep << ',' << getEstimatorName(static_cast<Estimator>(i)) << ',';
+                writeCsvNumber(os, estimation.area);
+                os << ',';
+                writeCsvNumber(os, estimation.areaError);
+                os << ',';
+                writeCsvNumber(os, estimation.perimeter);
+                os << ',';
+                writeCsvNumber(os, estimation.perimeterError);
+                os << ',' << estimation.seconds << ',' << sample.digitisationSeconds << ',' << sample.geometrySeconds
+                   << '\n';
+            }
+        }
+    }
+
+    template <class Shape_T>
+    void
+      MultigridBenchmark<Shape_T>::writeJson(std::ostream & os, std::vector<Sample> const & samples) const
+    {
+        os << "{\"shape\": \"" << m_name << "\", \"area\": ";
+        writeJsonNumber(os, m_area);
+        os << ", \"perimeter\": ";
+        writeJsonNumber(os, m_perimeter);
+        os << ", \"samples\": [";
+        for (std::size_t j = 0; j < samples.size(); ++j)
+        {
+            Sample const & sample = samples[j];
+            os << (j == 0 ? "" : ",") << "\n  {\"h\": " << sample.gridStep
+               << ", \"digitisation_seconds\": " << sample.digitisationSeconds
+               << ", \"geometry_seconds\": " << sample.geometrySeconds << ", \"estimators\": {";
+            for (std::size_t i = 0; i < c_numberEstimators; ++i)
+            {
+                Estimation const & estimation = sample.estimations[i];
+                // Degenerate components give NaN or infinite estimates and errors.
+                os << (i == 0 ? "" : ", ") << '"' << getEstimatorName(static_cast<Estimator>(i)) << "\": {"
+                   << "\"area\": ";
+                writeJsonNumber(os, estimation.area);
+                os << ", \"area_error\": ";
+                writeJsonNumber(os, estimation.areaError);
+                os << ", \"perimeter\": ";
+                writeJsonNumber(os, estimation.perimeter);
+                os << ", \"perimeter_error\": ";
+                writeJsonNumber(os, estimation.perimeterError);
+                os << ", \"seconds\": " << estimation.seconds << '}';
+            }
+            os << "}}";
+        }
+        os << "\n]}\n";
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_MULTIGRIDBENCHMARK_INL
@@ -0,0 +1,167 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_PROFILER_HPP
+#define TD_UTIL_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// Instrumentation of the pipeline, compiled out unless TD_UTIL_PROFILING is defined.
+/// TD_PROFILE_SCOPE(name) times the rest of the enclosing scope,
+/// TD_PROFILE_COUNT(name, value) adds a value to a counter.
+/// Names are string literals, registered once per call site.
+#ifdef TD_UTIL_PROFILING
+#define TD_PROFILE_CONCATENATE_(a, b) a##b
+#define TD_PROFILE_CONCATENATE(a, b)  TD_PROFILE_CONCATENATE_(a, b)
+#define TD_PROFILE_SCOPE(name)                                                                                \
+    static std::size_t const TD_PROFILE_CONCATENATE(td_profileStage, __LINE__) =                              \
+      ::td::util::Profiler::registerName(::td::util::Profiler::Kind::Stage, name);                            \
+    ::td::util::Profiler::Scope const TD_PROFILE_CONCATENATE(td_profileScope, __LINE__)(                      \
+      TD_PROFILE_CONCATENATE(td_profileStage, __LINE__))
+#define TD_PROFILE_COUNT(name, value)                                                                         \
+    do                                                                                                        \
+    {                                                                                                         \
+        static std::size_t const td_profileCounter =                                                          \
+          ::td::util::Profiler::registerName(::td::util::Profiler::Kind::Counter, name);                      \
+        ::td::util::Profiler::count(td_profileCounter, static_cast<std::int64_t>(value));                     \
+    } while (false)
+#else
+#define TD_PROFILE_SCOPE(name)        static_cast<void>(0)
+#define TD_PROFILE_COUNT(name, value) static_cast<void>(0)
+#endif
+
+namespace td::util
+{
+    /// Timers and counters, aggregated per thread without locks.
+    /// Each thread writes to its own record, the records are only read by the reports,
+    /// which must be called once the instrumented threads are done (joined or idle).
+    class Profiler
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef std::chrono::steady_clock Clock;
+
+        enum class Kind
+        {
+            Stage,
+            Counter
+        };
+
+        /// Times its lifetime.
+        class Scope
+        {
+           public:
+            inline explicit Scope(std::size_t stage);
+            inline ~Scope();
+
+            Scope(Scope const &) = delete;
+            Scope &
+              operator=(Scope const &) = delete;
+
+           private:
+            std::size_t       m_stage;
+            Clock::time_point m_begin;
+        };
+
+        /// Point predicate counting its evaluations, to see how hard a search was.
+        /// \tparam Predicate_T
+        template <class Predicate_T>
+        class CountingPredicate
+        {
+           public:
+            typedef typename Predicate_T::Point Point;
+
+            inline explicit CountingPredicate(Predicate_T const & predicate);
+
+            inline bool
+              operator()(Point const & point) const;
+
+            [[nodiscard]] inline std::size_t
+              getCount() const;
+
+           private:
+            // Pointers, so that the predicate stays assignable.
+            Predicate_T const *                  m_predicate;
+            std::shared_ptr<std::size_t> mutable m_count;
+        };
+
+        /** --------- methods ------------- **/
+        /// Index of a name, the same for every call with the same name.
+        [[nodiscard]] inline static std::size_t
+          registerName(Kind kind, char const * name);
+
+        inline static void
+          count(std::size_t counter, std::int64_t value);
+
+        /// Calls, total, mean and longest time of each stage, sum of each counter.
+        inline static void
+          printSummary(std::ostream & os);
+
+        /// Writes every timed scope as a complete event of the Chrome trace format,
+        /// to be opened in chrome://tracing or Perfetto. Counters are in the metadata.
+        inline static void
+          writeChromeTrace(std::filesystem::path const & path);
+
+        /// Forgets everything recorded so far.
+        inline static void
+          reset();
+
+       private:
+        /** --------- typedefs ------------- **/
+        struct Stage
+        {
+            std::uint64_t calls   = 0;
+            Clock::duration total = Clock::duration::zero();
+            Clock::duration longest = Clock::duration::zero();
+        };
+
+        struct Event
+        {
+            std::size_t       stage;
+            Clock::time_point begin;
+            Clock::time_point end;
+        };
+
+        /// Everything recorded by one thread.
+        struct Record
+        {
+            std::size_t                thread;
+            std::vector<Stage>         stages;
+            std::vector<std::int64_t>  counters;
+            std::vector<Event>         events;
+        };
+
+        /** --------- methods ------------- **/
+        /// Record of the calling thread, created on its first use.
+        [[nodiscard]] inline static Record &
+          getRecord();
+
+        inline static void
+          addEvent(std::size_t stage, Clock::time_point begin, Clock::time_point end);
+
+        /** --------- data ------------- **/
+        // Guards the names and the list of records, not their content.
+        inline static std::mutex                           s_mutex;
+        inline static std::vector<std::string>             s_stageNames;
+        inline static std::vector<std::string>             s_counterNames;
+        inline static std::vector<std::shared_ptr<Record>> s_records;
+        inline static Clock::time_point const              s_origin = Clock::now();
+        // The records outlive their threads, for the reports.
+        inline static thread_local std::shared_ptr<Record> s_record;
+
+        // Events kept per thread for the trace, the aggregates go on.
+        static constexpr std::size_t c_maximumEvents = std::size_t {1} << 20;
+    };
+}  // namespace td::util
+
+#include "Profiler.inl"
+
+#endif  // TD_UTIL_PROFILER_HPP
@@ -0,0 +1,206 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_PROFILER_INL
+#define TD_UTIL_PROFILER_INL
+
+#include <DGtal/base/Common.h>
+#include <DGtal/base/Exceptions.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace td::util
+{
+    inline Profiler::Scope::Scope(std::size_t stage) : m_stage(stage), m_begin(Clock::now()) {}
+
+    inline Profiler::Scope::~Scope()
+    {
+        addEvent(m_stage, m_begin, Clock::now());
+    }
+
+    template <class Predicate_T>
+    inline Profiler::CountingPredicate<Predicate_T>::CountingPredicate(Predicate_T const & predicate)
+        : m_predicate(&predicate), m_count(std::make_shared<std::size_t>(0))
+    {}
+
+    template <class Predicate_T>
+    inline bool
+      Profiler::CountingPredicate<Predicate_T>::operator()(Point const & point) const
+    {
+        ++*m_count;
+        return (*m_predicate)(point);
+    }
+
+    template <class Predicate_T>
+    inline std::size_t
+      Profiler::CountingPredicate<Predicate_T>::getCount() const
+    {
+        return *m_count;
+    }
+
+    inline std::size_t
+      Profiler::registerName(Kind kind, char const * name)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        std::vector<std::string> &  names = kind == Kind::Stage ? s_stageNames : s_counterNames;
+        // The same name at several call sites is the same stage.
+        auto const it = std::find(names.begin(), names.end(), name);
+        if (it != names.end())
+        {
+            return static_cast<std::size_t>(it - names.begin());
+        }
+        names.emplace_back(name);
+        return names.size() - 1;
+    }
+
+    inline Profiler::Record &
+      Profiler::getRecord()
+    {
+        if (!s_record)
+        {
+            s_record = std::make_shared<Record>();
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_record->thread = s_records.size();
+            s_records.push_back(s_record);
+        }
+        return *s_record;
+    }
+
+    inline void
+      Profiler::addEvent(std::size_t stage, Clock::time_point begin, Clock::time_point end)
+    {
+        Record & record = getRecord();
+        if (record.stages.size() <= stage)
+        {
+            record.stages.resize(stage + 1);
+        }
+        Stage &               aggregate = record.stages[stage];
+        Clock::duration const duration  = end - begin;
+        ++aggregate.calls;
+        aggregate.total += duration;
+        aggregate.longest = std::max(aggregate.longest, duration);
+        if (record.events.size() < c_maximumEvents)
+        {
+            record.events.push_back({stage, begin, end});
+        }
+    }
+
+    inline void
+      Profiler::count(std::size_t counter, std::int64_t value)
+    {
+        Record & record = getRecord();
+        if (record.counters.size() <= counter)
+        {
+            record.counters.resize(counter + 1, 0);
+        }
+        record.counters[counter] += value;
+    }
+
+    inline void
+      Profiler::printSummary(std::ostream & os)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        std::vector<Stage>          stages(s_stageNames.size());
+        std::vector<std::int64_t>   counters(s_counterNames.size(), 0);
+        for (auto const & record : s_records)
+        {
+            for (std::size_t i = 0; i < record->stages.size(); ++i)
+            {
+                stages[i].calls += record->stages[i].calls;
+                stages[i].total += record->stages[i].total;
+                stages[i].longest = std::max(stages[i].longest, record->stages[i].longest);
+            }
+            for (std::size_t i = 0; i < record->counters.size(); ++i)
+            {
+                counters[i] += record->counters[i];
+            }
+        }
+        auto const toMilliseconds = [](Clock::duration duration)
+        { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+        os << "---- PROFILE (" << s_records.size() << " threads) -----" << std::endl;
+        os << std::left << std::setw(32) << "stage" << std::right << std::setw(10) << "calls" << std::setw(14)
+           << "total (ms)" << std::setw(14) << "mean (ms)" << std::setw(14) << "max (ms)" << std::endl;
+        for (std::size_t i = 0; i < stages.size(); ++i)
+        {
+            if (stages[i].calls == 0)
+            {
+                continue;
+            }
+            os << std::left << std::setw(32) << s_stageNames[i] << std::right << std::setw(10) << stages[i].calls
+               << std::setw(14) << toMilliseconds(stages[i].total) << std::setw(14)
+               << toMilliseconds(stages[i].total) / static_cast<double>(stages[i].calls) << std::setw(14)
+               << toMilliseconds(stages[i].longest) << std::endl;
+        }
+        for (std::size_t i = 0; i < counters.size(); ++i)
+        {
+            os << std::left << std::setw(32) << s_counterNames[i] << std::right << std::setw(10) << counters[i]
+               << std::endl;
+        }
+    }
+
+    inline void
+      Profiler::writeChromeTrace(std::filesystem::path const & path)
+    {
+        std::ofstream os(path);
+        if (!os)
+        {
+            DGtal::trace.error() << "Profiler: can't open " << path << std::endl;
+            throw DGtal::IOException();
+        }
+        std::lock_guard<std::mutex> lock(s_mutex);
+        auto const toMicroseconds = [](Clock::duration duration)
+        { return std::chrono::duration<double, std::micro>(duration).count(); };
+
+        os << std::fixed << std::setprecision(3);
+        os << "{\"traceEvents\":[";
+        bool isFirst = true;
+        for (auto const & record : s_records)
+        {
+            for (Event const & event : record->events)
+            {
+                os << (isFirst ? "\n" : ",\n") << "{\"name\":\"" << s_stageNames[event.stage]
+                   << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << record->thread
+                   << ",\"ts\":" << toMicroseconds(event.begin - s_origin)
+                   << ",\"dur\":" << toMicroseconds(event.end - event.begin) << "}";
+                isFirst = false;
+            }
+        }
+        os << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{";
+        std::vector<std::int64_t> counters(s_counterNames.size(), 0);
+        for (auto const & record : s_records)
+        {
+            for (std::size_t i = 0; i < record->counters.size(); ++i)
+            {
+                counters[i] += record->counters[i];
+            }
+        }
+        for (std::size_t i = 0; i < counters.size(); ++i)
+        {
+            os << (i == 0 ? "" : ",") << "\"" << s_counterNames[i] << "\":" << counters[i];
+        }
+        os << "}}" << std::endl;
+        if (!os)
+        {
+            DGtal::trace.error() << "Profiler: can't write " << path << std::endl;
+            throw DGtal::IOException();
+        }
+    }
+
+    inline void
+      Profiler::reset()
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        for (auto const & record : s_records)
+        {
+            record->stages.clear();
+            record->counters.clear();
+            record->events.clear();
+        }
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_PROFILER_INL
@@ -0,0 +1,105 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_RASTEROVERLAY_HPP
+#define TD_UTIL_RASTEROVERLAY_HPP
+
+#include <util/DrawingBuffer.hpp>
+
+#include <DGtal/helpers/StdDefs.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace td::util
+{
+    /// RGB image of drawings, at the resolution of the analysed image (or a multiple of it).
+    /// Its cost depends on the number of pixels, not on the number of primitives of the drawings,
+    /// unlike a Board2D which keeps one vector shape per pixel.
+    /// The image is painted in bands of rows, one band per task, so that threads never share a pixel.
+    class RasterOverlay
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef DGtal::Z2i::Domain Domain;
+        typedef DGtal::Z2i::Point  Point;
+        typedef DGtal::Color       Colour;
+
+        /** --------- methods ------------- **/
+        /// \param domain pixels of the drawings, the first row of the image being the upper one.
+        /// \param scale raster pixels per pixel of the domain, along each axis.
+        /// \param background
+        inline explicit RasterOverlay(Domain const & domain, int scale = 1, Colour const & background = Colour::White);
+
+        /// Paints drawings in order: pixels are filled, polygons filled then outlined.
+        /// \param drawings
+        /// \param numberThreads 0 to use all hardware threads.
+        inline void
+          paint(std::vector<DrawingBuffer> const & drawings, unsigned int numberThreads = 0);
+
+        /// Binary PPM (P6).
+        inline void
+          savePPM(std::filesystem::path const & path) const;
+        /// PNG, through Cairo: throws when built without it (WITH_CAIRO).
+        inline void
+          savePNG(std::filesystem::path const & path) const;
+        /// PPM or PNG, from the extension.
+        inline void
+          save(std::filesystem::path const & path) const;
+
+        [[nodiscard]] inline int
+          getWidth() const;
+        [[nodiscard]] inline int
+          getHeight() const;
+        /// Red, green and blue of each pixel, row by row from the top.
+        [[nodiscard]] inline std::vector<std::uint8_t> const &
+          getData() const;
+
+       private:
+        /** --------- typedefs ------------- **/
+        /// Part of a command which falls in a band.
+        struct Item
+        {
+            std::uint32_t drawing;
+            std::uint32_t command;
+            // coordinates of the part, the whole command for polygons.
+            std::uint32_t first;
+            std::uint32_t count;
+        };
+
+        /** --------- methods ------------- **/
+        inline void
+          paintPixel(DrawingBuffer::Coordinate const & coordinate, Colour const & colour, int rowBegin, int rowEnd);
+        inline void
+          paintPolygon(DrawingBuffer::Coordinate const * coordinates,
+                       std::uint32_t                     count,
+                       Colour const &                    pen,
+                       Colour const &                    fill,
+                       int                               rowBegin,
+                       int                               rowEnd);
+        inline void
+          blend(int column, int row, Colour const & colour);
+
+        /// Raster coordinates of a drawing coordinate, continuous.
+        [[nodiscard]] inline double
+          toColumn(float x) const;
+        [[nodiscard]] inline double
+          toRow(float y) const;
+
+        /** --------- data ------------- **/
+        Domain                    m_domain;
+        int                       m_scale;
+        int                       m_width;
+        int                       m_height;
+        std::vector<std::uint8_t> m_data;
+
+        // Rows of the domain per band.
+        static constexpr int c_bandHeight = 32;
+    };
+}  // namespace td::util
+
+#include "RasterOverlay.inl"
+
+#endif  // TD_UTIL_RASTEROVERLAY_HPP
@@ -0,0 +1,363 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_RASTEROVERLAY_INL
+#define TD_UTIL_RASTEROVERLAY_INL
+
+#include <util/parallel.hpp>
+
+#include <DGtal/base/Exceptions.h>
+
+#ifdef WITH_CAIRO
+#include <cairo/cairo.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace td::util
+{
+    inline RasterOverlay::RasterOverlay(Domain const & domain, int scale, Colour const & background)
+        : m_domain(domain),
+          m_scale(scale),
+          m_width((domain.upperBound()[0] - domain.lowerBound()[0] + 1) * scale),
+          m_height((domain.upperBound()[1] - domain.lowerBound()[1] + 1) * scale),
+          m_data(static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height) * 3)
+    {
+        ASSERT(scale > 0);
+        for (std::size_t i = 0; i < m_data.size(); i += 3)
+        {
+            m_data[i]     = background.red();
+            m_data[i + 1] = background.green();
+            m_data[i + 2] = background.blue();
+        }
+    }
+
+    inline void
+      RasterOverlay::paint(std::vector<DrawingBuffer> const & drawings, unsigned int numberThreads)
+    {
+        // Whole pixels per band, so that the block of a pixel is never split.
+        int const         bandHeight  = c_bandHeight * m_scale;
+        std::size_t const numberBands = static_cast<std::size_t>((m_height + bandHeight - 1) / bandHeight);
+        auto const        toBand      = [this, bandHeight](double row)
+        { return static_cast<std::size_t>(std::clamp(static_cast<int>(std::floor(row)), 0, m_height - 1) / bandHeight); };
+
+        // Sorting the commands into the bands, in order.
+        // Consecutive pixels of a command in the same band make a single item.
+        std::vector<std::vector<Item>> bands(numberBands);
+        for (std::uint32_t d = 0; d < drawings.size(); ++d)
+        {
+            auto const & commands    = drawings[d].getCommands();
+            auto const & coordinates = drawings[d].getCoordinates();
+            for (std::uint32_t c = 0; c < commands.size(); ++c)
+            {
+                DrawingBuffer::Command const & command = commands[c];
+                if (command.count == 0)
+                {
+                    continue;
+                }
+                if (command.shape == DrawingBuffer::Shape::Pixels)
+                {
+                    for (std::uint32_t i = command.first; i < command.first + command.count; ++i)
+                    {
+                        std::vector<Item> & band = bands[toBand(toRow(coordinates[i].y))];
+                        if (!band.empty() && band.back().drawing == d && band.back().command == c
+                            && band.back().first + band.back().count == i)
+                        {
+                            ++band.back().count;
+                        }
+                        else
+                        {
+                            band.push_back({d, c, i, 1});
+                        }
+                    }
+                }
+                else
+                {
+                    auto const vertical = std::minmax_element(
+                      coordinates.begin() + command.first,
+                      coordinates.begin() + command.first + command.count,
+                      [](DrawingBuffer::Coordinate const & p, DrawingBuffer::Coordinate const & q) { return p.y < q.y; });
+                    // y points up, rows down.
+                    std::size_t const first = toBand(toRow(vertical.second->y));
+                    std::size_t const last  = toBand(toRow(vertical.first->y));
+                    for (std::size_t b = first; b <= last; ++b)
+                    {
+                        bands[b].push_back({d, c, command.first, command.count});
+                    }
+                }
+            }
+        }
+
+        parallel::forEach(bands.size(),
+                          numberThreads,
+                          [&](std::size_t b)
+                          {
+                              int const rowBegin = static_cast<int>(b) * bandHeight;
+                              int const rowEnd   = std::min(rowBegin + bandHeight, m_height);
+                              for (Item const & item : bands[b])
+                              {
+                                  DrawingBuffer::Command const &    command = drawings[item.drawing].getCommands()[item.command];
+                                  DrawingBuffer::Coordinate const * coordinates =
+                                    drawings[item.drawing].getCoordinates().data() + item.first;
+                                  if (command.shape == DrawingBuffer::Shape::Pixels)
+                                  {
+                                      for (std::uint32_t i = 0; i < item.count; ++i)
+                                      {
+                                          paintPixel(coordinates[i], command.fill, rowBegin, rowEnd);
+                                      }
+                                  }
+                                  else
+                                  {
+                                      paintPolygon(coordinates, item.count, command.pen, command.fill, rowBegin, rowEnd);
+                                  }
+                              }
+                          });
+    }
+
+    inline void
+      RasterOverlay::paintPixel(DrawingBuffer::Coordinate const & coordinate,
+                                Colour const &                    colour,
+                                int                               rowBegin,
+                                int                               rowEnd)
+    {
+        if (colour.alpha() == 0)
+        {
+            return;
+        }
+        // Corner of the block of the pixel.
+        int const column = static_cast<int>(std::floor(toColumn(coordinate.x - 0.5f) + 0.5));
+        int const row    = static_cast<int>(std::floor(toRow(coordinate.y + 0.5f) + 0.5));
+        for (int v = std::max(row, rowBegin); v < std::min(row + m_scale, rowEnd); ++v)
+        {
+            for (int u = std::max(column, 0); u < std::min(column + m_scale, m_width); ++u)
+            {
+                blend(u, v, colour);
+            }
+        }
+    }
+
+    inline void
+      RasterOverlay::paintPolygon(DrawingBuffer::Coordinate const * coordinates,
+                                  std::uint32_t                     count,
+                                  Colour const &                    pen,
+                                  Colour const &                    fill,
+                                  int                               rowBegin,
+                                  int                               rowEnd)
+    {
+        if (fill.alpha() != 0 && count >= 3)
+        {
+            auto const vertical = std::minmax_element(
+              coordinates,
+              coordinates + count,
+              [](DrawingBuffer::Coordinate const & p, DrawingBuffer::Coordinate const & q) { return p.y < q.y; });
+            int const first = std::max(rowBegin, static_cast<int>(std::floor(toRow(vertical.second->y))));
+            int const last  = std::min(rowEnd, static_cast<int>(std::ceil(toRow(vertical.first->y))));
+            // Edge table: the edges over the rows of the band, sorted once by their top row.
+            // Each row then only looks at the active edges, those it is between the ends of.
+            struct Edge
+            {
+                double top;
+                double bottom;
+                double up;
+                double vp;
+                double du;
+                double dv;
+            };
+            std::vector<Edge> edges;
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                DrawingBuffer::Coordinate const & p  = coordinates[i];
+                DrawingBuffer::Coordinate const & q  = coordinates[(i + 1) % count];
+                double const                      vp = toRow(p.y);
+                double const                      vq = toRow(q.y);
+                double const                      up = toColumn(p.x);
+                Edge const edge {std::min(vp, vq), std::max(vp, vq), up, vp, toColumn(q.x) - up, vq - vp};
+                // Horizontal edges cross no row centre.
+                if (edge.top < edge.bottom && edge.bottom > first && edge.top < last)
+                {
+                    edges.push_back(edge);
+                }
+            }
+            std::sort(edges.begin(), edges.end(), [](Edge const & e, Edge const & f) { return e.top < f.top; });
+
+            // Even-odd rule, sampled at the centre of each raster pixel.
+            std::vector<Edge>   active;
+            std::vector<double> crossings;
+            std::size_t         next = 0;
+            for (int v = first; v < last; ++v)
+            {
+                double const centre = v + 0.5;
+                for (; next < edges.size() && edges[next].top <= centre; ++next)
+                {
+                    active.push_back(edges[next]);
+                }
+                active.erase(std::remove_if(active.begin(),
+                                            active.end(),
+                                            [centre](Edge const & edge) { return edge.bottom <= centre; }),
+                             active.end());
+                crossings.clear();
+                for (Edge const & edge : active)
+                {
+                    crossings.push_back(edge.up + (centre - edge.vp) * edge.du / edge.dv);
+                }
+                std::sort(crossings.begin(), crossings.end());
+                for (std::size_t k = 0; k + 1 < crossings.size(); k += 2)
+                {
+                    int const begin = std::max(0, static_cast<int>(std::ceil(crossings[k] - 0.5)));
+                    int const end   = std::min(m_width - 1, static_cast<int>(std::floor(crossings[k + 1] - 0.5)));
+                    for (int u = begin; u <= end; ++u)
+                    {
+                        blend(u, v, fill);
+                    }
+                }
+            }
+        }
+        if (pen.alpha() != 0)
+        {
+            // One raster pixel wide, sampled at least once per raster pixel along the edges.
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                DrawingBuffer::Coordinate const & p       = coordinates[i];
+                DrawingBuffer::Coordinate const & q       = coordinates[(i + 1) % count];
+                double const                      up      = toColumn(p.x);
+                double const                      vp      = toRow(p.y);
+                double const                      du      = toColumn(q.x) - up;
+                double const                      dv      = toRow(q.y) - vp;
+                // Most edges of a long boundary are in other bands.
+                if (std::max(vp, vp + dv) < rowBegin || std::min(vp, vp + dv) >= rowEnd)
+                {
+                    continue;
+                }
+                int const                         samples = std::max(1, static_cast<int>(std::ceil(std::max(std::abs(du), std::abs(dv)))));
+                for (int k = 0; k <= samples; ++k)
+                {
+                    double const t = static_cast<double>(k) / samples;
+                    int const    u = static_cast<int>(std::floor(up + t * du));
+                    int const    v = static_cast<int>(std::floor(vp + t * dv));
+                    if (u >= 0 && u < m_width && v >= rowBegin && v < rowEnd)
+                    {
+                        blend(u, v, pen);
+                    }
+                }
+            }
+        }
+    }
+
+    inline void
+      RasterOverlay::blend(int column, int row, Colour const & colour)
+    {
+        std::uint8_t * const pixel =
+          m_data.data() + (static_cast<std::size_t>(row) * static_cast<std::size_t>(m_width) + static_cast<std::size_t>(column)) * 3;
+        int const alpha = colour.alpha();
+        auto const mix  = [alpha](std::uint8_t destination, int source)
+        { return static_cast<std::uint8_t>((source * alpha + destination * (255 - alpha) + 127) / 255); };
+        pixel[0] = mix(pixel[0], colour.red());
+        pixel[1] = mix(pixel[1], colour.green());
+        pixel[2] = mix(pixel[2], colour.blue());
+    }
+
+    inline double
+      RasterOverlay::toColumn(float x) const
+    {
+        return (static_cast<double>(x) - m_domain.lowerBound()[0] + 0.5) * m_scale;
+    }
+
+    inline double
+      RasterOverlay::toRow(float y) const
+    {
+        return (m_domain.upperBound()[1] + 0.5 - static_cast<double>(y)) * m_scale;
+    }
+
+    inline void
+      RasterOverlay::savePPM(std::filesystem::path const & path) const
+    {
+        std::ofstream os(path, std::ios::binary);
+        if (!os)
+        {
+            DGtal::trace.error() << "RasterOverlay: can't open " << path << std::endl;
+            throw DGtal::IOException();
+        }
+        os << "P6\n" << m_width << " " << m_height << "\n255\n";
+        os.write(reinterpret_cast<char const *>(m_data.data()), static_cast<std::streamsize>(m_data.size()));
+        if (!os)
+        {
+            DGtal::trace.error() << "RasterOverlay: can't write " << path << std::endl;
+            throw DGtal::IOException();
+        }
+    }
+
+    inline void
+      RasterOverlay::savePNG(std::filesystem::path const & path) const
+    {
+#ifdef WITH_CAIRO
+        cairo_surface_t * surface = cairo_image_surface_create(CAIRO_FORMAT_RGB24, m_width, m_height);
+        cairo_surface_flush(surface);
+        unsigned char * const data   = cairo_image_surface_get_data(surface);
+        int const             stride = cairo_image_surface_get_stride(surface);
+        for (int row = 0; row < m_height && data != nullptr; ++row)
+        {
+            auto * const                 out = reinterpret_cast<std::uint32_t *>(data + static_cast<std::ptrdiff_t>(row) * stride);
+            std::uint8_t const * const in  = m_data.data() + static_cast<std::size_t>(row) * static_cast<std::size_t>(m_width) * 3;
+            for (int column = 0; column < m_width; ++column)
+            {
+                // native endian xRGB.
+                out[column] = static_cast<std::uint32_t>(in[3 * column]) << 16
+                              | static_cast<std::uint32_t>(in[3 * column + 1]) << 8 | in[3 * column + 2];
+            }
+        }
+        cairo_surface_mark_dirty(surface);
+        cairo_status_t const status = cairo_surface_write_to_png(surface, path.c_str());
+        cairo_surface_destroy(surface);
+        if (status != CAIRO_STATUS_SUCCESS)
+        {
+            DGtal::trace.error() << "RasterOverlay: can't write " << path << ": " << cairo_status_to_string(status)
+                                 << std::endl;
+            throw DGtal::IOException();
+        }
+#else
+        DGtal::trace.error() << "RasterOverlay: can't write " << path << ", built without Cairo" << std::endl;
+        throw DGtal::IOException();
+#endif
+    }
+
+    inline void
+      RasterOverlay::save(std::filesystem::path const & path) const
+    {
+        if (path.extension() == ".ppm")
+        {
+            savePPM(path);
+        }
+        else if (path.extension() == ".png")
+        {
+            savePNG(path);
+        }
+        else
+        {
+            DGtal::trace.error() << "RasterOverlay: unknown format " << path << std::endl;
+            throw DGtal::IOException();
+        }
+    }
+
+    inline int
+      RasterOverlay::getWidth() const
+    {
+        return m_width;
+    }
+
+    inline int
+      RasterOverlay::getHeight() const
+    {
+        return m_height;
+    }
+
+    inline std::vector<std::uint8_t> const &
+      RasterOverlay::getData() const
+    {
+        return m_data;
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_RASTEROVERLAY_INL
@@ -0,0 +1,179 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_SCANLINEDIGITIZER_HPP
+#define TD_UTIL_SCANLINEDIGITIZER_HPP
+
+#include <DGtal/helpers/StdDefs.h>
+#include <DGtal/shapes/GaussDigitizer.h>
+#include <DGtal/shapes/ShapeFactory.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace td::util
+{
+    /// Points of a 2D digital shape, stored as runs along the first axis, row by row.
+    /// Model of DGtal's point predicate,
+    /// so it can replace the digitiser in boundary tracking.
+    /// \tparam Space_T
+    template <class Space_T>
+    class DigitalSpans
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef Space_T                       Space;
+        typedef typename Space::Integer       Integer;
+        typedef typename Space::Point         Point;
+        typedef DGtal::HyperRectDomain<Space> Domain;
+
+        // constraints
+        static_assert(Space::dimension == 2);
+
+        /// Half-open run [begin, end) of a row.
+        struct Span
+        {
+            Integer begin;
+            Integer end;
+        };
+
+        /** --------- methods ------------- **/
+        inline explicit DigitalSpans(Domain const & domain);
+
+        /// Runs of a set of points, sorted in raster order first.
+        /// \param domain must include the points.
+        /// \param points
+        /// \return
+        [[nodiscard]] static DigitalSpans
+          fromPoints(Domain const & domain, std::vector<Point> points);
+
+        /// Adds a run to the current row.
+        /// Runs of a row must be added from left to right, and must not overlap.
+        inline void
+          addSpan(Integer begin, Integer end);
+        /// Moves on to the next row, rows are filled from the lower bound of the domain.
+        inline void
+          closeRow();
+
+        /// \param point
+        /// \return whether the point is in the shape.
+        [[nodiscard]] inline bool
+          operator()(Point const & point) const;
+
+        /// \return number of points in the shape.
+        [[nodiscard]] inline std::size_t
+          size() const;
+
+        [[nodiscard]] inline Domain const &
+          domain() const;
+
+        /// \return smallest domain including every point of the shape, which must not be empty.
+        [[nodiscard]] Domain
+          getBoundingBox() const;
+
+        /// \param row (second coordinate)
+        /// \return the runs of the row, as a pair of pointers.
+        [[nodiscard]] inline std::pair<Span const *, Span const *>
+          getRow(Integer row) const;
+
+        /// Inserts every point of the shape in a digital set.
+        /// \tparam DigitalSet_T
+        /// \param set
+        template <class DigitalSet_T>
+        void
+          insertInto(DigitalSet_T & set) const;
+
+       private:
+        /** --------- data ------------- **/
+        Domain m_domain;
+        // Compressed rows: the runs of row i are m_spans[m_rowOffsets[i], m_rowOffsets[i + 1]).
+        std::vector<Span>        m_spans;
+        std::vector<std::size_t> m_rowOffsets;
+        std::size_t              m_size;
+    };
+
+    /// Closed-form intersection of a shape with a horizontal line.
+    /// Not defined for general shapes, which are digitised by bisection along the rows.
+    /// \tparam Shape_T
+    template <class Shape_T>
+    struct RowIntervalTraits
+    {
+        static constexpr bool c_isClosedForm = false;
+    };
+
+    template <class Space_T>
+    struct RowIntervalTraits<DGtal::ImplicitBall<Space_T>>
+    {
+        static constexpr bool c_isClosedForm = true;
+
+        /// \return the real interval [a, b] of the shape at ordinate y, if any.
+        [[nodiscard]] inline static std::optional<std::pair<double, double>>
+          computeInterval(DGtal::ImplicitBall<Space_T> const & shape, double y);
+    };
+
+    template <class Space_T>
+    struct RowIntervalTraits<DGtal::ImplicitHyperCube<Space_T>>
+    {
+        static constexpr bool c_isClosedForm = true;
+
+        [[nodiscard]] inline static std::optional<std::pair<double, double>>
+          computeInterval(DGtal::ImplicitHyperCube<Space_T> const & shape, double y);
+    };
+
+    /// Gauss digitisation of a 2D shape, row by row.
+    /// Shapes with a closed-form row interval only evaluate the digitiser
+    /// at the ends of each run, the others are sampled every stride points along the rows
+    /// and the ends of their runs are bisected between two samples.
+    /// \tparam Space_T
+    template <class Space_T>
+    class ScanlineDigitizer
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef Space_T                   Space;
+        typedef typename Space::Integer   Integer;
+        typedef typename Space::Point     Point;
+        typedef typename Space::RealPoint RealPoint;
+        typedef DigitalSpans<Space>       Spans;
+        typedef typename Spans::Domain    Domain;
+
+        // sampling step along a row for shapes without a closed form, in points.
+        static constexpr Integer c_defaultStride = 8;
+
+        /** --------- methods ------------- **/
+        /// \param shape the shape attached to the digitiser.
+        /// \param dig
+        /// \param stride for shapes without a closed form, the digitiser is evaluated every stride points
+        ///        of a row, then about log2(stride) times at each end of a run.
+        ///        Every run and hole of at least stride points (stride grid steps wide) is found exactly.
+        ///        A thinner one may be missed when it lies between two samples, as near the rows tangent
+        ///        to a curved shape: 1 evaluates every point and is always exact.
+        /// \return
+        template <class Shape_T>
+        [[nodiscard]] static Spans
+          digitize(Shape_T const &                               shape,
+                   DGtal::GaussDigitizer<Space, Shape_T> const & dig,
+                   Integer                                       stride = c_defaultStride);
+
+       private:
+        /** --------- methods ------------- **/
+        template <class Shape_T>
+        static void
+          digitizeRowClosedForm(Spans &                                       spans,
+                                Shape_T const &                               shape,
+                                DGtal::GaussDigitizer<Space, Shape_T> const & dig,
+                                Integer                                       row);
+        template <class Shape_T>
+        static void
+          digitizeRowBisection(Spans &                                       spans,
+                               DGtal::GaussDigitizer<Space, Shape_T> const & dig,
+                               Integer                                       row,
+                               Integer                                       stride);
+    };
+}  // namespace td::util
+
+#include "ScanlineDigitizer.inl"
+
+#endif  // TD_UTIL_SCANLINEDIGITIZER_HPP
@@ -0,0 +1,320 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_SCANLINEDIGITIZER_INL
+#define TD_UTIL_SCANLINEDIGITIZER_INL
+
+#include <algorithm>
+#include <cmath>
+
+namespace td::util
+{
+    /** --------- DigitalSpans ------------- **/
+    template <class Space_T>
+    inline DigitalSpans<Space_T>::DigitalSpans(Domain const & domain)
+        : m_domain(domain), m_spans(), m_rowOffsets(1, 0), m_size(0)
+    {}
+
+    template <class Space_T>
+    DigitalSpans<Space_T>
+      DigitalSpans<Space_T>::fromPoints(Domain const & domain, std::vector<Point> points)
+    {
+        std::sort(points.begin(),
+                  points.end(),
+                  [](Point const & p, Point const & q) { return p[1] < q[1] || (p[1] == q[1] && p[0] < q[0]); });
+        DigitalSpans spans(domain);
+        auto         it = points.begin();
+        for (Integer row = domain.lowerBound()[1]; row <= domain.upperBound()[1]; ++row)
+        {
+            while (it != points.end() && (*it)[1] == row)
+            {
+                ASSERT(domain.isInside(*it));
+                // Extends the run while the next point is its right neighbour.
+                Integer const begin = (*it)[0];
+                Integer       end   = begin + 1;
+                for (++it; it != points.end() && (*it)[1] == row && (*it)[0] == end; ++it)
+                {
+                    ++end;
+                }
+                spans.addSpan(begin, end);
+            }
+            spans.closeRow();
+        }
+        return spans;
+    }
+
+    template <class Space_T>
+    inline void
+      DigitalSpans<Space_T>::addSpan(Integer begin, Integer end)
+    {
+        ASSERT(begin < end);
+        ASSERT(m_spans.size() == m_rowOffsets.back() || m_spans.back().end < begin);
+        m_spans.push_back({begin, end});
+        m_size += static_cast<std::size_t>(end - begin);
+    }
+
+    template <class Space_T>
+    inline void
+      DigitalSpans<Space_T>::closeRow()
+    {
+        m_rowOffsets.push_back(m_spans.size());
+    }
+
+    template <class Space_T>
+    inline bool
+      DigitalSpans<Space_T>::operator()(Point const & point) const
+    {
+        auto const [first, last] = getRow(point[1]);
+        // first run ending after the point.
+        Span const * it = std::upper_bound(
+          first, last, point[0], [](Integer x, Span const & span) -> bool { return x < span.end; });
+        return it != last && it->begin <= point[0];
+    }
+
+    template <class Space_T>
+    inline std::size_t
+      DigitalSpans<Space_T>::size() const
+    {
+        return m_size;
+    }
+
+    template <class Space_T>
+    inline typename DigitalSpans<Space_T>::Domain const &
+      DigitalSpans<Space_T>::domain() const
+    {
+        return m_domain;
+    }
+
+    template <class Space_T>
+    typename DigitalSpans<Space_T>::Domain
+      DigitalSpans<Space_T>::getBoundingBox() const
+    {
+        ASSERT(m_size > 0);
+        Point lower = m_domain.upperBound();
+        Point upper = m_domain.lowerBound();
+        for (std::size_t i = 0; i + 1 < m_rowOffsets.size(); ++i)
+        {
+            if (m_rowOffsets[i] == m_rowOffsets[i + 1])
+            {
+                continue;
+            }
+            Integer const row = m_domain.lowerBound()[1] + static_cast<Integer>(i);
+            // The runs of a row are sorted, the first one starts leftmost and the last one ends rightmost.
+            lower = lower.inf(Point(m_spans[m_rowOffsets[i]].begin, row));
+            upper = upper.sup(Point(m_spans[m_rowOffsets[i + 1] - 1].end - 1, row));
+        }
+        return Domain(lower, upper);
+    }
+
+    template <class Space_T>
+    inline std::pair<typename DigitalSpans<Space_T>::Span const *, typename DigitalSpans<Space_T>::Span const *>
+      DigitalSpans<Space_T>::getRow(Integer row) const
+    {
+        auto const index = static_cast<std::size_t>(row - m_domain.lowerBound()[1]);
+        // rows outside of the domain, or not closed yet, are empty.
+        if (row < m_domain.lowerBound()[1] || index + 1 >= m_rowOffsets.size())
+        {
+            return {nullptr, nullptr};
+        }
+        return {m_spans.data() + m_rowOffsets[index], m_spans.data() + m_rowOffsets[index + 1]};
+    }
+
+    template <class Space_T>
+    template <class DigitalSet_T>
+    void
+      DigitalSpans<Space_T>::insertInto(DigitalSet_T & set) const
+    {
+        for (std::size_t i = 0; i + 1 < m_rowOffsets.size(); ++i)
+        {
+            Integer const row = m_domain.lowerBound()[1] + static_cast<Integer>(i);
+            for (std::size_t j = m_rowOffsets[i]; j < m_rowOffsets[i + 1]; ++j)
+            {
+                for (Integer x = m_spans[j].begin; x < m_spans[j].end; ++x)
+                {
+                    set.insertNew(Point(x, row));
+                }
+            }
+        }
+    }
+
+    /** --------- RowIntervalTraits ------------- **/
+    template <class Space_T>
+    inline std::optional<std::pair<double, double>>
+      RowIntervalTraits<DGtal::ImplicitBall<Space_T>>::computeInterval(DGtal::ImplicitBall<Space_T> const & shape,
+                                                                       double                               y)
+    {
+        // centre and radius from the bounding box.
+        auto const   lower   = shape.getLowerBound();
+        auto const   upper   = shape.getUpperBound();
+        double const radius  = (upper[0] - lower[0]) / 2.;
+        double const centreX = (upper[0] + lower[0]) / 2.;
+        double const centreY = (upper[1] + lower[1]) / 2.;
+        double const dy      = y - centreY;
+        double const squared = radius * radius - dy * dy;
+        if (squared < 0.)
+        {
+            return std::nullopt;
+        }
+        double const halfWidth = std::sqrt(squared);
+        return std::make_pair(centreX - halfWidth, centreX + halfWidth);
+    }
+
+    template <class Space_T>
+    inline std::optional<std::pair<double, double>>
+      RowIntervalTraits<DGtal::ImplicitHyperCube<Space_T>>::computeInterval(
+        DGtal::ImplicitHyperCube<Space_T> const & shape,
+        double                                    y)
+    {
+        auto const lower = shape.getLowerBound();
+        auto const upper = shape.getUpperBound();
+        if (y < lower[1] || y > upper[1])
+        {
+            return std::nullopt;
+        }
+        return std::make_pair(static_cast<double>(lower[0]), static_cast<double>(upper[0]));
+    }
+
+    /** --------- ScanlineDigitizer ------------- **/
+    template <class Space_T>
+    template <class Shape_T>
+    typename ScanlineDigitizer<Space_T>::Spans
+      ScanlineDigitizer<Space_T>::digitize(Shape_T const &                               shape,
+                                           DGtal::GaussDigitizer<Space, Shape_T> const & dig,
+                                           Integer                                       stride)
+    {
+        ASSERT(stride > 0);
+        Domain const domain = dig.getDomain();
+        Spans        spans(domain);
+        for (Integer row = domain.lowerBound()[1]; row <= domain.upperBound()[1]; ++row)
+        {
+            if constexpr (RowIntervalTraits<Shape_T>::c_isClosedForm)
+            {
+                (void)stride;
+                digitizeRowClosedForm(spans, shape, dig, row);
+            }
+            else
+            {
+                (void)shape;
+                digitizeRowBisection(spans, dig, row, stride);
+            }
+            spans.closeRow();
+        }
+        return spans;
+    }
+
+    template <class Space_T>
+    template <class Shape_T>
+    void
+      ScanlineDigitizer<Space_T>::digitizeRowClosedForm(Spans &                                       spans,
+                                                        Shape_T const &                               shape,
+                                                        DGtal::GaussDigitizer<Space, Shape_T> const & dig,
+                                                        Integer                                       row)
+    {
+        Integer const xLower = spans.domain().lowerBound()[0];
+        Integer const xUpper = spans.domain().upperBound()[0];
+
+        // the embedding of the row gives its ordinate and the step along it.
+        RealPoint const origin = dig.embed(Point(0, row));
+        double const    step   = dig.embed(Point(1, row))[0] - origin[0];
+
+        auto const interval = RowIntervalTraits<Shape_T>::computeInterval(shape, origin[1]);
+        if (!interval.has_value())
+        {
+            // A row tangent to the shape may have no interval by rounding, and still points on the shape:
+            // the rows within a grid step of the bounding box are evaluated at every point.
+            double const yStep = dig.embed(Point(0, row + 1))[1] - origin[1];
+            if (origin[1] >= shape.getLowerBound()[1] - yStep && origin[1] <= shape.getUpperBound()[1] + yStep)
+            {
+                digitizeRowBisection(spans, dig, row, 1);
+            }
+            return;
+        }
+        // One more point on each side, the interval may be off by rounding.
+        auto begin = static_cast<Integer>(std::floor((interval->first - origin[0]) / step));
+        auto last  = static_cast<Integer>(std::ceil((interval->second - origin[0]) / step));
+        begin      = std::max(begin, xLower);
+        last       = std::min(last, xUpper);
+
+        // The digitiser has the final word at the ends of the run:
+        // rounding errors and points lying on the shape are settled here,
+        // so that the result is exactly the same as evaluating every point.
+        auto const isInside = [&dig, row](Integer x) -> bool { return dig(Point(x, row)); };
+        while (begin <= last && !isInside(begin))
+        {
+            ++begin;
+        }
+        while (last >= begin && !isInside(last))
+        {
+            --last;
+        }
+        if (begin > last)
+        {
+            return;
+        }
+        while (begin > xLower && isInside(begin - 1))
+        {
+            --begin;
+        }
+        while (last < xUpper && isInside(last + 1))
+        {
+            ++last;
+        }
+        spans.addSpan(begin, last + 1);
+    }
+
+    template <class Space_T>
+    template <class Shape_T>
+    void
+      ScanlineDigitizer<Space_T>::digitizeRowBisection(Spans &                                       spans,
+                                                       DGtal::GaussDigitizer<Space, Shape_T> const & dig,
+                                                       Integer                                       row,
+                                                       Integer                                       stride)
+    {
+        Integer const xLower   = spans.domain().lowerBound()[0];
+        Integer const xUpper   = spans.domain().upperBound()[0];
+        auto const    isInside = [&dig, row](Integer x) -> bool { return dig(Point(x, row)); };
+
+        bool    inside   = isInside(xLower);
+        Integer runBegin = xLower;
+        for (Integer x = xLower; x < xUpper;)
+        {
+            Integer const next       = std::min(x + stride, xUpper);
+            bool const    nextInside = isInside(next);
+            if (nextInside != inside)
+            {
+                // The first point with the new state lies in (x, next].
+                Integer low  = x;
+                Integer high = next;
+                while (high - low > 1)
+                {
+                    Integer const middle = low + (high - low) / 2;
+                    if (isInside(middle) == inside)
+                    {
+                        low = middle;
+                    }
+                    else
+                    {
+                        high = middle;
+                    }
+                }
+                if (nextInside)
+                {
+                    runBegin = high;
+                }
+                else
+                {
+                    spans.addSpan(runBegin, high);
+                }
+                inside = nextInside;
+            }
+            x = next;
+        }
+        if (inside)
+        {
+            spans.addSpan(runBegin, xUpper + 1);
+        }
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_SCANLINEDIGITIZER_INL
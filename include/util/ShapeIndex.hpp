@@ -0,0 +1,106 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_SHAPEINDEX_HPP
+#define TD_UTIL_SHAPEINDEX_HPP
+
+#include <util/CompositeDigitalObject.hpp>
+
+#include <array>
+#include <vector>
+
+namespace td::util
+{
+    /// Catalogue of shapes, searched by nearest signature first,
+    /// then re-ranked with the Hausdorff distance after alignment.
+    /// Shapes are the first component of composite objects (see cullAllButLargestComponent).
+    /// \tparam dimension
+    /// \tparam Topology_T
+    template <int dimension, class Topology_T>
+    class ShapeIndex
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef CompositeDigitalObject<dimension, Topology_T> CompositeObject;
+        typedef typename CompositeObject::Component           Component;
+        typedef typename CompositeObject::Alignment           Alignment;
+        typedef typename CompositeObject::RealPoint           RealPoint;
+        typedef typename Component::FloatScalar               FloatScalar;
+        typedef typename Component::Perimeter                 Perimeter;
+
+        // Signatures are stored in single precision, twice as many fit in a vector register.
+        typedef float Scalar;
+
+        static constexpr std::size_t c_numberFourier = 16;
+        static constexpr std::size_t c_numberHu      = 7;
+        // Fourier descriptors, Hu moments and circularity.
+        static constexpr std::size_t c_signatureSize = c_numberFourier + c_numberHu + 1;
+
+        typedef std::array<Scalar, c_signatureSize> Signature;
+
+        struct Match
+        {
+            std::size_t index;
+            // Distance between the signatures, each coordinate divided by its deviation over the index.
+            Scalar signatureDistance;
+            // Hausdorff distance after alignment, only set by findNearest.
+            Perimeter distance;
+        };
+
+        /** --------- methods ------------- **/
+        /// \param shape
+        /// \return index of the shape.
+        std::size_t
+          add(CompositeObject shape);
+
+        [[nodiscard]] inline std::size_t
+          size() const;
+
+        [[nodiscard]] inline CompositeObject const &
+          getShape(std::size_t index) const;
+
+        /// k nearest shapes by signature only.
+        /// \param signature
+        /// \param k
+        /// \return by increasing distance.
+        [[nodiscard]] std::vector<Match>
+          findNearestSignatures(Signature const & signature, std::size_t k) const;
+
+        /// k nearest shapes, the numberCandidates nearest signatures being re-ranked
+        /// by the Hausdorff distance of the best alignment found by CompositeObject::searchAlignments.
+        /// \param query
+        /// \param k
+        /// \param numberCandidates
+        /// \return by increasing Hausdorff distance.
+        [[nodiscard]] std::vector<Match>
+          findNearest(CompositeObject const & query, std::size_t k, std::size_t numberCandidates) const;
+
+        [[nodiscard]] static Signature
+          computeSignature(Component const & component);
+
+       private:
+        /** --------- methods ------------- **/
+        /// Inverse of the standard deviation of each coordinate over the index,
+        /// from the sums kept by add: queries only read them, from any number of threads.
+        void
+          computeScales();
+
+        /** --------- data ------------- **/
+        std::vector<CompositeObject> m_shapes;
+        // One array per coordinate of the signatures,
+        // so that the distances to a query are computed for many shapes at once.
+        std::array<std::vector<Scalar>, c_signatureSize> m_columns;
+
+        std::array<FloatScalar, c_signatureSize> m_sums {};
+        std::array<FloatScalar, c_signatureSize> m_sumsSquared {};
+        Signature                                m_scales {};
+
+        // Rotations tried when re-ranking.
+        static constexpr int c_numberAlignmentAngles = 36;
+    };
+}  // namespace td::util
+
+#include "ShapeIndex.inl"
+
+#endif  // TD_UTIL_SHAPEINDEX_HPP
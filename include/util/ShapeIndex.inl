@@ -0,0 +1,153 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_SHAPEINDEX_INL
+#define TD_UTIL_SHAPEINDEX_INL
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace td::util
+{
+    template <int dimension, class Topology_T>
+    std::size_t
+      ShapeIndex<dimension, Topology_T>::add(CompositeObject shape)
+    {
+        ASSERT(!shape.components.empty());
+        Signature const signature = computeSignature(shape.components.front());
+        for (std::size_t d = 0; d < c_signatureSize; ++d)
+        {
+            m_columns[d].push_back(signature[d]);
+            m_sums[d] += signature[d];
+            m_sumsSquared[d] += static_cast<FloatScalar>(signature[d]) * signature[d];
+        }
+        m_shapes.push_back(std::move(shape));
+        computeScales();
+        return m_shapes.size() - 1;
+    }
+
+    template <int dimension, class Topology_T>
+    inline std::size_t
+      ShapeIndex<dimension, Topology_T>::size() const
+    {
+        return m_shapes.size();
+    }
+
+    template <int dimension, class Topology_T>
+    inline typename ShapeIndex<dimension, Topology_T>::CompositeObject const &
+      ShapeIndex<dimension, Topology_T>::getShape(std::size_t index) const
+    {
+        return m_shapes.at(index);
+    }
+
+    template <int dimension, class Topology_T>
+    typename ShapeIndex<dimension, Topology_T>::Signature
+      ShapeIndex<dimension, Topology_T>::computeSignature(Component const & component)
+    {
+        Signature signature {};
+        std::vector<FloatScalar> const fourier = component.computeFourierDescriptors(c_numberFourier);
+        std::copy(fourier.begin(), fourier.end(), signature.begin());
+        // The Hu moments span many orders of magnitude, their logarithm is compared instead.
+        // The epsilon keeps the vanishing ones (symmetric shapes) finite. Their sign is dropped:
+        // it is noise for a vanishing moment, and would send it to either end of the coordinate.
+        static constexpr FloatScalar c_huEpsilon = 1e-12;
+        auto const                   hu          = component.computeHuMoments();
+        for (std::size_t i = 0; i < c_numberHu; ++i)
+        {
+            signature[c_numberFourier + i] = static_cast<Scalar>(-std::log10(std::abs(hu[i]) + c_huEpsilon));
+        }
+        signature[c_signatureSize - 1] = static_cast<Scalar>(component.getCircularity());
+        return signature;
+    }
+
+    template <int dimension, class Topology_T>
+    void
+      ShapeIndex<dimension, Topology_T>::computeScales()
+    {
+        auto const count = static_cast<FloatScalar>(m_shapes.size());
+        for (std::size_t d = 0; d < c_signatureSize; ++d)
+        {
+            FloatScalar const mean     = m_sums[d] / count;
+            FloatScalar const variance = m_sumsSquared[d] / count - mean * mean;
+            // constant coordinates do not discriminate anything, but should not divide by zero either.
+            m_scales[d] = variance > 0. ? static_cast<Scalar>(1. / std::sqrt(variance)) : 1.f;
+        }
+    }
+
+    template <int dimension, class Topology_T>
+    std::vector<typename ShapeIndex<dimension, Topology_T>::Match>
+      ShapeIndex<dimension, Topology_T>::findNearestSignatures(Signature const & signature, std::size_t k) const
+    {
+        std::size_t const  numberShapes = m_shapes.size();
+        std::vector<Scalar> distances(numberShapes, 0.f);
+        // Coordinate by coordinate: the inner loop runs over contiguous shapes
+        // and has no reduction, so it is vectorised as is.
+        for (std::size_t d = 0; d < c_signatureSize; ++d)
+        {
+            Scalar const         query  = signature[d];
+            Scalar const         scale  = m_scales[d];
+            Scalar const * const column = m_columns[d].data();
+            Scalar * const       out    = distances.data();
+            for (std::size_t i = 0; i < numberShapes; ++i)
+            {
+                Scalar const diff = (column[i] - query) * scale;
+                out[i] += diff * diff;
+            }
+        }
+
+        std::vector<std::size_t> order(numberShapes);
+        std::iota(order.begin(), order.end(), 0);
+        std::size_t const kept = std::min(k, numberShapes);
+        std::partial_sort(order.begin(),
+                          order.begin() + static_cast<std::ptrdiff_t>(kept),
+                          order.end(),
+                          [&distances](std::size_t i, std::size_t j) { return distances[i] < distances[j]; });
+
+        std::vector<Match> matches;
+        matches.reserve(kept);
+        for (std::size_t i = 0; i < kept; ++i)
+        {
+            matches.push_back({order[i], std::sqrt(distances[order[i]]), static_cast<Perimeter>(0.)});
+        }
+        return matches;
+    }
+
+    template <int dimension, class Topology_T>
+    std::vector<typename ShapeIndex<dimension, Topology_T>::Match>
+      ShapeIndex<dimension, Topology_T>::findNearest(CompositeObject const & query,
+                                                     std::size_t             k,
+                                                     std::size_t             numberCandidates) const
+    {
+        ASSERT(!query.components.empty());
+        std::vector<Match> matches =
+          findNearestSignatures(computeSignature(query.components.front()), std::max(k, numberCandidates));
+
+        // The signatures do not see the orientation, the exact distance does:
+        // each candidate is aligned first, rotating it about its centre onto the centre of the query.
+        auto const toReal = [](typename Component::Point const & point) { return RealPoint(point[0], point[1]); };
+        RealPoint const queryCentre = toReal(query.components.front().getGeometricCentre());
+        FloatScalar const pi        = maths<FloatScalar>::pi();
+        for (auto & match : matches)
+        {
+            CompositeObject const & shape       = m_shapes[match.index];
+            RealPoint const         shapeCentre = toReal(shape.components.front().getGeometricCentre());
+            std::vector<Alignment>  candidates;
+            candidates.reserve(c_numberAlignmentAngles);
+            for (int i = 0; i < c_numberAlignmentAngles; ++i)
+            {
+                FloatScalar const angle = 2. * pi * static_cast<FloatScalar>(i) / c_numberAlignmentAngles;
+                candidates.push_back({angle, shapeCentre, queryCentre - shapeCentre, 0.});
+            }
+            match.distance = query.searchAlignments(shape, std::move(candidates), 1).front().distance;
+        }
+        std::sort(matches.begin(),
+                  matches.end(),
+                  [](Match const & m1, Match const & m2) { return m1.distance < m2.distance; });
+        matches.resize(std::min(k, matches.size()));
+        return matches;
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_SHAPEINDEX_INL
@@ -0,0 +1,57 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_UNIFORMGRID2D_HPP
+#define TD_UTIL_UNIFORMGRID2D_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace td::util
+{
+    /// Spatial index of a fixed set of 2D points, bucketed in square cells.
+    /// Points are stored cell by cell, so that a query reads contiguous memory.
+    /// \tparam RealPoint_T point with two coordinates, accessed with operator[].
+    template <class RealPoint_T>
+    class UniformGrid2D
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef RealPoint_T                      RealPoint;
+        typedef typename RealPoint::Component    Scalar;
+
+        /** --------- methods ------------- **/
+        /// \param points must not be empty.
+        /// \param cellSize side of the cells, in the unit of the points.
+        inline UniformGrid2D(std::vector<RealPoint> const & points, Scalar cellSize);
+
+        /// Nearest point of the set, in L2 norm.
+        /// Rings of cells around the query are visited until no closer point can be found.
+        /// \param query may be outside of the grid.
+        /// \return
+        [[nodiscard]] RealPoint const &
+          findNearest(RealPoint const & query) const;
+
+        [[nodiscard]] inline std::size_t
+          size() const;
+
+       private:
+        /** --------- methods ------------- **/
+        [[nodiscard]] inline std::int32_t
+          getCellCoordinate(Scalar coordinate, int axis) const;
+
+        /** --------- data ------------- **/
+        Scalar       m_cellSize;
+        Scalar       m_origin[2];
+        std::int32_t m_width;
+        std::int32_t m_height;
+        // Points of cell i are m_points[m_cellOffsets[i], m_cellOffsets[i + 1]).
+        std::vector<std::uint32_t> m_cellOffsets;
+        std::vector<RealPoint>     m_points;
+    };
+}  // namespace td::util
+
+#include "UniformGrid2D.inl"
+
+#endif  // TD_UTIL_UNIFORMGRID2D_HPP
@@ -0,0 +1,113 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_UNIFORMGRID2D_INL
+#define TD_UTIL_UNIFORMGRID2D_INL
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace td::util
+{
+    template <class RealPoint_T>
+    inline UniformGrid2D<RealPoint_T>::UniformGrid2D(std::vector<RealPoint> const & points, Scalar cellSize)
+        : m_cellSize(cellSize), m_origin {}, m_width(1), m_height(1), m_cellOffsets(), m_points(points.size())
+    {
+        ASSERT(!points.empty() && cellSize > 0);
+        Scalar upper[2];
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            auto const [itMin, itMax] = std::minmax_element(points.begin(),
+                                                            points.end(),
+                                                            [axis](RealPoint const & p, RealPoint const & q)
+                                                            { return p[axis] < q[axis]; });
+            m_origin[axis] = (*itMin)[axis];
+            upper[axis]    = (*itMax)[axis];
+        }
+        m_width  = getCellCoordinate(upper[0], 0) + 1;
+        m_height = getCellCoordinate(upper[1], 1) + 1;
+
+        // Counting sort of the points by cell.
+        std::vector<std::uint32_t> cells(points.size());
+        m_cellOffsets.assign(static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height) + 1, 0);
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            cells[i] = static_cast<std::uint32_t>(getCellCoordinate(points[i][1], 1) * m_width
+                                                  + getCellCoordinate(points[i][0], 0));
+            ++m_cellOffsets[cells[i] + 1];
+        }
+        std::partial_sum(m_cellOffsets.begin(), m_cellOffsets.end(), m_cellOffsets.begin());
+        std::vector<std::uint32_t> fill(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            m_points[fill[cells[i]]++] = points[i];
+        }
+    }
+
+    template <class RealPoint_T>
+    typename UniformGrid2D<RealPoint_T>::RealPoint const &
+      UniformGrid2D<RealPoint_T>::findNearest(RealPoint const & query) const
+    {
+        std::int32_t const cx = std::clamp(getCellCoordinate(query[0], 0), 0, m_width - 1);
+        std::int32_t const cy = std::clamp(getCellCoordinate(query[1], 1), 0, m_height - 1);
+
+        Scalar           bestSquared = std::numeric_limits<Scalar>::max();
+        RealPoint const * best        = &m_points.front();
+        std::int32_t const maxRing    = std::max({cx, cy, m_width - 1 - cx, m_height - 1 - cy});
+        for (std::int32_t ring = 0; ring <= maxRing; ++ring)
+        {
+            for (std::int32_t y = std::max(cy - ring, 0); y <= std::min(cy + ring, m_height - 1); ++y)
+            {
+                // Inner rows of the ring only have their two end cells.
+                bool const         isEdgeRow = y == cy - ring || y == cy + ring;
+                std::int32_t const step      = isEdgeRow ? 1 : 2 * ring;
+                for (std::int32_t x = cx - ring; x <= cx + ring; x += std::max(step, 1))
+                {
+                    if (x < 0 || x >= m_width)
+                    {
+                        continue;
+                    }
+                    std::size_t const cell = static_cast<std::size_t>(y) * static_cast<std::size_t>(m_width)
+                                             + static_cast<std::size_t>(x);
+                    for (std::uint32_t i = m_cellOffsets[cell]; i < m_cellOffsets[cell + 1]; ++i)
+                    {
+                        Scalar const dx       = m_points[i][0] - query[0];
+                        Scalar const dy       = m_points[i][1] - query[1];
+                        Scalar const squared  = dx * dx + dy * dy;
+                        if (squared < bestSquared)
+                        {
+                            bestSquared = squared;
+                            best        = &m_points[i];
+                        }
+                    }
+                }
+            }
+            // Points of the next rings are at least ring * m_cellSize away from the query.
+            Scalar const reach = static_cast<Scalar>(ring) * m_cellSize;
+            if (bestSquared <= reach * reach)
+            {
+                break;
+            }
+        }
+        return *best;
+    }
+
+    template <class RealPoint_T>
+    inline std::size_t
+      UniformGrid2D<RealPoint_T>::size() const
+    {
+        return m_points.size();
+    }
+
+    template <class RealPoint_T>
+    inline std::int32_t
+      UniformGrid2D<RealPoint_T>::getCellCoordinate(Scalar coordinate, int axis) const
+    {
+        return static_cast<std::int32_t>(std::floor((coordinate - m_origin[axis]) / m_cellSize));
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_UNIFORMGRID2D_INL
@@ -5,6 +5,18 @@
 #ifndef TD_UTIL_COMMON_HPP
 #define TD_UTIL_COMMON_HPP
 
+#include <util/eigen.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/// Hint that the memory at an address will be read soon. Does nothing on compilers without the builtin.
+#if defined(__GNUC__) || defined(__clang__)
+#define TD_UTIL_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define TD_UTIL_PREFETCH(address) static_cast<void>(address)
+#endif
+
 namespace td::util
 {
     template <typename T>
@@ -51,18 +63,97 @@ namespace td::util
         template <int exponent>
         static constexpr T power(T val);
 
+        /// Pairwise sum of a buffer: the rounding error grows with log(count) rather than count.
+        /// The leaves are summed in independent lanes, which the compiler can vectorise.
+        /// \param data
+        /// \param count
+        /// \return
+        [[nodiscard]] static T
+          sumPairwise(T const * data, std::size_t count);
+
+        /// Largest element of a non-empty buffer, each element read once.
+        /// \param data
+        /// \param count
+        /// \return
+        [[nodiscard]] static T
+          maximum(T const * data, std::size_t count);
+
+       private:
+        // Independent accumulators of the reductions, a multiple of the SIMD width.
+        static constexpr std::size_t c_numberLanes = 8;
+        // Under this count, a buffer is summed without splitting it.
+        static constexpr std::size_t c_pairwiseBlockSize = 128;
+    };
+
+    /// Cross-covariance of pairs of points, accumulated one pair at a time.
+    /// No buffer of points is kept, the centroids are accumulated along.
+    /// \tparam T
+    /// \tparam dimension
+    template <typename T, int dimension>
+    class CovarianceAccumulator
+    {
+       public:
+        /** --------- typedefs ------------- **/
+        typedef Eigen::Matrix<T, dimension, dimension> Matrix;
+        typedef Eigen::Matrix<T, dimension, 1>         ColumnVector;
+
+        /** --------- methods ------------- **/
+        inline CovarianceAccumulator();
+
+        /// Adds the pair (p, q), p being the point to rotate onto q.
+        /// \tparam Point_T any point with operator[] (DGtal points, Eigen vectors...)
+        template <class Point_T>
+        inline void
+          add(Point_T const & p, Point_T const & q);
+
+        [[nodiscard]] inline std::size_t
+          size() const;
+
+        [[nodiscard]] inline ColumnVector
+          getFirstCentroid() const;
+        [[nodiscard]] inline ColumnVector
+          getSecondCentroid() const;
+
+        /// Sum of p q^T, without centring.
+        [[nodiscard]] inline Matrix
+          getRawCovariance() const;
+        /// Sum of (p - first centroid) (q - second centroid)^T.
+        [[nodiscard]] inline Matrix
+          getCentredCovariance() const;
+
+       private:
+        /** --------- data ------------- **/
+        std::size_t  m_count;
+        ColumnVector m_sum1;
+        ColumnVector m_sum2;
+        Matrix       m_sumProducts;
     };
 
     template <typename T>
     class algorithms
     {
        public:
+        template <int dimension>
+        using Matrix = Eigen::Matrix<T, dimension, dimension>;
+
         template <class Point_T>
         [[nodiscard]] inline static Eigen::Matrix<T, Point_T::dimension, Point_T::dimension>
         computeRotationKabsch(
           std::vector<Point_T> const & points1,
           std::vector<Point_T> const & points2);
 
+        /// Rotation R minimising the sum of |R p - q|^2, from the cross-covariance H = sum of p q^T.
+        /// Closed form in 2D, the quaternion of Horn in 3D, SVD otherwise.
+        /// \tparam dimension
+        /// \param h
+        /// \return
+        template <int dimension>
+        [[nodiscard]] inline static Matrix<dimension>
+          computeRotationKabsch(Matrix<dimension> const & h);
+
+        /// Rotation angle of the 2D solution, counterclockwise.
+        [[nodiscard]] inline static T
+          computeRotationAngleKabsch(Matrix<2> const & h);
     };
 }
 
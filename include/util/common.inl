@@ -5,6 +5,9 @@
 #ifndef TD_UTIL_COMMON_INL
 #define TD_UTIL_COMMON_INL
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <functional>
 #include <numeric>
 #include <type_traits>
@@ -106,6 +109,122 @@ namespace td::util
             return power<exponent - 1>(val) * val;
         }
     }
+    template <typename T>
+    T
+      maths<T>::sumPairwise(T const * data, std::size_t count)
+    {
+        if (count > c_pairwiseBlockSize)
+        {
+            // Halves rounded to whole lanes.
+            std::size_t const half = count / (2 * c_numberLanes) * c_numberLanes;
+            return sumPairwise(data, half) + sumPairwise(data + half, count - half);
+        }
+        std::array<T, c_numberLanes> lanes {};
+        std::size_t                  i = 0;
+        for (; i + c_numberLanes <= count; i += c_numberLanes)
+        {
+            for (std::size_t k = 0; k < c_numberLanes; ++k)
+            {
+                lanes[k] += data[i + k];
+            }
+        }
+        T sum = static_cast<T>(0);
+        for (; i < count; ++i)
+        {
+            sum += data[i];
+        }
+        // pairwise on the lanes too.
+        for (std::size_t width = c_numberLanes / 2; width > 0; width /= 2)
+        {
+            for (std::size_t k = 0; k < width; ++k)
+            {
+                lanes[k] += lanes[k + width];
+            }
+        }
+        return lanes[0] + sum;
+    }
+    template <typename T>
+    T
+      maths<T>::maximum(T const * data, std::size_t count)
+    {
+        ASSERT(count > 0);
+        std::array<T, c_numberLanes> lanes;
+        lanes.fill(data[0]);
+        std::size_t i = 0;
+        for (; i + c_numberLanes <= count; i += c_numberLanes)
+        {
+            for (std::size_t k = 0; k < c_numberLanes; ++k)
+            {
+                // no branch, so that it is vectorised.
+                lanes[k] = lanes[k] < data[i + k] ? data[i + k] : lanes[k];
+            }
+        }
+        T largest = *std::max_element(lanes.begin(), lanes.end());
+        for (; i < count; ++i)
+        {
+            largest = std::max(largest, data[i]);
+        }
+        return largest;
+    }
+
+    template <typename T, int dimension>
+    inline CovarianceAccumulator<T, dimension>::CovarianceAccumulator()
+        : m_count(0), m_sum1(ColumnVector::Zero()), m_sum2(ColumnVector::Zero()), m_sumProducts(Matrix::Zero())
+    {}
+
+    template <typename T, int dimension>
+    template <class Point_T>
+    inline void
+      CovarianceAccumulator<T, dimension>::add(Point_T const & p, Point_T const & q)
+    {
+        ColumnVector x;
+        ColumnVector y;
+        for (int k = 0; k < dimension; ++k)
+        {
+            x[k] = static_cast<T>(p[k]);
+            y[k] = static_cast<T>(q[k]);
+        }
+        m_sum1 += x;
+        m_sum2 += y;
+        m_sumProducts.noalias() += x * y.transpose();
+        ++m_count;
+    }
+
+    template <typename T, int dimension>
+    inline std::size_t
+      CovarianceAccumulator<T, dimension>::size() const
+    {
+        return m_count;
+    }
+
+    template <typename T, int dimension>
+    inline typename CovarianceAccumulator<T, dimension>::ColumnVector
+      CovarianceAccumulator<T, dimension>::getFirstCentroid() const
+    {
+        return m_sum1 / static_cast<T>(m_count);
+    }
+
+    template <typename T, int dimension>
+    inline typename CovarianceAccumulator<T, dimension>::ColumnVector
+      CovarianceAccumulator<T, dimension>::getSecondCentroid() const
+    {
+        return m_sum2 / static_cast<T>(m_count);
+    }
+
+    template <typename T, int dimension>
+    inline typename CovarianceAccumulator<T, dimension>::Matrix
+      CovarianceAccumulator<T, dimension>::getRawCovariance() const
+    {
+        return m_sumProducts;
+    }
+
+    template <typename T, int dimension>
+    inline typename CovarianceAccumulator<T, dimension>::Matrix
+      CovarianceAccumulator<T, dimension>::getCentredCovariance() const
+    {
+        // sum of (p - mp)(q - mq)^T = sum of p q^T - n mp mq^T
+        return m_sumProducts - m_sum1 * m_sum2.transpose() / static_cast<T>(m_count);
+    }
 
     template <typename T>
     template <class Point_T>
@@ -119,33 +238,74 @@ namespace td::util
 
         ASSERT(points1.size() == points2.size());
 
-        int constexpr dimension = Point_T::dimension;
-        typedef Eigen::Matrix<T, dimension, dimension> Matrix;
-
-        int const numberPoints = static_cast<int>(points1.size());
+        // compute H, as is: the points are not centred.
+        CovarianceAccumulator<T, Point_T::dimension> accumulator;
+        for (std::size_t i = 0; i < points1.size(); ++i)
+        {
+            accumulator.add(points1[i], points2[i]);
+        }
+        return computeRotationKabsch<Point_T::dimension>(accumulator.getRawCovariance());
+    }
 
-        // compute H
-        Eigen::Matrix<T, Eigen::Dynamic, dimension> p, q;
-        p.resize(numberPoints, dimension);
-        q.resize(numberPoints, dimension);
-        // fill p and q
-        for (int i = 0; i < numberPoints; ++i)
+    template <typename T>
+    template <int dimension>
+    inline typename algorithms<T>::template Matrix<dimension>
+    algorithms<T>::computeRotationKabsch(Matrix<dimension> const & h)
+    {
+        if constexpr (dimension == 2)
+        {
+            // (cos(angle), sin(angle)) is (H00 + H11, H01 - H10) normalised, see computeRotationAngleKabsch.
+            T const a = h(0, 0) + h(1, 1);
+            T const b = h(0, 1) - h(1, 0);
+            T const r = std::hypot(a, b);
+            if (r == T(0))
+            {
+                // every rotation is as good.
+                return Matrix<2>::Identity();
+            }
+            T const   c = a / r;
+            T const   s = b / r;
+            Matrix<2> rotation;
+            rotation << c, -s, s, c;
+            return rotation;
+        }
+        else if constexpr (dimension == 3)
         {
-            p.row(i) = EigenUtility::dgtalPointToColumnVector<Point_T>(points1[i]).transpose().template cast<T>();
-            q.row(i) = EigenUtility::dgtalPointToColumnVector<Point_T>(points2[i]).transpose().template cast<T>();
+            // Horn's method: the rotation is the unit quaternion maximising q^T N q,
+            // that is the eigenvector of the largest eigenvalue of N.
+            // see: B. K. P. Horn, Closed-form solution of absolute orientation using unit quaternions, 1987.
+            Eigen::Matrix<T, 4, 4> n;
+            n << h(0, 0) + h(1, 1) + h(2, 2), h(1, 2) - h(2, 1), h(2, 0) - h(0, 2), h(0, 1) - h(1, 0),
+                 h(1, 2) - h(2, 1), h(0, 0) - h(1, 1) - h(2, 2), h(0, 1) + h(1, 0), h(2, 0) + h(0, 2),
+                 h(2, 0) - h(0, 2), h(0, 1) + h(1, 0), -h(0, 0) + h(1, 1) - h(2, 2), h(1, 2) + h(2, 1),
+                 h(0, 1) - h(1, 0), h(2, 0) + h(0, 2), h(1, 2) + h(2, 1), -h(0, 0) - h(1, 1) + h(2, 2);
+            // Fixed size solver, no allocation. Eigenvalues are in increasing order.
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix<T, 4, 4>> solver(n);
+            Eigen::Matrix<T, 4, 1> const q = solver.eigenvectors().col(3);
+            return Eigen::Quaternion<T>(q[0], q[1], q[2], q[3]).toRotationMatrix();
         }
-        Matrix h = p.transpose() * q;
+        else
+        {
+            // Since we expect the dimension to be small, we can use JabobiSVD rather than BDCSVD
+            Eigen::JacobiSVD<Matrix<dimension>> svd;
+            svd.compute(h, Eigen::ComputeFullU | Eigen::ComputeFullV);
 
-        // Since we expect the dimension to be small, we can use JabobiSVD rather than BDCSVD
-        Eigen::JacobiSVD<Matrix> svd;
-        svd.compute(h, Eigen::ComputeFullU | Eigen::ComputeFullV);
+            int d = std::signbit((svd.matrixV() * svd.matrixU().transpose()).determinant()) ? -1 : 1;
+            Eigen::DiagonalMatrix<T, dimension> multiplier;
+            multiplier.setIdentity();
+            multiplier.diagonal()[dimension - 1] = static_cast<T>(d);
 
-        int d = std::signbit((svd.matrixV() * svd.matrixU().transpose()).determinant()) ? -1 : 1;
-        Eigen::DiagonalMatrix<T, dimension> multiplier;
-        multiplier.setIdentity();
-        multiplier.diagonal()[dimension - 1] = static_cast<T>(d);
+            return svd.matrixV() * multiplier * svd.matrixU().transpose();
+        }
+    }
 
-        return svd.matrixV() * multiplier * svd.matrixU().transpose();
+    template <typename T>
+    inline T
+      algorithms<T>::computeRotationAngleKabsch(Matrix<2> const & h)
+    {
+        // sum of q . R p = trace(R H) = cos(angle) (H00 + H11) + sin(angle) (H01 - H10),
+        // maximal for:
+        return std::atan2(h(0, 1) - h(1, 0), h(0, 0) + h(1, 1));
     }
 }  // namespace td::util
 
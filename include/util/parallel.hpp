@@ -0,0 +1,33 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_PARALLEL_HPP
+#define TD_UTIL_PARALLEL_HPP
+
+#include <cstddef>
+
+namespace td::util
+{
+    class parallel
+    {
+       public:
+        /// Calls function(i) for every i in [0, count),
+        /// each thread picking the next index from a shared counter.
+        /// \tparam Function
+        /// \param count
+        /// \param numberThreads 0 to use all hardware threads, 1 to run on the calling thread.
+        /// \param function must be safe to call concurrently for different indices.
+        template <class Function>
+        static void
+          forEach(std::size_t count, unsigned int numberThreads, Function const & function);
+
+        /// Number of threads actually used for count tasks.
+        [[nodiscard]] inline static unsigned int
+          getNumberThreads(std::size_t count, unsigned int numberThreads);
+    };
+}  // namespace td::util
+
+#include "parallel.inl"
+
+#endif  // TD_UTIL_PARALLEL_HPP
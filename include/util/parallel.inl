@@ -0,0 +1,61 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_UTIL_PARALLEL_INL
+#define TD_UTIL_PARALLEL_INL
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace td::util
+{
+    inline unsigned int
+      parallel::getNumberThreads(std::size_t count, unsigned int numberThreads)
+    {
+        if (numberThreads == 0)
+        {
+            numberThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        return static_cast<unsigned int>(std::min<std::size_t>(numberThreads, std::max<std::size_t>(count, 1)));
+    }
+
+    template <class Function>
+    void
+      parallel::forEach(std::size_t count, unsigned int numberThreads, Function const & function)
+    {
+        numberThreads = getNumberThreads(count, numberThreads);
+        if (numberThreads == 1)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                function(i);
+            }
+            return;
+        }
+        std::atomic<std::size_t> next {0};
+        auto const               work = [&next, count, &function]()
+        {
+            for (std::size_t i = next++; i < count; i = next++)
+            {
+                function(i);
+            }
+        };
+        std::vector<std::thread> threads;
+        threads.reserve(numberThreads - 1);
+        for (unsigned int t = 1; t < numberThreads; ++t)
+        {
+            threads.emplace_back(work);
+        }
+        // The calling thread works too.
+        work();
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+    }
+}  // namespace td::util
+
+#endif  // TD_UTIL_PARALLEL_INL
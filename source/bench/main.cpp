@@ -0,0 +1,536 @@
+#include <DGtal/base/Common.h>
+#include <DGtal/helpers/StdDefs.h>
+#include <DGtal/shapes/GaussDigitizer.h>
+#include <DGtal/shapes/ShapeFactory.h>
+
+#include <util/Benchmark.hpp>
+#include <util/CompositeDigitalObject.hpp>
+#include <util/DigitalComponent.hpp>
+#include <util/FlatTopology2D.hpp>
+#include <util/GrainFieldGenerator.hpp>
+#include <util/ScanlineDigitizer.hpp>
+#include <util/common.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+
+// Topology
+typedef DGtal::Z2i::DT4_8 DigitalTopology;
+static constexpr int dimension = 2;
+
+// Utility Classes.
+typedef td::util::DigitalComponent<dimension, DigitalTopology>       Component;
+typedef td::util::CompositeDigitalObject<dimension, DigitalTopology> CompositeObject;
+typedef typename CompositeObject::Image                              Image;
+typedef td::util::BenchmarkSuite                                     Suite;
+typedef td::util::BenchmarkState                                     State;
+template <typename T>
+using Maths = td::util::maths<T>;
+template <typename T>
+using Algorithms = td::util::algorithms<T>;
+
+typedef typename Component::Space       Space;
+typedef typename Component::Domain      Domain;
+typedef typename Component::Point       Point;
+typedef typename Component::Object      Object;
+typedef typename Component::PointSet    PointSet;
+typedef typename Component::FloatScalar FloatScalar;
+typedef typename Component::Perimeter   Perimeter;
+typedef typename Component::AngleRadian AngleRadian;
+typedef typename Space::RealPoint       RealPoint;
+typedef typename Space::RealVector      RealVector;
+
+// Euclidean shapes, same as TD1.
+typedef DGtal::ImplicitBall<Space>      Disc;
+typedef DGtal::ImplicitHyperCube<Space> Square;
+
+static constexpr char const * outputDirName = "res/bench/";
+
+// Inputs are generated here rather than read, so that every run measures the same thing.
+static constexpr unsigned int seed = 42;
+
+/// Gauss digitisation of a shape at unit grid step, over its bounding box and a margin.
+template <class Shape_T>
+Image
+  digitizeShape(Shape_T const & shape, typename Space::Integer margin)
+{
+    DGtal::GaussDigitizer<Space, Shape_T> dig;
+    dig.attach(shape);
+    dig.init(shape.getLowerBound(), shape.getUpperBound(), 1.);
+    Domain const domain(dig.getDomain().lowerBound() - Point::diagonal(margin),
+                        dig.getDomain().upperBound() + Point::diagonal(margin));
+    Image image(domain);
+    auto const spans = td::util::ScanlineDigitizer<Space>::digitize(shape, dig);
+    for (auto row = spans.domain().lowerBound()[1]; row <= spans.domain().upperBound()[1]; ++row)
+    {
+        auto const [first, last] = spans.getRow(row);
+        for (auto span = first; span != last; ++span)
+        {
+            for (auto x = span->begin; x < span->end; ++x)
+            {
+                image.setValue(Point(x, row), 255);
+            }
+        }
+    }
+    return image;
+}
+
+/// Square image of side `size`, covered by grains of random size and position.
+/// Some grains touch, they then form a single component, as in the rice images of TD2.
+Image
+  generateGrainField(typename Space::Integer size, unsigned int fieldSeed)
+{
+    td::util::GrainFieldGenerator::Parameters parameters;
+    parameters.width            = size;
+    parameters.height           = size;
+    parameters.numberGrains     = static_cast<std::size_t>(size) * static_cast<std::size_t>(size) / 1500;
+    parameters.touchingFraction = 0.1;
+    parameters.seed             = fieldSeed;
+    return td::util::GrainFieldGenerator(parameters).createImage<Image>();
+}
+
+/// Single component of a digitised shape.
+template <class Shape_T>
+Object
+  computeShapeObject(Shape_T const & shape)
+{
+    Image const        image = digitizeShape(shape, 0);
+    std::vector<Point> points;
+    for (auto const & point : image.domain())
+    {
+        if (image(point) != 0)
+        {
+            points.push_back(point);
+        }
+    }
+    // The domain of the object is its window, as for the components of a composite object.
+    Point lower = points.front();
+    Point upper = points.front();
+    for (auto const & point : points)
+    {
+        lower = lower.inf(point);
+        upper = upper.sup(point);
+    }
+    PointSet set(Domain(lower - Point::diagonal(), upper + Point::diagonal()));
+    set.insertNew(points.begin(), points.end());
+    return Object(DGtal::Z2i::dt4_8, set);
+}
+
+/// Geometry stages of a component, for a shape of growing radius.
+template <class Shape_T>
+void
+  addComponentBenchmarks(Suite & suite, std::string const & shapeName)
+{
+    std::vector<std::int64_t> const radii = {16, 64, 256};
+    auto const                      createShape = [](State const & state)
+    { return Shape_T(RealPoint(0, 0), static_cast<double>(state.getArgument())); };
+
+    // Boundary tracking, convex hull and segmentation of a new component.
+    suite.add("component/geometry/" + shapeName,
+              radii,
+              [createShape](State & state)
+              {
+                  Object const object = computeShapeObject(createShape(state));
+                  while (state.keepRunning())
+                  {
+                      state.pauseTiming();
+                      Component const component(object);
+                      state.resumeTiming();
+                      Suite::doNotOptimize(component.getCountPerimeter());
+                      Suite::doNotOptimize(component.getConvexHullPerimeter());
+                      Suite::doNotOptimize(component.getSegmentationPerimeter());
+                  }
+              });
+    // Each stage of the geometry alone, the stages it depends on being cached.
+    auto const addStage = [&suite, &shapeName, &radii, createShape](
+                            std::string const & name, Component::GeometryStage stage, auto const & query)
+    {
+        suite.add("component/geometry/" + name + "/" + shapeName,
+                  radii,
+                  [createShape, stage, query](State & state)
+                  {
+                      Component component(computeShapeObject(createShape(state)));
+                      while (state.keepRunning())
+                      {
+                          state.pauseTiming();
+                          component.invalidateGeometry(stage);
+                          if (stage != Component::GeometryStage::Boundary)
+                          {
+                              static_cast<void>(component.getCountPerimeter());
+                          }
+                          state.resumeTiming();
+                          Suite::doNotOptimize(query(component));
+                      }
+                  });
+    };
+    addStage("boundary",
+             Component::GeometryStage::Boundary,
+             [](Component const & component) { return component.getCountPerimeter(); });
+    addStage("convexHull",
+             Component::GeometryStage::ConvexHull,
+             [](Component const & component) { return component.getConvexHullPerimeter(); });
+    addStage("segmentation",
+             Component::GeometryStage::Segmentation,
+             [](Component const & component) { return component.getSegmentationPerimeter(); });
+    // Estimators, once the geometry is cached.
+    auto const addEstimator = [&suite, &shapeName, &radii, createShape](std::string const & name, auto const & estimate)
+    {
+        suite.add("component/" + name + "/" + shapeName,
+                  radii,
+                  [createShape, estimate](State & state)
+                  {
+                      Component const component(computeShapeObject(createShape(state)));
+                      Suite::doNotOptimize(estimate(component));
+                      while (state.keepRunning())
+                      {
+                          Suite::doNotOptimize(estimate(component));
+                      }
+                  });
+    };
+    addEstimator("convexHullArea", [](Component const & component) { return component.getConvexHullArea(); });
+    addEstimator("convexHullPerimeter",
+                 [](Component const & component) { return component.getConvexHullPerimeter(); });
+    addEstimator("segmentationArea", [](Component const & component) { return component.getSegmentationArea(); });
+    addEstimator("segmentationPerimeter",
+                 [](Component const & component) { return component.getSegmentationPerimeter(); });
+    addEstimator("convexHullShoelaceArea",
+                 [](Component const & component)
+                 { return component.getConvexHullArea(Component::PolygonArea::Shoelace); });
+    addEstimator("segmentationShoelaceArea",
+                 [](Component const & component)
+                 { return component.getSegmentationArea(Component::PolygonArea::Shoelace); });
+    addEstimator("momentsArea", [](Component const & component) { return component.getMomentsArea(); });
+}
+
+int
+  main(int argc, char ** argv)
+{
+    if (argc > 1 && std::string(argv[1]) == "--help")
+    {
+        std::cout << "usage: programme_name *([filter] *([minimum_seconds] *([repetitions])))" << std::endl;
+        return 0;
+    }
+    setlocale(LC_NUMERIC, "us_US");  // To prevent French local settings
+
+    std::string const filter      = argc > 1 ? argv[1] : "";
+    double const      minimumTime = argc > 2 ? std::stod(argv[2]) : 0.2;
+    std::size_t const repetitions = argc > 3 ? std::stoul(argv[3]) : 5;
+
+    std::filesystem::path const outputPath = std::filesystem::current_path().parent_path().append(outputDirName);
+    std::filesystem::create_directories(outputPath);
+
+    Suite suite(minimumTime, repetitions);
+
+    /// ---------------- Statistics ------------------------ //
+    std::vector<std::int64_t> const counts = {1 << 10, 1 << 16, 1 << 20};
+    auto const                      createValues = [](State const & state)
+    {
+        std::mt19937                           engine(seed);
+        std::uniform_real_distribution<double> distribution(0., 100.);
+        std::vector<double>                    values(static_cast<std::size_t>(state.getArgument()));
+        std::generate(values.begin(), values.end(), [&]() { return distribution(engine); });
+        return values;
+    };
+    suite.add("maths/average",
+              counts,
+              [createValues](State & state)
+              {
+                  std::vector<double> const values = createValues(state);
+                  while (state.keepRunning())
+                  {
+                      Suite::doNotOptimize(Maths<double>::average(values));
+                  }
+                  state.setItemsProcessed(state.getArgument() * static_cast<std::int64_t>(state.getIterations()));
+              });
+    suite.add("maths/standardDeviation",
+              counts,
+              [createValues](State & state)
+              {
+                  std::vector<double> const values = createValues(state);
+                  while (state.keepRunning())
+                  {
+                      Suite::doNotOptimize(Maths<double>::standardDeviation(values));
+                  }
+                  state.setItemsProcessed(state.getArgument() * static_cast<std::int64_t>(state.getIterations()));
+              });
+
+    /// ---------------- Registration ------------------------ //
+    suite.add("algorithms/computeRotationKabsch",
+              {16, 1 << 10, 1 << 16},
+              [](State & state)
+              {
+                  // Noisy rotation of a random cloud.
+                  std::mt19937                           engine(seed);
+                  std::uniform_real_distribution<double> coordinate(-100., 100.);
+                  std::normal_distribution<double>       noise(0., 0.5);
+                  double const                           angle = 0.3;
+                  std::vector<RealPoint>                 points1;
+                  std::vector<RealPoint>                 points2;
+                  for (std::int64_t i = 0; i < state.getArgument(); ++i)
+                  {
+                      RealPoint const p(coordinate(engine), coordinate(engine));
+                      points1.push_back(p);
+                      points2.emplace_back(std::cos(angle) * p[0] - std::sin(angle) * p[1] + noise(engine),
+                                           std::sin(angle) * p[0] + std::cos(angle) * p[1] + noise(engine));
+                  }
+                  while (state.keepRunning())
+                  {
+                      Suite::doNotOptimize(Algorithms<FloatScalar>::computeRotationKabsch(points1, points2));
+                  }
+                  state.setItemsProcessed(state.getArgument() * static_cast<std::int64_t>(state.getIterations()));
+              });
+
+    /// ---------------- Components ------------------------ //
+    addComponentBenchmarks<Disc>(suite, "disc");
+    addComponentBenchmarks<Square>(suite, "square");
+
+    /// ---------------- Composite objects ------------------------ //
+    std::vector<std::int64_t> const sizes = {256, 1024, 2048};
+    suite.add("composite/construct/grains",
+              sizes,
+              [](State & state)
+              {
+                  Image const image = generateGrainField(static_cast<typename Space::Integer>(state.getArgument()), seed);
+                  while (state.keepRunning())
+                  {
+                      state.pauseTiming();
+                      Image copy = image;
+                      state.resumeTiming();
+                      CompositeObject const composite(std::move(copy));
+                      Suite::doNotOptimize(composite.components.size());
+                  }
+                  state.setItemsProcessed(state.getArgument() * state.getArgument()
+                                          * static_cast<std::int64_t>(state.getIterations()));
+              });
+    // Labelling alone, on the raster and through the generic DGtal neighbourhoods,
+    // the object being built beforehand.
+    auto const addLabelling = [&suite, &sizes](std::string const & name, auto const & label)
+    {
+        suite.add("composite/" + name + "/grains",
+                  sizes,
+                  [label](State & state)
+                  {
+                      Image const image =
+                        generateGrainField(static_cast<typename Space::Integer>(state.getArgument()), seed);
+                      PointSet set(image.domain());
+                      for (auto const & point : image.domain())
+                      {
+                          if (image(point) != 0)
+                          {
+                              set.insertNew(point);
+                          }
+                      }
+                      Object const object(DGtal::Z2i::dt4_8, set);
+                      while (state.keepRunning())
+                      {
+                          Suite::doNotOptimize(label(object));
+                      }
+                      state.setItemsProcessed(static_cast<std::int64_t>(object.size())
+                                              * static_cast<std::int64_t>(state.getIterations()));
+                  });
+    };
+    addLabelling("labelFlat",
+                 [](Object const & object)
+                 {
+                     td::util::FlatMask2D const mask(object.pointSet());
+                     return td::util::FlatTopology2D<4>::labelComponents(mask).size();
+                 });
+    addLabelling("labelGeneric",
+                 [](Object const & object)
+                 {
+                     std::vector<Object> components;
+                     std::back_insert_iterator<std::vector<Object>> inserter(components);
+                     object.writeComponents(inserter);
+                     return components.size();
+                 });
+    // Rigid transforms rebuild the whole object from the transformed image.
+    auto const addTransform = [&suite](std::string const & name, auto const & transform)
+    {
+        suite.add("composite/" + name + "/grains",
+                  {256, 1024},
+                  [transform](State & state)
+                  {
+                      auto const            size = static_cast<typename Space::Integer>(state.getArgument());
+                      CompositeObject const composite(generateGrainField(size, seed));
+                      RealPoint const       centre(size / 2., size / 2.);
+                      RealVector const      translation(5., -3.);
+                      while (state.keepRunning())
+                      {
+                          state.pauseTiming();
+                          CompositeObject copy = composite;
+                          state.resumeTiming();
+                          transform(copy, centre, 0.3, translation);
+                          Suite::doNotOptimize(copy.components.size());
+                      }
+                  });
+    };
+    addTransform("transformRigidForward",
+                 [](CompositeObject & composite, RealPoint const & centre, double angle, RealVector const & translation)
+                 { composite.transformRigidForward(centre, angle, translation); });
+    addTransform("transformRigidBackward",
+                 [](CompositeObject & composite, RealPoint const & centre, double angle, RealVector const & translation)
+                 { composite.transformRigidBackward(centre, angle, translation); });
+    // Hull and calipers of every grain, the boundaries being already tracked.
+    suite.add("composite/calipers/grains",
+              {256, 1024},
+              [](State & state)
+              {
+                  CompositeObject const composite(
+                    generateGrainField(static_cast<typename Space::Integer>(state.getArgument()), seed));
+                  while (state.keepRunning())
+                  {
+                      state.pauseTiming();
+                      CompositeObject copy = composite;
+                      for (auto & component : copy.components)
+                      {
+                          component.invalidateGeometry(Component::GeometryStage::ConvexHull);
+                          static_cast<void>(component.getCountPerimeter());
+                      }
+                      state.resumeTiming();
+                      Suite::doNotOptimize(copy.computeCalipers().size());
+                  }
+                  state.setItemsProcessed(static_cast<std::int64_t>(composite.components.size())
+                                          * static_cast<std::int64_t>(state.getIterations()));
+              });
+    // Square patches of growing side in the middle of a large field, erased then restored:
+    // the cost should follow the side of the patch, not the size of the field.
+    suite.add("composite/applyPatch/grains",
+              {8, 32, 128},
+              [](State & state)
+              {
+                  typename Space::Integer const size = 2048;
+                  Image const                   image = generateGrainField(size, seed);
+                  CompositeObject               composite(image);
+                  Point const  lower(size / 2, size / 2);
+                  Domain const region(lower, lower + Point::diagonal(state.getArgument() - 1));
+                  Image        erased(image);
+                  for (auto const & point : region)
+                  {
+                      erased.setValue(point, 0);
+                  }
+                  bool isErased = false;
+                  while (state.keepRunning())
+                  {
+                      isErased = !isErased;
+                      Suite::doNotOptimize(composite.applyPatch(region, isErased ? erased : image));
+                  }
+                  state.setItemsProcessed(state.getArgument() * state.getArgument()
+                                          * static_cast<std::int64_t>(state.getIterations()));
+              });
+
+    /// ---------------- Distances ------------------------ //
+    // Between a disc and a square of the same size, in images of the same domain.
+    auto const createShapePair = [](State const & state)
+    {
+        auto const   r = static_cast<double>(state.getArgument());
+        Image const  disc = digitizeShape(Disc(RealPoint(0, 0), r), 4);
+        Image        square(disc.domain());
+        Image const  squareShape = digitizeShape(Square(RealPoint(0, 0), r * 0.8), 0);
+        for (auto const & point : squareShape.domain())
+        {
+            square.setValue(point, squareShape(point));
+        }
+        return std::make_pair(CompositeObject(disc), CompositeObject(square));
+    };
+    // From transforms within L1 to transforms of about 34 MB (radius 1024), far beyond L2:
+    // the points are gathered along the rows of the transform, so the time should stay linear in the points.
+    std::vector<std::int64_t> const radii = {16, 64, 256, 1024};
+    suite.add("composite/hausdorff/disc_square",
+              radii,
+              [createShapePair](State & state)
+              {
+                  auto const [first, second] = createShapePair(state);
+                  while (state.keepRunning())
+                  {
+                      Suite::doNotOptimize(first.computeHausdorffDistance(second));
+                  }
+                  state.setItemsProcessed(
+                    static_cast<std::int64_t>(first.components.front().getPointSet().size()
+                                              + second.components.front().getPointSet().size())
+                    * static_cast<std::int64_t>(state.getIterations()));
+              });
+    suite.add("composite/dubuissonJain/disc_square",
+              radii,
+              [createShapePair](State & state)
+              {
+                  auto const [first, second] = createShapePair(state);
+                  while (state.keepRunning())
+                  {
+                      Suite::doNotOptimize(first.computeDubuissonJainDissimilarity(second));
+                  }
+                  state.setItemsProcessed(
+                    static_cast<std::int64_t>(first.components.front().getPointSet().size()
+                                              + second.components.front().getPointSet().size())
+                    * static_cast<std::int64_t>(state.getIterations()));
+              });
+
+    // Candidate rotations of a square onto a disc, pruned through the pyramids or all evaluated at full resolution.
+    // The pyramids are built before timing, as they are once per object.
+    auto const createAlignmentCandidates = [](State const & state)
+    {
+        std::vector<CompositeObject::Alignment> candidates;
+        for (std::int64_t k = 0; k < state.getArgument(); ++k)
+        {
+            AngleRadian const angle = 2. * Maths<FloatScalar>::pi() * static_cast<FloatScalar>(k)
+                                      / static_cast<FloatScalar>(state.getArgument());
+            candidates.push_back({angle, RealPoint(0, 0), RealVector(static_cast<double>(k % 5) - 2., 0.), 0.});
+        }
+        return candidates;
+    };
+    auto const createAlignmentPair = []()
+    {
+        Image const disc = digitizeShape(Disc(RealPoint(0, 0), 256.), 4);
+        Image       square(disc.domain());
+        Image const squareShape = digitizeShape(Square(RealPoint(0, 0), 200.), 0);
+        for (auto const & point : squareShape.domain())
+        {
+            square.setValue(point, squareShape(point));
+        }
+        auto pair = std::make_pair(CompositeObject(disc), CompositeObject(square));
+        static_cast<void>(pair.first.getPyramid());
+        static_cast<void>(pair.second.getPyramid());
+        return pair;
+    };
+    std::vector<std::int64_t> const numberCandidates = {16, 64, 256};
+    suite.add("composite/searchAlignments/disc_square",
+              numberCandidates,
+              [createAlignmentCandidates, createAlignmentPair](State & state)
+              {
+                  auto const [first, second] = createAlignmentPair();
+                  auto const candidates      = createAlignmentCandidates(state);
+                  while (state.keepRunning())
+                  {
+                      Suite::doNotOptimize(first.searchAlignments(second, candidates).front().distance);
+                  }
+                  state.setItemsProcessed(state.getArgument() * static_cast<std::int64_t>(state.getIterations()));
+              });
+    suite.add("composite/exhaustiveAlignments/disc_square",
+              numberCandidates,
+              [createAlignmentCandidates, createAlignmentPair](State & state)
+              {
+                  auto const [first, second] = createAlignmentPair();
+                  auto const candidates      = createAlignmentCandidates(state);
+                  while (state.keepRunning())
+                  {
+                      Perimeter best = std::numeric_limits<Perimeter>::infinity();
+                      for (auto const & candidate : candidates)
+                      {
+                          best = std::min(best, first.computeHausdorffDistance(second, candidate, 0));
+                      }
+                      Suite::doNotOptimize(best);
+                  }
+                  state.setItemsProcessed(state.getArgument() * static_cast<std::int64_t>(state.getIterations()));
+              });
+
+    auto const results = suite.run(filter, std::cout);
+    {
+        std::ofstream fs(outputPath / "bench.json");
+        Suite::writeJson(fs, results);
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <DGtal/base/Common.h>
+#include <DGtal/helpers/StdDefs.h>
+
+#include <util/GrainFieldGenerator.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+typedef td::util::GrainFieldGenerator Generator;
+
+int
+  main(int argc, char ** argv)
+{
+    if (argc < 5)
+    {
+        std::cout << "usage: programme_name [mask.pgm] [width] [height] [number_grains] "
+                     "*([seed] [mean_radius] [touching_fraction] [rim_fraction] [noise])"
+                  << std::endl;
+        return 0;
+    }
+    setlocale(LC_NUMERIC, "us_US");  // To prevent French local settings
+
+    std::filesystem::path const path = argv[1];
+    Generator::Parameters       parameters;
+    parameters.width        = std::stoi(argv[2]);
+    parameters.height       = std::stoi(argv[3]);
+    parameters.numberGrains = std::stoul(argv[4]);
+    if (argc > 5)
+    {
+        parameters.seed = std::stoull(argv[5]);
+    }
+    if (argc > 6)
+    {
+        parameters.meanRadius    = std::stod(argv[6]);
+        parameters.maximumRadius = 3. * parameters.meanRadius;
+        parameters.minimumRadius = std::min(parameters.minimumRadius, parameters.meanRadius);
+    }
+    if (argc > 7)
+    {
+        parameters.touchingFraction = std::stod(argv[7]);
+    }
+    if (argc > 8)
+    {
+        parameters.rimFraction = std::stod(argv[8]);
+    }
+    if (argc > 9)
+    {
+        parameters.noise = std::stod(argv[9]);
+    }
+
+    auto const      start = std::chrono::steady_clock::now();
+    Generator const generator(parameters);
+    std::chrono::duration<double> const placement = std::chrono::steady_clock::now() - start;
+    std::cout << "grains: " << generator.getGrains().size() << " of " << parameters.numberGrains << " ("
+              << placement.count() << " s)" << std::endl;
+
+    generator.writePGM(path);
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "written " << path << " (" << elapsed.count() << " s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <DGtal/base/Common.h>
+#include <DGtal/helpers/StdDefs.h>
+#include <DGtal/shapes/ShapeFactory.h>
+
+#include <util/MultigridBenchmark.hpp>
+#include <util/common.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// Euclidean shapes, same as TD1.
+typedef DGtal::ImplicitBall<DGtal::Z2i::Space>      Disc;
+typedef DGtal::ImplicitHyperCube<DGtal::Z2i::Space> Square;
+
+typedef td::util::MultigridBenchmark<Disc>   DiscBenchmark;
+typedef td::util::MultigridBenchmark<Square> SquareBenchmark;
+template <typename T>
+using Maths = td::util::maths<T>;
+
+typedef typename DiscBenchmark::Area      Area;
+typedef typename DiscBenchmark::Perimeter Perimeter;
+typedef typename DiscBenchmark::Point     Point;
+
+static constexpr char const * outputDirName = "res/multigrid/";
+
+int
+  main(int argc, char ** argv)
+{
+    if (argc < 4)
+    {
+        std::cout << "usage: programme_name [h_max] [h_min] [number_steps] *([number_threads])" << std::endl;
+        return 0;
+    }
+    setlocale(LC_NUMERIC, "us_US");  // To prevent French local settings
+
+    double const       hMax          = std::stod(argv[1]);
+    double const       hMin          = std::stod(argv[2]);
+    int const          numberSteps   = std::stoi(argv[3]);
+    unsigned int const numberThreads = argc > 4 ? static_cast<unsigned int>(std::stoul(argv[4])) : 0;
+
+    std::filesystem::path const outputPath = std::filesystem::current_path().parent_path().append(outputDirName);
+    std::filesystem::create_directories(outputPath);
+
+    static constexpr double discRadius      = 10;
+    static constexpr double squareHalfWidth = 5;
+    Point const             centre(0, 0);
+
+    Perimeter const pi = Maths<Perimeter>::pi();
+    DiscBenchmark   discBenchmark(
+      "disc", Disc(centre, discRadius), pi * discRadius * discRadius, 2 * pi * discRadius);
+    SquareBenchmark squareBenchmark(
+      "square", Square(centre, squareHalfWidth), 4 * squareHalfWidth * squareHalfWidth, 8 * squareHalfWidth);
+
+    std::vector<double> const gridSteps = DiscBenchmark::computeGridSteps(hMax, hMin, numberSteps);
+
+    auto const discSamples   = discBenchmark.run(gridSteps, numberThreads);
+    auto const squareSamples = squareBenchmark.run(gridSteps, numberThreads);
+
+    {
+        std::ofstream fs(outputPath / "convergence.csv");
+        discBenchmark.writeCsv(fs, discSamples);
+        squareBenchmark.writeCsv(fs, squareSamples, false);
+    }
+    {
+        std::ofstream fs(outputPath / "convergence.json");
+        fs << "[\n";
+        discBenchmark.writeJson(fs, discSamples);
+        fs << ",\n";
+        squareBenchmark.writeJson(fs, squareSamples);
+        fs << "]\n";
+    }
+    // Also keep a human readable summary.
+    discBenchmark.writeCsv(std::cout, discSamples);
+    squareBenchmark.writeCsv(std::cout, squareSamples, false);
+
+    return 0;
+}
@@ -18,7 +18,11 @@
 #include "DGtal/io/boards/Board2D.h"
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <util/DrawingWriter.hpp>
+#include <util/ScanlineDigitizer.hpp>
+
 #include <filesystem>
+#include <optional>
 
 using namespace DGtal;
 
@@ -28,8 +32,8 @@ typedef ImplicitHyperCube<Z2i::Space> Square;
 // Digitalised shapes
 template <class Shape>
 using Digital = GaussDigitizer<Z2i::Space, Shape>;
-// set of points in digital shape
-typedef Z2i::DigitalSet DigitalSet;
+// row by row digitisation
+typedef td::util::ScanlineDigitizer<Z2i::Space> ScanlineDigitizer;
 // Khalimsky Space
 typedef Z2i::Domain Domain;
 typedef Z2i::KSpace KSpace;
@@ -66,9 +70,9 @@ Digital<Shape>
     return dig;
 }
 
-template <class Shape, class Adjacency>
+template <class Shape, class PointPredicate, class Adjacency>
 Boundary
-  getDigitalShapeBoundary(Digital<Shape> const & dig, Adjacency const & adj)
+  getDigitalShapeBoundary(Digital<Shape> const & dig, PointPredicate const & predicate, Adjacency const & adj)
 {
     // make a Kovalevsky-Khalimsky space
     Z2i::KSpace ks;
@@ -78,10 +82,10 @@ Boundary
     );
 
     // search for one boundary element
-    Z2i::SCell bel = Surfaces<Z2i::KSpace>::findABel(ks, dig, 1000);
+    Z2i::SCell bel = Surfaces<Z2i::KSpace>::findABel(ks, predicate, 1000);
     // boundary tracking
     std::vector<Z2i::Point> boundaryPoints;
-    Surfaces<Z2i::KSpace>::track2DBoundaryPoints(boundaryPoints, ks, adj, dig, bel);
+    Surfaces<Z2i::KSpace>::track2DBoundaryPoints(boundaryPoints, ks, adj, predicate, bel);
 
     Z2i::Curve c;
     c.initFromVector(boundaryPoints);
@@ -90,14 +94,23 @@ Boundary
 }
 
 void
-  saveThisOrElse(Board2D const & board, std::string const & outFilePath)
+  saveThisOrElse(td::util::DrawingWriter & writer, Board2D board, std::string const & outFilePath)
 {
-    board.saveCairo((outFilePath + ".pdf").c_str(), Board2D::CairoPDF);
-    board.saveCairo((outFilePath + ".png").c_str(), Board2D::CairoPNG);
+    // Both formats are rendered in the background, from the same board.
+    auto const shared = std::make_shared<Board2D const>(std::move(board));
+#ifdef WITH_CAIRO
+    writer.save(shared, outFilePath + ".pdf");
+    writer.save(shared, outFilePath + ".png");
+#else
+    writer.save(shared, outFilePath + ".eps");
+    writer.save(shared, outFilePath + ".svg");
+#endif
 }
 
 void
-  drawDigitalShapeBoundaries(std::vector<Boundary> const & boundaries, std::string const & outFilePath)
+  drawDigitalShapeBoundaries(td::util::DrawingWriter &     writer,
+                             std::vector<Boundary> const & boundaries,
+                             std::string const &           outFilePath)
 {
     // draw a boundaries and make PNG and PDF files
     Board2D board;
@@ -105,37 +118,75 @@ void
     {
         board << boundary;
     }
-    saveThisOrElse(board, outFilePath);
+    saveThisOrElse(writer, std::move(board), outFilePath);
 }
 
-/// STEP 2 ////////////////////////////////////////////////////////////////////////////
+ConvexHull
+  getDigitalShapeConvexHull(Boundary const & boundary);
 
+/// Everything measured on one digitisation of a shape.
+/// The shape is digitised and its boundary tracked once, at construction,
+/// the convex hull is only computed when first asked for.
+/// \tparam Shape
 template <class Shape>
-DigitalSet
-  getDigitalShapeSet(Digital<Shape> const & dig)
+class DigitalShapeGeometry
 {
-    Domain     domain = dig.getDomain();
-    DigitalSet set(domain);
-    // I'm sure there's a much better way of doing this, but I can't find it.
-    // Create the set from the digital shape
-    for (auto const & point : domain)
+   public:
+    /// \param shape must outlive the geometry, the digitiser is attached to it.
+    /// \param h grid step
+    /// \param adj
+    DigitalShapeGeometry(Shape const & shape, double h, SurfelAdjacency<2> const & adj)
+        : m_dig(createDigitalShape(shape, h)),
+          m_spans(ScanlineDigitizer::digitize(shape, m_dig)),
+          m_boundary(getDigitalShapeBoundary(m_dig, m_spans, adj))
+    {}
+
+    [[nodiscard]] typename Digital<Shape>::Space::RealPoint
+      getGridSteps() const
+    {
+        return m_dig.gridSteps();
+    }
+
+    [[nodiscard]] ScanlineDigitizer::Spans const &
+      getSpans() const
     {
-        if (dig(point))
+        return m_spans;
+    }
+
+    [[nodiscard]] Boundary const &
+      getBoundary() const
+    {
+        return m_boundary;
+    }
+
+    [[nodiscard]] ConvexHull const &
+      getConvexHull() const
+    {
+        if (!m_convexHull.has_value())
         {
-            set.insertNew(point);
+            m_convexHull = getDigitalShapeConvexHull(m_boundary);
         }
+        return m_convexHull.value();
     }
-    return set;
-}
+
+   private:
+    Digital<Shape>           m_dig;
+    ScanlineDigitizer::Spans m_spans;
+    Boundary                 m_boundary;
+    // Computed if needed.
+    std::optional<ConvexHull> mutable m_convexHull;
+};
+
+/// STEP 2 ////////////////////////////////////////////////////////////////////////////
 
 template <class Shape>
 Area
-  getDigitalShapeArea(Digital<Shape> const & dig)
+  getDigitalShapeArea(DigitalShapeGeometry<Shape> const & geometry)
 {
     // Get the number of (2-cells) of the digital shape
-    DigitalSet const                                set       = getDigitalShapeSet(dig);
-    typename Digital<Shape>::Space::RealPoint const gridSteps = dig.gridSteps();
-    std::size_t                                     n         = set.size();
+    // No need for the set itself, the rows are enough.
+    typename Digital<Shape>::Space::RealPoint const gridSteps = geometry.getGridSteps();
+    std::size_t                                     n         = geometry.getSpans().size();
     Area                                            a         = static_cast<Area>(n);
     // multiply by the surface of each cell.
     for (auto coord : gridSteps)
@@ -157,13 +208,13 @@ Area
     return halfWidth * halfWidth * 4;
 }
 
-template <class Shape, class Adjacency>
+template <class Shape>
 Perimeter
-  getDigitalShapePerimeter(Digital<Shape> const & dig, Adjacency const & adj)
+  getDigitalShapePerimeter(DigitalShapeGeometry<Shape> const & geometry)
 {
     // Get the boundary of the digital shape.
-    Boundary const                                  boundary  = getDigitalShapeBoundary(dig, adj);
-    typename Digital<Shape>::Space::RealPoint const gridSteps = dig.gridSteps();
+    Boundary const &                                boundary  = geometry.getBoundary();
+    typename Digital<Shape>::Space::RealPoint const gridSteps = geometry.getGridSteps();
     Perimeter                                       l         = 0;
     for (auto const & [point, vector] : boundary.getArrowsRange())
     {
@@ -196,14 +247,12 @@ Perimeter
 
 /// STEP 4 ////////////////////////////////////////////////////////////////////////////
 
-template <class Shape, class Adjacency>
 ConvexHull
-  getDigitalShapeConvexHull(Digital<Shape> const & dig, Adjacency const & adj)
+  getDigitalShapeConvexHull(Boundary const & boundary)
 {
     // make a convex hull
     OrientationFunctor functor;
     ConvexHull         convexHull(functor);
-    Boundary           boundary = getDigitalShapeBoundary(dig, adj);
 
     // Iterate over the boundary points
     for (auto const & p : boundary.getPointsRange())
@@ -214,11 +263,13 @@ ConvexHull
     return convexHull;
 }
 
-template <class Shape, class Adjacency>
+template <class Shape>
 void
-  drawDigitalShapeConvexHull(Digital<Shape> const & dig, Adjacency const & adj, std::string const & outFilePath)
+  drawDigitalShapeConvexHull(td::util::DrawingWriter &           writer,
+                             DigitalShapeGeometry<Shape> const & geometry,
+                             std::string const &                 outFilePath)
 {
-    ConvexHull convexHull = getDigitalShapeConvexHull(dig, adj);
+    ConvexHull const & convexHull = geometry.getConvexHull();
     // scan the CVX points and draw the edges
     Board2D      board;
     auto         it    = convexHull.begin();
@@ -238,17 +289,17 @@ void
     }
 
     // make PNG and PDF files
-    saveThisOrElse(board, outFilePath);
+    saveThisOrElse(writer, std::move(board), outFilePath);
 }
 
 /// STEP 5 ////////////////////////////////////////////////////////////////////////////
-template <class Shape, class Adjacency>
+template <class Shape>
 Area
-  getConvexHullArea(Digital<Shape> const & dig, Adjacency adj)
+  getConvexHullArea(DigitalShapeGeometry<Shape> const & geometry)
 {
     // Get the convex hull
-    ConvexHull                                      convexHull = getDigitalShapeConvexHull(dig, adj);
-    typename Digital<Shape>::Space::RealPoint const gridSteps  = dig.gridSteps();
+    ConvexHull const &                              convexHull = geometry.getConvexHull();
+    typename Digital<Shape>::Space::RealPoint const gridSteps  = geometry.getGridSteps();
     Area                                            a          = 0;
     auto                                            it         = convexHull.begin();
     DigitalPoint                                    first      = *it;
@@ -276,14 +327,14 @@ Area
     return a;
 }
 
-template <class Shape, class Adjacency>
+template <class Shape>
 Perimeter
-  getConvexHullPerimeter(Digital<Shape> const & dig, Adjacency const & adj)
+  getConvexHullPerimeter(DigitalShapeGeometry<Shape> const & geometry)
 {
     // Get the boundary of the digital shape.
-    ConvexHull convexHull = getDigitalShapeConvexHull(dig, adj);
+    ConvexHull const & convexHull = geometry.getConvexHull();
     // multiply by the surface of each cell.
-    typename Digital<Shape>::Space::RealPoint gridSteps = dig.gridSteps();
+    typename Digital<Shape>::Space::RealPoint gridSteps = geometry.getGridSteps();
     Perimeter                                 l         = 0;
     auto                                      it        = convexHull.begin();
     DigitalPoint                              first     = *it;
@@ -332,28 +383,45 @@ int
     Perimeter squarePerimeter = getSquarePerimeter(squareHalfWidth);
 
     // Gauss discretisation
-    double          h              = 1.;  // gridStep
-    double          hHighRes       = 0.1;
-    Digital<Disc>   discDig        = createDigitalShape(disc, h);
-    Digital<Disc>   discDigHighRes = createDigitalShape(disc, hHighRes);
-    Digital<Square> squareDig      = createDigitalShape(square, h);
+    // Each digitisation is tracked once, and shared by all the steps.
+    double h        = 1.;  // gridStep
+    double hHighRes = 0.1;
 
     // Adjacency (4-connectivity)
     SurfelAdjacency<2> adj(true);
 
+    DigitalShapeGeometry<Disc> const   discGeometry(disc, h, adj);
+    DigitalShapeGeometry<Disc> const   discGeometryHighRes(disc, hHighRes, adj);
+    DigitalShapeGeometry<Square> const squareGeometry(square, h, adj);
+
+    // discs and squares of increasing resolutions
+    static constexpr int                      numberSteps = 20;
+    std::vector<DigitalShapeGeometry<Disc>>   discGeometries;
+    std::vector<DigitalShapeGeometry<Square>> squareGeometries;
+    discGeometries.reserve(numberSteps);
+    squareGeometries.reserve(numberSteps);
+    for (int i = 0; i < numberSteps; ++i)
+    {
+        double gridStep = numberSteps / static_cast<double>(i + 1);
+        discGeometries.emplace_back(disc, gridStep, adj);
+        squareGeometries.emplace_back(square, gridStep, adj);
+    }
+
     std::filesystem::path  outputPath = std::filesystem::current_path().parent_path() / outputDirName;
 
     /// STEP 2 ////////////////////////////////////////////////////////////////////////////
     std::vector<Boundary> boundaries;
     // disc
-    boundaries.push_back(getDigitalShapeBoundary(discDig, adj));
-    drawDigitalShapeBoundaries(boundaries, outputPath / "DiscBoundary");
+    boundaries.push_back(discGeometry.getBoundary());
+    // Two threads, one per format of a board.
+    td::util::DrawingWriter writer(2);
+    drawDigitalShapeBoundaries(writer, boundaries, outputPath / "DiscBoundary");
     // high-resolution disc
-    boundaries.push_back(getDigitalShapeBoundary(discDigHighRes, adj));
+    boundaries.push_back(discGeometryHighRes.getBoundary());
     // square
-    boundaries.push_back(getDigitalShapeBoundary(squareDig, adj));
+    boundaries.push_back(squareGeometry.getBoundary());
 
-    drawDigitalShapeBoundaries(boundaries, outputPath / "Boundaries");
+    drawDigitalShapeBoundaries(writer, boundaries, outputPath / "Boundaries");
 
     /// STEP 3 ////////////////////////////////////////////////////////////////////////////
     std::cout << "/// STEP 3 ///" << std::endl;
@@ -362,22 +430,17 @@ int
     std::vector<std::pair<Perimeter, Perimeter>> perimeters;
 
     // discs of increasing resolutions
-    static constexpr int numberSteps = 20;
-    for (int i = 0; i < numberSteps; ++i)
+    for (auto const & geometry : discGeometries)
     {
-        double        gridStep = numberSteps / static_cast<double>(i + 1);
-        Digital<Disc> dig      = createDigitalShape(disc, gridStep);
-        areas.emplace_back(getDigitalShapeArea(dig), discArea);
-        perimeters.emplace_back(getDigitalShapePerimeter(dig, adj), discPerimeter);
+        areas.emplace_back(getDigitalShapeArea(geometry), discArea);
+        perimeters.emplace_back(getDigitalShapePerimeter(geometry), discPerimeter);
     }
 
     // then with squares
-    for (int i = 0; i < numberSteps; ++i)
+    for (auto const & geometry : squareGeometries)
     {
-        double          gridStep = numberSteps / static_cast<double>(i + 1);
-        Digital<Square> dig      = createDigitalShape(square, gridStep);
-        areas.emplace_back(getDigitalShapeArea(dig), squareArea);
-        perimeters.emplace_back(getDigitalShapePerimeter(dig, adj), squarePerimeter);
+        areas.emplace_back(getDigitalShapeArea(geometry), squareArea);
+        perimeters.emplace_back(getDigitalShapePerimeter(geometry), squarePerimeter);
     }
 
     std::cout << "--- Area ---" << std::endl;
@@ -393,9 +456,9 @@ int
     }
 
     /// STEP 4 ////////////////////////////////////////////////////////////////////////////
-    drawDigitalShapeConvexHull(discDig, adj, outputPath / "ConvexHullDisc");
-    drawDigitalShapeConvexHull(discDigHighRes, adj, outputPath / "ConvexHullDiscHighRes");
-    drawDigitalShapeConvexHull(squareDig, adj, outputPath / "ConvexHullSquare");
+    drawDigitalShapeConvexHull(writer, discGeometry, outputPath / "ConvexHullDisc");
+    drawDigitalShapeConvexHull(writer, discGeometryHighRes, outputPath / "ConvexHullDiscHighRes");
+    drawDigitalShapeConvexHull(writer, squareGeometry, outputPath / "ConvexHullSquare");
 
     /// STEP 5 ////////////////////////////////////////////////////////////////////////////
     std::cout << "/// STEP 5 ///" << std::endl;
@@ -404,21 +467,17 @@ int
     perimeters.clear();
 
     // discs of increasing resolutions
-    for (int i = 0; i < numberSteps; ++i)
+    for (auto const & geometry : discGeometries)
     {
-        double        gridStep = numberSteps / static_cast<double>(i + 1);
-        Digital<Disc> dig      = createDigitalShape(disc, gridStep);
-        areas.emplace_back(getConvexHullArea(dig, adj), discArea);
-        perimeters.emplace_back(getConvexHullPerimeter(dig, adj), discPerimeter);
+        areas.emplace_back(getConvexHullArea(geometry), discArea);
+        perimeters.emplace_back(getConvexHullPerimeter(geometry), discPerimeter);
     }
 
     // then with squares
-    for (int i = 0; i < numberSteps; ++i)
+    for (auto const & geometry : squareGeometries)
     {
-        double          gridStep = numberSteps / static_cast<double>(i + 1);
-        Digital<Square> dig      = createDigitalShape(square, gridStep);
-        areas.emplace_back(getConvexHullArea(dig, adj), squareArea);
-        perimeters.emplace_back(getConvexHullPerimeter(dig, adj), squarePerimeter);
+        areas.emplace_back(getConvexHullArea(geometry), squareArea);
+        perimeters.emplace_back(getConvexHullPerimeter(geometry), squarePerimeter);
     }
 
     std::cout << "--- Area ---" << std::endl;
@@ -432,6 +491,9 @@ int
     {
         std::cout << "Perimeters (ConvexHull|Real) " << perimeterPair << std::endl;
     }
+
+    // Reports the errors of the writers, if any.
+    writer.wait();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,9 @@
 
 #include <util/CompositeDigitalObject.hpp>
 #include <util/DigitalComponent.hpp>
+#include <util/DrawingWriter.hpp>
+#include <util/Profiler.hpp>
+#include <util/RasterOverlay.hpp>
 
 #include <filesystem>
 #include <tuple>
@@ -51,7 +54,11 @@ int
     for (int i = 1; i < argc; ++i)
     {
         std::filesystem::path path  = inputPath / argv[i];
-        Image const           image = DGtal::PGMReader<Image>::importPGM(path);
+        Image const           image = [&path]()
+        {
+            TD_PROFILE_SCOPE("loadImage");
+            return DGtal::PGMReader<Image>::importPGM(path);
+        }();
 
         compositeObjects.emplace_back(image);
     }
@@ -74,6 +81,9 @@ int
 
     // The circularities are computed with the *segmentation* only.
     std::vector<std::vector<FloatScalar>> circularities;
+    // Mean local thickness of each component, from its medial axis.
+    std::vector<std::vector<Perimeter>> thicknesses;
+    std::vector<Perimeter>              maximumThicknesses;
 
     // first is average, second is standard deviation
     std::vector<std::pair<Area, Area>>               statCountAreas;
@@ -84,6 +94,7 @@ int
     std::vector<std::pair<Perimeter, Perimeter>>     statSegmentationPerimeters;
 
     std::vector<std::pair<FloatScalar, FloatScalar>> statCircularities;
+    std::vector<std::pair<Perimeter, Perimeter>>     statThicknesses;
 
     countAreas.reserve(compositeObjects.size());
     countPerimeters.reserve(compositeObjects.size());
@@ -102,9 +113,13 @@ int
     statSegmentationPerimeters.reserve(compositeObjects.size());
 
     statCircularities.reserve(compositeObjects.size());
+    thicknesses.reserve(compositeObjects.size());
+    maximumThicknesses.reserve(compositeObjects.size());
+    statThicknesses.reserve(compositeObjects.size());
 
     for (auto const & composite : compositeObjects)
     {
+        composite.computeMedialAxes();
         countAreas.emplace_back();
         countPerimeters.emplace_back();
         convexHullAreas.emplace_back();
@@ -113,6 +128,8 @@ int
         segmentationPerimeters.emplace_back();
 
         circularities.emplace_back();
+        thicknesses.emplace_back();
+        maximumThicknesses.push_back(0.);
 
         countAreas.back().reserve(composite.components.size());
         countPerimeters.back().reserve(composite.components.size());
@@ -135,6 +152,9 @@ int
             segmentationPerimeters.back().push_back(component.getSegmentationPerimeter());
 
             circularities.back().emplace_back(component.getCircularity());
+
+            thicknesses.back().push_back(component.getMedialAxis().meanThickness);
+            maximumThicknesses.back() = std::max(maximumThicknesses.back(), component.getMedialAxis().maximumThickness);
         }
 
         statCountAreas.emplace_back(Maths<Area>::average(countAreas.back()),
@@ -154,6 +174,8 @@ int
 
         statCircularities.emplace_back(Maths<Area>::average(circularities.back()),
                                     Maths<Area>::standardDeviation(circularities.back()));
+        statThicknesses.emplace_back(Maths<Perimeter>::average(thicknesses.back()),
+                                     Maths<Perimeter>::standardDeviation(thicknesses.back()));
     }
 
     ///
@@ -188,15 +210,45 @@ int
                   << "  deviation: " << statSegmentationPerimeters.at(i).second << std::endl;
         std::cout << "[Circularity]    avg: " << statCircularities.at(i).first
                   << "  deviation:  " << statCircularities.at(i).second << std::endl;
+        std::cout << "[Thickness (MA)]    avg: " << statThicknesses.at(i).first
+                  << "  deviation:  " << statThicknesses.at(i).second
+                  << "  max: " << maximumThicknesses.at(i) << std::endl;
     }
 
+    // Rendering happens in the background.
+    td::util::DrawingWriter                writer;
+    std::vector<td::util::DrawingBuffer> drawings;
     for (std::size_t i = 10; i < 20; ++i)
     {
-        DGtal::Board2D board;
-        compositeObjects.at(1).components.at(i).draw(board);
+        td::util::DrawingBuffer drawing;
+        compositeObjects.at(1).components.at(i).draw(drawing);
+
+        drawings.push_back(drawing);
+        writer.save(std::move(drawing),
+                    std::filesystem::path(outputPath).append("component_" + std::to_string(i) + ".eps"));
+    }
+#ifdef WITH_CAIRO
+    writer.saveDocument(drawings, std::filesystem::path(outputPath).append("components.pdf"));
+    writer.saveOverview(std::move(drawings), std::filesystem::path(outputPath).append("components.png"), 5);
+#endif
 
-        board.saveEPS(std::filesystem::path(outputPath).append("component_" + std::to_string(i) + ".eps").c_str());
+    // QA images: all the components of each image, painted at its resolution.
+    for (std::size_t i = 0; i < compositeObjects.size(); ++i)
+    {
+        td::util::RasterOverlay overlay(compositeObjects.at(i).getDomain());
+        overlay.paint(compositeObjects.at(i).drawComponents());
+#ifdef WITH_CAIRO
+        overlay.save(std::filesystem::path(outputPath).append(std::string(argv[i + 1]) + "_overlay.png"));
+#else
+        overlay.save(std::filesystem::path(outputPath).append(std::string(argv[i + 1]) + "_overlay.ppm"));
+#endif
     }
 
+    // Reports the errors of the writers, if any.
+    writer.wait();
+#ifdef TD_UTIL_PROFILING
+    td::util::Profiler::printSummary(std::cout);
+    td::util::Profiler::writeChromeTrace(std::filesystem::path(outputPath).append("td2_trace.json"));
+#endif
     return 0;
 }
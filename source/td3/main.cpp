@@ -5,7 +5,10 @@
 
 #include <util/CompositeDigitalObject.hpp>
 #include <util/DigitalComponent.hpp>
+#include <util/DrawingWriter.hpp>
+#include <util/Profiler.hpp>
 
+#include <chrono>
 #include <fstream>
 #include <filesystem>
 #include <tuple>
@@ -33,10 +36,19 @@ typedef typename Component::Colour Colour;
 typedef typename Component::Point Point;
 typedef typename Component::Vector Vector;
 typedef typename CompositeObject::RealPoint RealPoint;
+typedef typename CompositeObject::RealVector RealVector;
+typedef typename CompositeObject::Registration Registration;
+typedef typename CompositeObject::Alignment Alignment;
 typedef typename Component::Matrix  Matrix;
 
+// Growing the vectors of objects must move them, never copy.
+static_assert(std::is_nothrow_move_constructible_v<CompositeObject>);
+static_assert(std::is_nothrow_move_constructible_v<Component>);
+
 static constexpr char const * outputDirName = "res/td3/";
 static constexpr char const * inputDirName  = "assets/td3/binary";
+// Rotations tried against the registration, when there are no interest points.
+static constexpr int numberSearchAngles = 24;
 
 int
   main(int argc, char ** argv)
@@ -76,19 +88,26 @@ int
                 // only open image files (file with an extension.)
                 if (path.has_extension())
                 {
-                    Image image = DGtal::PGMReader<Image>::importPGM(entry.path().c_str());
+                    Image image = [&path]()
+                    {
+                        TD_PROFILE_SCOPE("loadImage");
+                        return DGtal::PGMReader<Image>::importPGM(path.c_str());
+                    }();
                     matCompositeObjects.back().emplace_back(std::move(image));
 
                     // look for the corresponding position: same file name, without extension.
                     std::filesystem::path pointPath = path.parent_path() / path.stem();
                     // add interest point.
+                    // Without one, the objects are registered automatically.
                     std::fstream fs;
                     fs.open(pointPath.c_str(), std::fstream::in);
                     int x, y;
-                    fs >> x; fs >> y;
+                    if (fs >> x >> y)
+                    {
+                        // remember this interest point.
+                        matCompositeObjects.back().back().setInterestPoint(Point(x, y));
+                    }
                     fs.close();
-                    // remember this interest point.
-                    matCompositeObjects.back().back().setInterestPoint(Point(x, y));
                 }
             }
         }
@@ -106,6 +125,9 @@ int
         }
     }
 
+    // Drawings are written in the background, while the objects are registered.
+    td::util::DrawingWriter writer;
+
     // saving before transformations
     {
         int i = 0;
@@ -114,14 +136,12 @@ int
             int j = 0;
             for (auto const & composite : compositeObjects)
             {
-                DGtal::Board2D board;
-                composite.drawObjectComponents(board, Colour::Gray, Colour::Yellow);
-
-                board.saveEPS(
-                  std::filesystem::path(outputPath)
-                    .append(std::string(argv[i + 1]) + "_" + std::to_string(j + 1) + ".eps")
-                    .c_str()
-                  );
+                td::util::DrawingBuffer drawing;
+                composite.drawObjectComponents(drawing, Colour::Gray, Colour::Yellow);
+
+                writer.save(std::move(drawing),
+                            std::filesystem::path(outputPath)
+                              .append(std::string(argv[i + 1]) + "_" + std::to_string(j + 1) + ".eps"));
                 ++j;
             }
             ++i;
@@ -142,7 +162,8 @@ int
             std::cout << "Dubuisson-Jain dissimilarity: " << secondObject.computeDubuissonJainDissimilarity(firstObject) << std::endl;
 
             AngleRadian angle;
-            Vector translation;
+            RealVector translation;
+            if (firstObject.getInterestPoint().has_value() && secondObject.getInterestPoint().has_value())
             {
                 Component const & firstComponent = firstObject.components.front();
                 Component const & secondComponent = secondObject.components.front();
@@ -158,17 +179,50 @@ int
                 angle = Component::computeRotationAngle(
                   { firstPointFromCentre },
                   { secondPointFromCentre });
-                translation = firstComponent.getTranslationTo(secondComponent);
+                Vector const centreTranslation = firstComponent.getTranslationTo(secondComponent);
+                translation = RealVector(centreTranslation[0], centreTranslation[1]);
 
                 // Now transform the second object to align it with the first.
                 secondObject.transformRigidBackward(
                   firstComponent.getGeometricCentre(),
                   - angle, - translation
                  );
-                // We should cull the components again,
-                // because the rigid transformation may have introduced artifacts.
-                secondObject.cullAllButLargestComponent();
             }
+            else
+            {
+                // No interest points: iterative closest point on the boundaries.
+                auto const start = std::chrono::steady_clock::now();
+                Registration const registration = firstObject.computeRegistration(secondObject);
+                std::chrono::duration<double, std::milli> const elapsed = std::chrono::steady_clock::now() - start;
+                std::cout << "Registration: " << registration.iterations << " iterations, rms "
+                          << registration.rms << " (" << elapsed.count() << " ms)" << std::endl;
+
+                // The closest point iterations only reach the nearest local minimum,
+                // so their result competes with rotations of the second object about its centre,
+                // pruned level by level through the pyramids.
+                Component const & firstComponent  = firstObject.components.front();
+                Component const & secondComponent = secondObject.components.front();
+                Point const       firstCentre     = firstComponent.getGeometricCentre();
+                Point const       secondCentre    = secondComponent.getGeometricCentre();
+                RealPoint const   rotCentre(secondCentre[0], secondCentre[1]);
+                RealVector const  centreTranslation(firstCentre[0] - secondCentre[0], firstCentre[1] - secondCentre[1]);
+                std::vector<Alignment> candidates = {
+                  {registration.angle, registration.centre, registration.translation, 0.}};
+                for (int k = 0; k < numberSearchAngles; ++k)
+                {
+                    candidates.push_back({2. * M_PI * k / numberSearchAngles, rotCentre, centreTranslation, 0.});
+                }
+                Alignment const best = firstObject.searchAlignments(secondObject, candidates).front();
+                std::cout << "Search: " << candidates.size() << " candidates, best Hausdorff distance "
+                          << best.distance << std::endl;
+
+                angle = best.angle;
+                translation = best.translation;
+                secondObject.transformRigidBackward(best.centre, best.angle, best.translation);
+            }
+            // We should cull the components again,
+            // because the rigid transformation may have introduced artifacts.
+            secondObject.cullAllButLargestComponent();
 
             std::cout << "Rotation angle: " << angle * (180. / M_PI) << "°" << std::endl;
             std::cout << "Translation:    " << translation << std::endl;
@@ -177,16 +231,21 @@ int
             std::cout << "Hausdorff distance:           " << secondObject.computeHausdorffDistance(firstObject) << std::endl;
             std::cout << "Dubuisson-Jain dissimilarity: " << secondObject.computeDubuissonJainDissimilarity(firstObject) << std::endl;
 
-            DGtal::Board2D board;
-            secondObject.drawObjectComponents(board, Colour::Black, Colour::Yellow);
+            td::util::DrawingBuffer drawing;
+            secondObject.drawObjectComponents(drawing, Colour::Black, Colour::Yellow);
 
-            board.saveEPS(
-              std::filesystem::path(outputPath)
-                .append(std::string(argv[i + 1]) + "_" + std::to_string(j + 2) + "_transformed_backward.eps")
-                .c_str()
-                         );
+            writer.save(std::move(drawing),
+                        std::filesystem::path(outputPath)
+                          .append(std::string(argv[i + 1]) + "_" + std::to_string(j + 2)
+                                  + "_transformed_backward.eps"));
         }
     }
 
+    // Reports the errors of the writers, if any.
+    writer.wait();
+#ifdef TD_UTIL_PROFILING
+    td::util::Profiler::printSummary(std::cout);
+    td::util::Profiler::writeChromeTrace(std::filesystem::path(outputPath).append("td3_trace.json"));
+#endif
     return 0;
 }
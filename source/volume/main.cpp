@@ -0,0 +1,71 @@
+#include <DGtal/base/Common.h>
+#include <DGtal/helpers/StdDefs.h>
+
+#include <util/BinaryVolume.hpp>
+#include <util/CompositeDigitalVolume.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+typedef td::util::CompositeDigitalVolume<DGtal::Z3i::DT6_26> CompositeVolume;
+typedef td::util::BinaryVolume                               BinaryVolume;
+
+int
+  main(int argc, char ** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "usage: programme_name [volume.pgm3d] *([threshold] [number_threads])" << std::endl;
+        std::cout << "       programme_name [volume.raw] [size_x] [size_y] [size_z] "
+                     "*([threshold] [number_threads] [bytes_per_voxel])"
+                  << std::endl;
+        std::cout << "       16-bit raw voxels (bytes_per_voxel = 2) are little endian." << std::endl;
+        return 0;
+    }
+    setlocale(LC_NUMERIC, "us_US");  // To prevent French local settings
+
+    std::filesystem::path const path  = argv[1];
+    bool const                  isRaw = path.extension() == ".raw";
+    int const                   nextArg = isRaw ? 5 : 2;
+    if (isRaw && argc < 5)
+    {
+        std::cout << "raw volumes need their size." << std::endl;
+        return 1;
+    }
+    auto const threshold =
+      static_cast<BinaryVolume::Value>(argc > nextArg ? std::stoi(argv[nextArg]) : 0);
+    unsigned int const numberThreads =
+      argc > nextArg + 1 ? static_cast<unsigned int>(std::stoul(argv[nextArg + 1])) : 0;
+    int const bytesPerVoxel = isRaw && argc > nextArg + 2 ? std::stoi(argv[nextArg + 2]) : 1;
+    if (bytesPerVoxel != 1 && bytesPerVoxel != 2)
+    {
+        std::cout << "voxels take 1 or 2 bytes." << std::endl;
+        return 1;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    BinaryVolume volume =
+      isRaw ? BinaryVolume::importRaw(path,
+                                      BinaryVolume::Point(std::stoi(argv[2]), std::stoi(argv[3]), std::stoi(argv[4])),
+                                      threshold,
+                                      bytesPerVoxel)
+            : BinaryVolume::importPGM3D(path, threshold);
+    std::cout << "foreground voxels: " << volume.count() << std::endl;
+
+    CompositeVolume const composite(std::move(volume));
+    composite.computeGeometry(numberThreads);
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "components: " << composite.components.size() << " (" << elapsed.count() << " s)" << std::endl;
+    std::cout << "volume,surfels,area,centroid_x,centroid_y,centroid_z,moment_0,moment_1,moment_2" << std::endl;
+    for (auto const & component : composite.components)
+    {
+        auto const centroid = component.getCentroid();
+        auto const moments  = component.getPrincipalMoments();
+        std::cout << component.getCountVolume() << ',' << component.getCountSurfaceArea() << ','
+                  << component.computeNormalSurfaceArea() << ',' << centroid[0] << ',' << centroid[1] << ','
+                  << centroid[2] << ',' << moments[0] << ',' << moments[1] << ',' << moments[2] << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "common.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Checks that the search of alignments through the pyramids keeps the same best alignments
+// as the evaluation of every candidate at full resolution,
+// and that objects searched from several threads at once build their pyramids once.
+
+typedef typename CompositeObject::Alignment  Alignment;
+typedef typename CompositeObject::RealVector RealVector;
+
+/// Rotations about the centre of the image, with small translations.
+std::vector<Alignment>
+  createCandidates(std::size_t count)
+{
+    std::vector<Alignment> candidates;
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        double const angle = 2. * td::util::maths<double>::pi() * static_cast<double>(k) / static_cast<double>(count);
+        candidates.push_back(
+          {angle, RealPoint(80., 80.), RealVector(static_cast<double>(k % 5) - 2., static_cast<double>(k % 3)), 0.});
+    }
+    return candidates;
+}
+
+/// Same distances, in the same order, for the first count alignments.
+bool
+  isSameBest(std::vector<Alignment> const & found, std::vector<Alignment> const & expected, std::size_t count)
+{
+    if (found.size() != count || expected.size() < count)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (found[i].distance != expected[i].distance)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+  main()
+{
+    CompositeObject const first(generateGrainField(160, 160, 12, 5));
+    CompositeObject const second(generateGrainField(160, 160, 12, 6));
+    check(first.getPyramid().getNumberLevels() > 1, "the pyramid has coarse levels");
+
+    std::vector<Alignment> const candidates = createCandidates(48);
+    // Keeping every candidate prunes none: all are evaluated at full resolution.
+    std::vector<Alignment> const exhaustive = first.searchAlignments(second, candidates, candidates.size());
+    check(exhaustive.size() == candidates.size(), "the exhaustive search keeps every candidate");
+    for (std::size_t const numberSurvivors : {std::size_t {1}, std::size_t {3}})
+    {
+        check(isSameBest(first.searchAlignments(second, candidates, numberSurvivors), exhaustive, numberSurvivors),
+              "same best alignments as the exhaustive search");
+    }
+
+    // New objects have no pyramids yet: the threads all ask for the same ones.
+    CompositeObject const               sharedFirst(generateGrainField(160, 160, 12, 5));
+    CompositeObject const               sharedSecond(generateGrainField(160, 160, 12, 6));
+    std::vector<std::vector<Alignment>> results(4);
+    std::vector<std::thread>            threads;
+    for (auto & result : results)
+    {
+        threads.emplace_back([&sharedFirst, &sharedSecond, &candidates, &result]()
+                             { result = sharedFirst.searchAlignments(sharedSecond, candidates); });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    bool isSame = true;
+    for (auto const & result : results)
+    {
+        isSame = isSame && isSameBest(result, exhaustive, 1);
+    }
+    check(isSame, "same best alignment from several threads");
+
+    return reportChecks("alignments");
+}
@@ -0,0 +1,145 @@
+#include "common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Checks that moving components and composite objects, and filtering components,
+// never allocate: they only move the handles of the shared payloads.
+
+// Every allocation of the programme goes through here.
+static std::atomic<std::size_t> numberAllocations {0};
+
+void *
+  operator new(std::size_t size)
+{
+    ++numberAllocations;
+    if (void * pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void
+  operator delete(void * pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void
+  operator delete(void * pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+typedef typename CompositeObject::Filter Filter;
+
+/// Discs of increasing radii on a grid, apart from each other and from the rim.
+/// \return
+Image
+  createDiscs()
+{
+    Domain const domain(Point(0, 0), Point(255, 255));
+    Image        image(domain);
+    for (auto const & point : domain)
+    {
+        image.setValue(point, 0);
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+        {
+            Point const centre(32 + 64 * i, 32 + 64 * j);
+            int const   radius = 6 + 4 * i + j;
+            for (auto const & point : Domain(centre - Point::diagonal(radius), centre + Point::diagonal(radius)))
+            {
+                Point const offset = point - centre;
+                if (offset[0] * offset[0] + offset[1] * offset[1] <= radius * radius)
+                {
+                    image.setValue(point, 255);
+                }
+            }
+        }
+    }
+    return image;
+}
+
+/// Number of allocations made by a function.
+template <class Function>
+std::size_t
+  countAllocations(Function const & function)
+{
+    std::size_t const before = numberAllocations;
+    function();
+    return numberAllocations - before;
+}
+
+int
+  main()
+{
+    CompositeObject composite(createDiscs());
+    check(composite.components.size() == 16, "every disc is a component");
+    // Some geometry is cached, moves must carry it along without copying.
+    for (auto const & component : composite.components)
+    {
+        static_cast<void>(component.getConvexHullArea());
+    }
+
+    check(countAllocations(
+            [&composite]()
+            {
+                Component moved(std::move(composite.components.back()));
+                composite.components.back() = std::move(moved);
+            })
+            == 0,
+          "moving a component");
+
+    check(countAllocations(
+            [&composite]()
+            {
+                CompositeObject moved(std::move(composite));
+                composite = std::move(moved);
+            })
+            == 0,
+          "moving a composite object");
+
+    std::vector<Component> components;
+    components.reserve(composite.components.size());
+    check(countAllocations(
+            [&composite, &components]()
+            {
+                for (auto & component : composite.components)
+                {
+                    components.push_back(std::move(component));
+                }
+                composite.components = std::move(components);
+            })
+            == 0,
+          "moving components into a reserved vector");
+
+    // The median count area, so that the filter removes some components and keeps others.
+    std::vector<typename Component::Area> areas;
+    for (auto const & component : composite.components)
+    {
+        areas.push_back(component.getCountArea());
+    }
+    std::nth_element(areas.begin(), areas.begin() + static_cast<std::ptrdiff_t>(areas.size() / 2), areas.end());
+    Filter filter;
+    filter.minimumArea = areas[areas.size() / 2];
+
+    std::size_t const numberComponents = composite.components.size();
+    std::size_t       removed          = 0;
+    check(countAllocations([&composite, &filter, &removed]() { removed = composite.filterComponents(filter); }) == 0,
+          "filtering the components");
+    check(removed > 0 && removed < numberComponents, "the filter removes some components only");
+
+    check(countAllocations([&composite]() { composite.cullAllButLargestComponent(); }) == 0,
+          "culling all but the largest component");
+    check(composite.components.size() == 1, "a single component is left");
+
+    return reportChecks("allocations");
+}
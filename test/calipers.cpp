@@ -0,0 +1,143 @@
+#include "common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Checks the rotating calipers of the components against a brute force:
+// the extreme widths over the directions of all the edges of the hull, and the largest distance between its vertices.
+
+typedef typename Component::Calipers Calipers;
+
+// Relative to the size of the component.
+static constexpr double c_tolerance = 1e-9;
+
+/// Corners of the pixels of the component, on which its boundary and hull lie.
+std::vector<Point>
+  computeCorners(Component const & component)
+{
+    std::vector<Point> corners;
+    for (auto const & point : component.getPointSet())
+    {
+        corners.push_back(point);
+        corners.push_back(point + Point(1, 0));
+        corners.push_back(point + Point(0, 1));
+        corners.push_back(point + Point(1, 1));
+    }
+    return corners;
+}
+
+/// Counterclockwise hull by monotone chains, independent of the one of the components.
+std::vector<Point>
+  computeHull(std::vector<Point> points)
+{
+    std::sort(points.begin(),
+              points.end(),
+              [](Point const & a, Point const & b) { return a[0] < b[0] || (a[0] == b[0] && a[1] < b[1]); });
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if (points.size() < 3)
+    {
+        return points;
+    }
+    auto const cross = [](Point const & o, Point const & a, Point const & b)
+    {
+        return static_cast<std::int64_t>(a[0] - o[0]) * (b[1] - o[1])
+               - static_cast<std::int64_t>(a[1] - o[1]) * (b[0] - o[0]);
+    };
+    std::vector<Point> hull(2 * points.size());
+    std::size_t        k = 0;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0)
+        {
+            --k;
+        }
+        hull[k++] = points[i];
+    }
+    for (std::size_t i = points.size() - 1, lower = k + 1; i > 0; --i)
+    {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0)
+        {
+            --k;
+        }
+        hull[k++] = points[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+void
+  checkCalipers(Component const & component)
+{
+    std::vector<Point> const corners = computeCorners(component);
+    std::vector<Point> const hull    = computeHull(corners);
+    Calipers const &         calipers = component.getCalipers();
+
+    double maximumDiameter = 0.;
+    for (auto const & a : hull)
+    {
+        for (auto const & b : hull)
+        {
+            maximumDiameter = std::max(maximumDiameter, (a - b).norm());
+        }
+    }
+    // The smallest width and the smallest rectangle have a side along an edge of the hull.
+    double minimumWidth  = std::numeric_limits<double>::max();
+    double rectangleArea = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < hull.size(); ++i)
+    {
+        Point const  edge   = hull[(i + 1) % hull.size()] - hull[i];
+        double const length = edge.norm();
+        double const ux     = static_cast<double>(edge[0]) / length;
+        double const uy     = static_cast<double>(edge[1]) / length;
+        double       along[2]  = {std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+        double       across[2] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+        for (auto const & point : hull)
+        {
+            double const s = static_cast<double>(point[0]) * ux + static_cast<double>(point[1]) * uy;
+            double const n = static_cast<double>(point[1]) * ux - static_cast<double>(point[0]) * uy;
+            along[0]       = std::min(along[0], s);
+            along[1]       = std::max(along[1], s);
+            across[0]      = std::min(across[0], n);
+            across[1]      = std::max(across[1], n);
+        }
+        minimumWidth  = std::min(minimumWidth, across[1] - across[0]);
+        rectangleArea = std::min(rectangleArea, (along[1] - along[0]) * (across[1] - across[0]));
+    }
+    double const scale = std::max(1., maximumDiameter);
+    check(std::abs(calipers.maximumDiameter - maximumDiameter) <= c_tolerance * scale, "maximum diameter");
+    check(std::abs(calipers.minimumWidth - minimumWidth) <= c_tolerance * scale, "minimum width");
+    check(std::abs(calipers.rectangleArea - rectangleArea) <= c_tolerance * scale * scale, "rectangle area");
+
+    // The rectangle holds the whole component.
+    auto const & rectangle = calipers.rectangleCorners;
+    double const sx        = rectangle[1][0] - rectangle[0][0];
+    double const sy        = rectangle[1][1] - rectangle[0][1];
+    double const tx        = rectangle[3][0] - rectangle[0][0];
+    double const ty        = rectangle[3][1] - rectangle[0][1];
+    bool         isInside  = true;
+    for (auto const & corner : corners)
+    {
+        double const px = static_cast<double>(corner[0]) - rectangle[0][0];
+        double const py = static_cast<double>(corner[1]) - rectangle[0][1];
+        double const s  = (px * sx + py * sy) / (sx * sx + sy * sy);
+        double const t  = (px * tx + py * ty) / (tx * tx + ty * ty);
+        isInside = isInside && s >= -c_tolerance && s <= 1. + c_tolerance && t >= -c_tolerance && t <= 1. + c_tolerance;
+    }
+    check(isInside, "the rectangle holds the component");
+}
+
+int
+  main()
+{
+    CompositeObject const composite(generateGrainField(512, 512, 200, 7));
+    check(composite.components.size() > 10, "the grain field has many components");
+    for (auto const & component : composite.components)
+    {
+        checkCalipers(component);
+    }
+
+    return reportChecks("calipers");
+}
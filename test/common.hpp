@@ -0,0 +1,82 @@
+//
+// Created by binabik on 19/10/2026.
+//
+
+#ifndef TD_TEST_COMMON_HPP
+#define TD_TEST_COMMON_HPP
+
+#include <DGtal/base/Common.h>
+#include <DGtal/helpers/StdDefs.h>
+
+#include <util/CompositeDigitalObject.hpp>
+#include <util/DigitalComponent.hpp>
+#include <util/GrainFieldGenerator.hpp>
+
+#include <cstdint>
+#include <iostream>
+
+// Checks and types shared by the tests, each one being its own executable.
+
+// Topology
+typedef DGtal::Z2i::DT4_8 DigitalTopology;
+static constexpr int dimension = 2;
+
+typedef td::util::DigitalComponent<dimension, DigitalTopology>       Component;
+typedef td::util::CompositeDigitalObject<dimension, DigitalTopology> CompositeObject;
+typedef typename CompositeObject::Image                              Image;
+typedef typename Component::Space                                    Space;
+typedef typename Component::Domain                                   Domain;
+typedef typename Component::Point                                    Point;
+typedef typename Space::RealPoint                                    RealPoint;
+typedef typename Component::Perimeter                                Perimeter;
+typedef td::util::GrainFieldGenerator                                GrainFieldGenerator;
+
+static int numberFailures = 0;
+
+/// Reports a failed check, the test goes on with the next ones.
+/// \param condition
+/// \param what
+inline void
+  check(bool condition, char const * what)
+{
+    if (!condition)
+    {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++numberFailures;
+    }
+}
+
+/// \param name of the test.
+/// \return exit code of the test, 1 if any check failed.
+inline int
+  reportChecks(char const * name)
+{
+    if (numberFailures > 0)
+    {
+        return 1;
+    }
+    std::cout << name << ": ok" << std::endl;
+    return 0;
+}
+
+/// Discs, squares, ellipses and rotated rectangles, touching or not.
+/// \param width
+/// \param height
+/// \param numberGrains
+/// \param seed
+/// \return
+inline Image
+  generateGrainField(GrainFieldGenerator::Integer width,
+                     GrainFieldGenerator::Integer height,
+                     std::size_t                  numberGrains,
+                     std::uint64_t                seed)
+{
+    GrainFieldGenerator::Parameters parameters;
+    parameters.width        = width;
+    parameters.height       = height;
+    parameters.numberGrains = numberGrains;
+    parameters.seed         = seed;
+    return GrainFieldGenerator(parameters).createImage<Image>();
+}
+
+#endif  // TD_TEST_COMMON_HPP
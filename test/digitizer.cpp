@@ -0,0 +1,148 @@
+#include "common.hpp"
+
+#include <DGtal/shapes/GaussDigitizer.h>
+#include <DGtal/shapes/ShapeFactory.h>
+
+#include <util/ImplicitShapes2D.hpp>
+#include <util/ScanlineDigitizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+// Checks the row by row digitisation against the Gauss digitiser evaluated at every point,
+// for shapes with a closed-form row interval and for shapes bisected along the rows.
+
+typedef td::util::ScanlineDigitizer<Space>  ScanlineDigitizer;
+typedef typename ScanlineDigitizer::Integer Integer;
+typedef typename ScanlineDigitizer::Spans   Spans;
+
+/// Square with a square hole, both centred: without closed form, it is bisected along the rows.
+/// Its walls and its hole are as wide as given, whatever the row.
+class SquareFrame
+{
+   public:
+    SquareFrame(RealPoint const & centre, double outerHalfWidth, double innerHalfWidth)
+        : m_centre(centre), m_outerHalfWidth(outerHalfWidth), m_innerHalfWidth(innerHalfWidth)
+    {}
+
+    [[nodiscard]] DGtal::Orientation
+      orientation(RealPoint const & point) const
+    {
+        double const distance = std::max(std::abs(point[0] - m_centre[0]), std::abs(point[1] - m_centre[1]));
+        if (distance == m_outerHalfWidth || distance == m_innerHalfWidth)
+        {
+            return DGtal::ON;
+        }
+        return distance < m_outerHalfWidth && distance > m_innerHalfWidth ? DGtal::INSIDE : DGtal::OUTSIDE;
+    }
+    [[nodiscard]] bool
+      isInside(RealPoint const & point) const
+    {
+        return orientation(point) == DGtal::INSIDE;
+    }
+
+    [[nodiscard]] RealPoint
+      getLowerBound() const
+    {
+        return m_centre - RealPoint::diagonal(m_outerHalfWidth);
+    }
+    [[nodiscard]] RealPoint
+      getUpperBound() const
+    {
+        return m_centre + RealPoint::diagonal(m_outerHalfWidth);
+    }
+
+   private:
+    RealPoint m_centre;
+    double    m_outerHalfWidth;
+    double    m_innerHalfWidth;
+};
+
+/// Disc with a hole: near the rows tangent to the hole, its runs and holes are as thin as a point.
+class Annulus
+{
+   public:
+    Annulus(RealPoint const & centre, double outerRadius, double innerRadius)
+        : m_centre(centre), m_outerRadius(outerRadius), m_innerRadius(innerRadius)
+    {}
+
+    [[nodiscard]] DGtal::Orientation
+      orientation(RealPoint const & point) const
+    {
+        double const distance = (point - m_centre).norm();
+        if (distance == m_outerRadius || distance == m_innerRadius)
+        {
+            return DGtal::ON;
+        }
+        return distance < m_outerRadius && distance > m_innerRadius ? DGtal::INSIDE : DGtal::OUTSIDE;
+    }
+    [[nodiscard]] bool
+      isInside(RealPoint const & point) const
+    {
+        return orientation(point) == DGtal::INSIDE;
+    }
+
+    [[nodiscard]] RealPoint
+      getLowerBound() const
+    {
+        return m_centre - RealPoint::diagonal(m_outerRadius);
+    }
+    [[nodiscard]] RealPoint
+      getUpperBound() const
+    {
+        return m_centre + RealPoint::diagonal(m_outerRadius);
+    }
+
+   private:
+    RealPoint m_centre;
+    double    m_outerRadius;
+    double    m_innerRadius;
+};
+
+/// Same points as the digitiser evaluated at every point of its domain.
+template <class Shape_T>
+void
+  checkDigitization(Shape_T const & shape, double h, Integer stride, char const * what)
+{
+    DGtal::GaussDigitizer<Space, Shape_T> dig;
+    dig.attach(shape);
+    dig.init(shape.getLowerBound(), shape.getUpperBound(), h);
+    Spans const spans = ScanlineDigitizer::digitize(shape, dig, stride);
+
+    std::size_t numberPoints = 0;
+    bool        isSame       = true;
+    for (auto const & point : dig.getDomain())
+    {
+        bool const isInside = dig(point);
+        numberPoints += isInside ? 1 : 0;
+        isSame = isSame && spans(point) == isInside;
+    }
+    check(numberPoints > 0, what);
+    check(isSame && spans.size() == numberPoints, what);
+}
+
+int
+  main()
+{
+    // Centred on a point of the grid, the rows tangent to the shapes hold points lying on them.
+    for (RealPoint const & centre : {RealPoint(0., 0.), RealPoint(0.3, -0.2)})
+    {
+        for (double const h : {1., 0.37, 0.1})
+        {
+            Integer const stride = ScanlineDigitizer::c_defaultStride;
+            // Closed form, the stride is not used.
+            checkDigitization(DGtal::ImplicitBall<Space>(centre, 9.5), h, stride, "disc");
+            checkDigitization(DGtal::ImplicitHyperCube<Space>(centre, 7.), h, stride, "square");
+            checkDigitization(td::util::ImplicitEllipse<Space>(centre, 10., 4., 0.6), h, stride, "ellipse");
+            checkDigitization(
+              td::util::ImplicitRotatedRectangle<Space>(centre, 10., 3., -1.1), h, stride, "rotated rectangle");
+
+            // Bisected, every run and hole spans more points than the default stride.
+            checkDigitization(SquareFrame(centre, 2.2 * stride, 1.1 * stride), h, stride, "frame");
+            // Bisected, thin runs and holes are only found at every point.
+            checkDigitization(Annulus(centre, 11., 6.), h, 1, "annulus");
+        }
+    }
+
+    return reportChecks("digitizer");
+}
@@ -0,0 +1,139 @@
+#include "common.hpp"
+
+#include <util/DistanceMap.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Checks the Meijster distance transform against the squared distances to every site,
+// on a single thread and on several, over whole domains, local windows and pasted boxes.
+
+typedef td::util::DistanceMap<Space>          DistanceMap;
+typedef typename DistanceMap::SquaredDistance SquaredDistance;
+
+/// Sites drawn with a probability over a domain, sorted so that they are found by bisection.
+std::vector<Point>
+  drawSites(Domain const & domain, double probability, std::uint64_t seed)
+{
+    std::mt19937_64             generator(seed);
+    std::bernoulli_distribution isSite(probability);
+    std::vector<Point>          sites;
+    for (auto const & point : domain)
+    {
+        if (isSite(generator))
+        {
+            sites.push_back(point);
+        }
+    }
+    std::sort(sites.begin(), sites.end());
+    return sites;
+}
+
+/// Smallest squared distance from a point to the sites, by trying them all.
+SquaredDistance
+  computeSquaredDistance(Point const & point, std::vector<Point> const & sites)
+{
+    SquaredDistance smallest = std::numeric_limits<SquaredDistance>::max();
+    for (auto const & site : sites)
+    {
+        SquaredDistance const dx = point[0] - site[0];
+        SquaredDistance const dy = point[1] - site[1];
+        smallest                 = std::min(smallest, dx * dx + dy * dy);
+    }
+    return smallest;
+}
+
+/// Same squared distances as the brute force over the whole domain of the map, read point by point and by runs.
+void
+  checkMap(DistanceMap const & map, std::vector<Point> const & sites, char const * what)
+{
+    bool isExact = true;
+    for (auto const & point : map.domain())
+    {
+        SquaredDistance const expected = computeSquaredDistance(point, sites);
+        isExact = isExact && map.getSquaredDistance(point) == expected && *map.getRun(point) == expected;
+    }
+    check(isExact, what);
+}
+
+int
+  main()
+{
+    struct Case
+    {
+        Domain       domain;
+        double       probability;
+        char const * what;
+    };
+    // Lower bounds below zero and sizes which are not multiples of the tiles of the transpositions.
+    // The largest domain is over the size computed in parallel.
+    Case const cases[] = {{Domain(Point(-11, -7), Point(25, 15)), 0.05, "sparse sites"},
+                          {Domain(Point(0, 0), Point(63, 32)), 0.5, "dense sites"},
+                          {Domain(Point(3, -20), Point(3, 20)), 0.1, "single column"},
+                          {Domain(Point(-20, 4), Point(20, 4)), 0.1, "single row"},
+                          {Domain(Point(-40, -30), Point(259, 209)), 0.0005, "large domain"}};
+    std::uint64_t seed = 1;
+    for (Case const & c : cases)
+    {
+        std::vector<Point> const sites = drawSites(c.domain, c.probability, seed++);
+        check(!sites.empty(), "some sites are drawn");
+        auto const isSite = [&sites](Point const & point)
+        { return std::binary_search(sites.begin(), sites.end(), point); };
+
+        DistanceMap const single(c.domain, isSite, 1);
+        checkMap(single, sites, c.what);
+        checkMap(DistanceMap(c.domain, isSite, 0), sites, c.what);
+
+        // Outside of the domain, an upper bound.
+        for (Point const & offset : {Point(-5, 0), Point(3, 7), Point(-2, -9)})
+        {
+            Point const outside = offset[0] < 0 ? c.domain.lowerBound() + offset : c.domain.upperBound() + offset;
+            check(single(outside) + 1e-9 >= std::sqrt(static_cast<double>(computeSquaredDistance(outside, sites))),
+                  "upper bound outside of the domain");
+        }
+    }
+
+    // A single site, the distances are those of the whole plane.
+    Domain const             domain(Point(-30, -25), Point(40, 35));
+    std::vector<Point> const site = {Point(7, -3)};
+    auto const               isTheSite = [&site](Point const & point) { return point == site.front(); };
+    checkMap(DistanceMap(domain, isTheSite, 0), site, "single site");
+
+    // The local map only sees the sites of its window.
+    std::vector<Point> const sites = drawSites(domain, 0.02, 11);
+    auto const               isSite = [&sites](Point const & point)
+    { return std::binary_search(sites.begin(), sites.end(), point); };
+    Domain const      box(Point(-5, 0), Point(12, 9));
+    DistanceMap const local = DistanceMap::computeLocal(domain, isSite, box, 6, 0);
+    check(local.domain().lowerBound() == Point(-11, -6) && local.domain().upperBound() == Point(18, 15), "local window");
+    std::vector<Point> windowSites;
+    std::copy_if(sites.begin(),
+                 sites.end(),
+                 std::back_inserter(windowSites),
+                 [&local](Point const & point) { return local.domain().isInside(point); });
+    checkMap(local, windowSites, "local map");
+
+    // Pasting a box of another map only changes the box, and not the copies sharing the rows.
+    std::vector<Point> const otherSites  = drawSites(domain, 0.03, 12);
+    auto const               isOtherSite = [&otherSites](Point const & point)
+    { return std::binary_search(otherSites.begin(), otherSites.end(), point); };
+    DistanceMap const map(domain, isSite, 0);
+    DistanceMap const other(domain, isOtherSite, 0);
+    DistanceMap       pasted = map;
+    pasted.paste(other, box);
+    bool isPasted = true;
+    for (auto const & point : domain)
+    {
+        SquaredDistance const expected = computeSquaredDistance(point, box.isInside(point) ? otherSites : sites);
+        isPasted = isPasted && pasted.getSquaredDistance(point) == expected;
+    }
+    check(isPasted, "pasted box");
+    checkMap(map, sites, "map copied before the paste");
+
+    return reportChecks("distancemap");
+}
@@ -0,0 +1,57 @@
+#include "common.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Checks the distances of the components, read along the runs of their points,
+// against the distance transform queried point by point.
+
+typedef typename Component::DistanceTransform DistanceTransform;
+
+// Relative, the sums are not made in the same order.
+static constexpr double c_tolerance = 1e-12;
+
+/// Compares the distances of all the components to the background of another field.
+void
+  checkDistances(CompositeObject const & composite, DistanceTransform const & distance)
+{
+    for (auto const & component : composite.components)
+    {
+        Perimeter largest = 0.;
+        Perimeter sum     = 0.;
+        for (auto const & point : component.getPointSet())
+        {
+            Perimeter const d = distance(point);
+            largest           = std::max(largest, d);
+            sum += d;
+        }
+        Perimeter const average = sum / static_cast<Perimeter>(component.getPointSet().size());
+        check(std::abs(component.computeLargestDistance(distance) - largest) <= c_tolerance * std::max(1., largest),
+              "largest distance");
+        check(std::abs(component.computeAverageDistance(distance) - average) <= c_tolerance * std::max(1., average),
+              "average distance");
+    }
+}
+
+int
+  main()
+{
+    CompositeObject const composite(generateGrainField(384, 256, 120, 11));
+    check(composite.components.size() > 10, "the grain field has many components");
+    Image const other = generateGrainField(384, 256, 120, 12);
+    auto const  isSite = [&other](Point const & point) { return other(point) != 0; };
+
+    // Over the whole field, every point is in the domain of the transform.
+    DistanceTransform const whole(other.domain(), isSite);
+    checkDistances(composite, whole);
+
+    // Over a box in the middle, the components across its sides have points on both sides:
+    // outside of it, the run-based reads fall back to the upper bound of the transform.
+    Domain const            domain = other.domain();
+    Point const             lower(domain.lowerBound()[0] + 50, domain.lowerBound()[1] + 40);
+    Point const             upper(domain.upperBound()[0] - 70, domain.upperBound()[1] - 30);
+    DistanceTransform const box(Domain(lower, upper), isSite);
+    checkDistances(composite, box);
+
+    return reportChecks("distances");
+}
@@ -0,0 +1,111 @@
+#include "common.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// Checks that a combined filter passes exactly the components which pass both filters, whatever their rims,
+// and that applying it keeps the survivors in their order.
+
+typedef typename CompositeObject::Filter Filter;
+typedef typename Filter::Area            Area;
+typedef typename Filter::FloatScalar     FloatScalar;
+
+/// \param lower
+/// \param upper
+/// \return filter of the components inside the rim only.
+Filter
+  createRimFilter(Point const & lower, Point const & upper)
+{
+    Filter filter;
+    filter.rim = Domain(lower, upper);
+    return filter;
+}
+
+/// Checks the combinations of two filters, in both orders, component by component and through apply.
+/// \param components
+/// \param a
+/// \param b
+/// \param isSomePassing whether some components, but not all, are expected to pass both.
+/// \param what
+void
+  checkCombination(std::vector<Component> const & components,
+                   Filter const &                 a,
+                   Filter const &                 b,
+                   bool                           isSomePassing,
+                   char const *                   what)
+{
+    // Components share their object with their copies: its address tells them apart.
+    std::vector<void const *> expected;
+    for (auto const & component : components)
+    {
+        if (a(component) && b(component))
+        {
+            expected.push_back(&component.getPointSet());
+        }
+    }
+    if (isSomePassing)
+    {
+        check(!expected.empty() && expected.size() < components.size(), what);
+    }
+    else
+    {
+        check(expected.empty(), what);
+    }
+
+    for (Filter const & combined : {a.combine(b), b.combine(a)})
+    {
+        bool isSame = true;
+        for (auto const & component : components)
+        {
+            isSame = isSame && combined(component) == (a(component) && b(component));
+        }
+        check(isSame, what);
+
+        std::vector<Component> survivors = components;
+        std::size_t const      removed   = combined.apply(survivors);
+        check(removed == components.size() - expected.size(), what);
+        bool isOrdered = survivors.size() == expected.size();
+        for (std::size_t i = 0; isOrdered && i < survivors.size(); ++i)
+        {
+            isOrdered = &survivors[i].getPointSet() == expected[i];
+        }
+        check(isOrdered, what);
+    }
+}
+
+int
+  main()
+{
+    CompositeObject const          composite(generateGrainField(384, 256, 120, 8));
+    std::vector<Component> const & components = composite.components;
+    check(components.size() > 20, "the grain field has many components");
+
+    Filter const overlapping  = createRimFilter(Point(20, 30), Point(300, 230));
+    Filter const shifted      = createRimFilter(Point(90, 0), Point(383, 200));
+    Filter const left         = createRimFilter(Point(0, 0), Point(150, 255));
+    Filter const right        = createRimFilter(Point(200, 0), Point(383, 255));
+    Filter const touchingLeft = createRimFilter(Point(0, 0), Point(200, 255));
+    checkCombination(components, overlapping, shifted, true, "overlapping rims");
+    checkCombination(components, left, right, false, "disjoint rims");
+    // Their intersection is the column x = 200, a border only.
+    checkCombination(components, touchingLeft, right, false, "rims meeting along a border");
+    checkCombination(components, overlapping, Filter(), true, "a rim and no criterion");
+
+    Filter areas      = overlapping;
+    areas.minimumArea = Area(40);
+    areas.maximumArea = Area(1500);
+    Filter shapes             = shifted;
+    shapes.maximumArea        = Area(900);
+    shapes.maximumAspectRatio = FloatScalar(2.);
+    checkCombination(components, areas, shapes, true, "areas and aspect ratios");
+
+    Filter round             = overlapping;
+    round.minimumCircularity = FloatScalar(0.6);
+    Filter notTooRound;
+    notTooRound.maximumCircularity = FloatScalar(0.95);
+    notTooRound.minimumArea        = Area(60);
+    checkCombination(components, round, notTooRound, true, "circularities");
+    checkCombination(components, left, round, true, "a rim and a circularity");
+
+    return reportChecks("filters");
+}
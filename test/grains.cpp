@@ -0,0 +1,119 @@
+#include "common.hpp"
+
+#include <vector>
+
+// Checks that the grain fields are reproducible, that the grains keep their distances
+// and that the streamed mask is the union of the grains digitised one by one.
+
+typedef typename GrainFieldGenerator::Parameters Parameters;
+typedef typename GrainFieldGenerator::Grain      Grain;
+typedef typename GrainFieldGenerator::Value      Value;
+typedef typename GrainFieldGenerator::Integer    Integer;
+
+/// \param generator
+/// \return rows of the mask, from the top one down, as streamed.
+std::vector<std::vector<Value>>
+  collectRows(GrainFieldGenerator const & generator)
+{
+    auto const                      width = static_cast<std::size_t>(generator.getParameters().width);
+    std::vector<std::vector<Value>> rows;
+    generator.forEachRow([&rows, width](Integer, Value const * data) { rows.emplace_back(data, data + width); });
+    return rows;
+}
+
+/// Mask of the grains digitised one by one, in the order of the rows of forEachRow.
+/// \param generator
+/// \return
+std::vector<std::vector<Value>>
+  digitizeGrains(GrainFieldGenerator const & generator)
+{
+    Parameters const &              p = generator.getParameters();
+    std::vector<std::vector<Value>> rows(static_cast<std::size_t>(p.height),
+                                         std::vector<Value>(static_cast<std::size_t>(p.width), 0));
+    Domain const                    domain = generator.getDomain();
+    for (auto const & grain : generator.getGrains())
+    {
+        auto const spans = GrainFieldGenerator::digitizeGrain(grain);
+        for (auto const & point : spans.domain())
+        {
+            if (domain.isInside(point) && spans(point))
+            {
+                rows[static_cast<std::size_t>(p.height - 1 - point[1])][static_cast<std::size_t>(point[0])] = 255;
+            }
+        }
+    }
+    return rows;
+}
+
+/// \param generator
+/// \param isTouching whether some grains are set against others.
+/// \param what
+void
+  checkDistances(GrainFieldGenerator const & generator, bool isTouching, char const * what)
+{
+    Parameters const &         p      = generator.getParameters();
+    std::vector<Grain> const & grains = generator.getGrains();
+    // Touching grains only keep their bounding circles apart.
+    double const gap = isTouching ? 0. : p.gap;
+    bool         isApart = true;
+    bool         isInMask = true;
+    for (std::size_t i = 0; i < grains.size(); ++i)
+    {
+        double const radius = GrainFieldGenerator::getBoundingRadius(grains[i]);
+        for (std::size_t j = i + 1; j < grains.size(); ++j)
+        {
+            double const dx       = grains[i].centre[0] - grains[j].centre[0];
+            double const dy       = grains[i].centre[1] - grains[j].centre[1];
+            double const distance = radius + GrainFieldGenerator::getBoundingRadius(grains[j]) + gap;
+            // Same rounding allowance as the generator.
+            isApart = isApart && dx * dx + dy * dy >= distance * distance - 1e-6;
+        }
+        // Bounding circles reach into the mask, whether on the rim or against another grain.
+        isInMask = isInMask && grains[i].centre[0] >= -radius && grains[i].centre[0] <= p.width - 1 + radius
+                   && grains[i].centre[1] >= -radius && grains[i].centre[1] <= p.height - 1 + radius;
+    }
+    check(isApart, what);
+    check(isInMask, what);
+}
+
+int
+  main()
+{
+    Parameters parameters;
+    parameters.width            = 400;
+    parameters.height           = 200;
+    parameters.numberGrains     = 120;
+    parameters.seed             = 5;
+    parameters.rimFraction      = 0.1;
+    parameters.touchingFraction = 0.3;
+    parameters.noise            = 0.01;
+
+    // (a) Same seed, same rows, noise included.
+    std::vector<std::vector<Value>> const rows = collectRows(GrainFieldGenerator(parameters));
+    check(rows.size() == static_cast<std::size_t>(parameters.height), "one call per row");
+    check(collectRows(GrainFieldGenerator(parameters)) == rows, "the same seed gives the same rows");
+    Parameters other = parameters;
+    other.seed       = 6;
+    check(collectRows(GrainFieldGenerator(other)) != rows, "another seed gives other rows");
+
+    // (b) Gaps between the bounding circles.
+    Parameters separate       = parameters;
+    separate.touchingFraction = 0.;
+    GrainFieldGenerator const separateGenerator(separate);
+    check(separateGenerator.getGrains().size() > 60, "most grains are placed");
+    checkDistances(separateGenerator, false, "non-touching grains keep the gap between their bounding circles");
+    checkDistances(GrainFieldGenerator(parameters), true, "touching grains do not overlap");
+
+    // (c) Without noise, the bands hold exactly the grains.
+    for (double touchingFraction : {0., 0.3})
+    {
+        Parameters noiseless       = parameters;
+        noiseless.noise            = 0.;
+        noiseless.touchingFraction = touchingFraction;
+        GrainFieldGenerator const generator(noiseless);
+        check(collectRows(generator) == digitizeGrains(generator),
+              "without noise, the mask is the union of the grains digitised on their own");
+    }
+
+    return reportChecks("grains");
+}
@@ -0,0 +1,120 @@
+#include "common.hpp"
+
+#include <util/common.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Checks the rotations of the Kabsch solver: known rotations are found back,
+// the closed-form 2D rotation is the best one among many angles,
+// and the 3D rotations are proper.
+
+typedef td::util::algorithms<double> Algorithms;
+typedef Algorithms::Matrix<2>        Matrix2;
+typedef Algorithms::Matrix<3>        Matrix3;
+
+static constexpr double c_tolerance = 1e-9;
+
+/// \param angle
+/// \return counterclockwise rotation.
+Matrix2
+  createRotation(double angle)
+{
+    Matrix2 rotation;
+    rotation << std::cos(angle), -std::sin(angle), std::sin(angle), std::cos(angle);
+    return rotation;
+}
+
+/// Random points rotated about the origin are rotated back by the solver.
+void
+  checkKnownRotations(std::uint64_t seed)
+{
+    std::mt19937_64                        generator(seed);
+    std::uniform_real_distribution<double> coordinate(-50., 50.);
+    bool                                   isFound = true;
+    for (double const angle : {0., 0.3, -1.2, 2.9, -3.1, 3.14159})
+    {
+        Matrix2 const          expected = createRotation(angle);
+        std::vector<RealPoint> points1;
+        std::vector<RealPoint> points2;
+        for (int i = 0; i < 20; ++i)
+        {
+            RealPoint const p(coordinate(generator), coordinate(generator));
+            points1.push_back(p);
+            points2.emplace_back(expected(0, 0) * p[0] + expected(0, 1) * p[1],
+                                 expected(1, 0) * p[0] + expected(1, 1) * p[1]);
+        }
+        Matrix2 const rotation = Algorithms::computeRotationKabsch(points1, points2);
+        isFound                = isFound && (rotation - expected).cwiseAbs().maxCoeff() <= c_tolerance;
+    }
+    check(isFound, "known 2D rotations");
+}
+
+/// The 2D rotation maximises trace(R H), is a proper rotation and agrees with the angle.
+void
+  checkClosedForm(std::vector<Matrix2> const & covariances)
+{
+    bool isBest   = true;
+    bool isProper = true;
+    bool isAngle  = true;
+    for (auto const & h : covariances)
+    {
+        Matrix2 const rotation = Algorithms::computeRotationKabsch<2>(h);
+        double const  best     = (rotation * h).trace();
+        for (int k = 0; k < 360; ++k)
+        {
+            double const angle = k * td::util::maths<double>::pi() / 180.;
+            isBest             = isBest && (createRotation(angle) * h).trace() <= best + c_tolerance;
+        }
+        Matrix2 const product = rotation * rotation.transpose();
+        isProper              = isProper && (product - Matrix2::Identity()).cwiseAbs().maxCoeff() <= c_tolerance;
+        isProper              = isProper && std::abs(rotation.determinant() - 1.) <= c_tolerance;
+        double const angle = Algorithms::computeRotationAngleKabsch(h);
+        isAngle            = isAngle && (rotation - createRotation(angle)).cwiseAbs().maxCoeff() <= c_tolerance;
+    }
+    check(isBest, "the 2D rotation is the best one");
+    check(isProper, "the 2D rotation is proper");
+    check(isAngle, "the 2D rotation has the angle of computeRotationAngleKabsch");
+}
+
+int
+  main()
+{
+    checkKnownRotations(3);
+
+    std::mt19937_64                        generator(11);
+    std::uniform_real_distribution<double> entry(-10., 10.);
+    std::vector<Matrix2>                   covariances2;
+    std::vector<Matrix3>                   covariances3;
+    for (int i = 0; i < 200; ++i)
+    {
+        Matrix2 h2;
+        h2 << entry(generator), entry(generator), entry(generator), entry(generator);
+        covariances2.push_back(h2);
+        Matrix3 h3;
+        for (int k = 0; k < 9; ++k)
+        {
+            h3(k / 3, k % 3) = entry(generator);
+        }
+        covariances3.push_back(h3);
+    }
+    // A null covariance, for which every rotation is as good.
+    covariances2.push_back(Matrix2::Zero());
+    checkClosedForm(covariances2);
+    check(Algorithms::computeRotationKabsch<2>(Matrix2::Zero()) == Matrix2::Identity(),
+          "identity for a null covariance");
+
+    bool isProper3 = true;
+    for (auto const & h : covariances3)
+    {
+        Matrix3 const rotation = Algorithms::computeRotationKabsch<3>(h);
+        Matrix3 const product  = rotation * rotation.transpose();
+        isProper3              = isProper3 && (product - Matrix3::Identity()).cwiseAbs().maxCoeff() <= c_tolerance;
+        isProper3              = isProper3 && std::abs(rotation.determinant() - 1.) <= c_tolerance;
+    }
+    check(isProper3, "the 3D rotation is proper");
+
+    return reportChecks("kabsch");
+}
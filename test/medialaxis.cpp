@@ -0,0 +1,105 @@
+#include "common.hpp"
+
+#include <vector>
+
+// Checks the thickness given by the reduced medial axis on shapes of known thickness,
+// and the sign of the distance to the boundary of the components.
+
+typedef typename Component::Object   Object;
+typedef typename Component::PointSet PointSet;
+typedef typename Component::Integer  Integer;
+
+/// \param points of a single 4-connected component.
+/// \param lower of the bounding box of the points.
+/// \param upper of the bounding box of the points.
+/// \return
+Component
+  createComponent(std::vector<Point> const & points, Point const & lower, Point const & upper)
+{
+    // Over the window of the component, as the composite objects build them.
+    PointSet set(Domain(lower - Point::diagonal(), upper + Point::diagonal()));
+    for (auto const & point : points)
+    {
+        set.insert(point);
+    }
+    return Component(Object(DGtal::Z2i::dt4_8, set));
+}
+
+/// Rectangle much longer than wide, its thickness is its width.
+/// \param width odd, so that the medial axis runs along a row of pixels.
+/// \return
+Component
+  createBand(Integer width)
+{
+    Point const        upper(8 * width, width - 1);
+    std::vector<Point> points;
+    for (auto const & point : Domain(Point(0, 0), upper))
+    {
+        points.push_back(point);
+    }
+    return createComponent(points, Point(0, 0), upper);
+}
+
+/// Points at a distance strictly less than radius from the origin:
+/// the nearest point of the background, (radius, 0), is at a distance radius from the centre.
+/// \param radius
+/// \return
+Component
+  createDisc(Integer radius)
+{
+    std::vector<Point> points;
+    for (auto const & point : Domain(Point(-radius, -radius), Point(radius, radius)))
+    {
+        if (point[0] * point[0] + point[1] * point[1] < radius * radius)
+        {
+            points.push_back(point);
+        }
+    }
+    return createComponent(points, Point(1 - radius, 1 - radius), Point(radius - 1, radius - 1));
+}
+
+/// The signed distance is negative or zero on the component only, on the window and beyond.
+/// \param component
+/// \param what
+void
+  checkSignedDistance(Component const & component, char const * what)
+{
+    Domain const window = component.getWindow();
+    bool         isSign = true;
+    for (auto const & point : Domain(window.lowerBound() - Point(3, 3), window.upperBound() + Point(3, 3)))
+    {
+        bool const isOnComponent = window.isInside(point) && component.getPointSet()(point);
+        isSign                   = isSign && (component.getSignedDistance(point) <= 0.) == isOnComponent;
+    }
+    check(isSign, what);
+}
+
+int
+  main()
+{
+    for (Integer width : {1, 3, 5, 9})
+    {
+        Component const band = createBand(width);
+        check(band.getMedialAxis().maximumThickness == static_cast<Perimeter>(width),
+              "a band n pixels wide is n thick");
+        checkSignedDistance(band, "signed distance of a band");
+    }
+
+    for (Integer radius : {2, 5, 12})
+    {
+        Component const disc = createDisc(radius);
+        check(disc.getMedialAxis().maximumThickness == static_cast<Perimeter>(2 * radius - 1),
+              "a disc of radius r is 2r - 1 thick at most");
+        checkSignedDistance(disc, "signed distance of a disc");
+    }
+
+    // Components of any shape, from a grain field.
+    CompositeObject const composite(generateGrainField(256, 256, 40, 11));
+    check(composite.components.size() > 5, "the grain field has many components");
+    for (auto const & component : composite.components)
+    {
+        checkSignedDistance(component, "signed distance of a grain");
+    }
+
+    return reportChecks("medialaxis");
+}
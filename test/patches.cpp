@@ -0,0 +1,105 @@
+#include "common.hpp"
+
+#include <DGtal/base/Exceptions.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Checks the components of a patched object against those of the object built again from the patched image,
+// also when the patch cuts a component culled at the rim, and that no patch is applied once the object was culled.
+
+/// Fills a disc of the image with a value.
+void
+  paintDisc(Image & image, Point const & centre, int radius, typename Image::Value value)
+{
+    for (int y = -radius; y <= radius; ++y)
+    {
+        for (int x = -radius; x <= radius; ++x)
+        {
+            Point const point = centre + Point(x, y);
+            if (x * x + y * y <= radius * radius && image.domain().isInside(point))
+            {
+                image.setValue(point, value);
+            }
+        }
+    }
+}
+
+/// Sorted lowest points and sizes of the components, independent of their order.
+std::vector<std::pair<Point, std::size_t>>
+  describeComponents(CompositeObject const & composite)
+{
+    std::vector<std::pair<Point, std::size_t>> description;
+    for (auto const & component : composite.components)
+    {
+        auto const & points = component.getPointSet();
+        description.emplace_back(*std::min_element(points.begin(), points.end()), points.size());
+    }
+    std::sort(description.begin(), description.end());
+    return description;
+}
+
+int
+  main()
+{
+    Image const           image = generateGrainField(384, 256, 120, 21);
+    CompositeObject const composite(image);
+    check(composite.components.size() > 10, "the grain field has many components");
+
+    // A disc joining grains, a disc cutting through some, and a grain removed at the border of the region.
+    Image patched = image;
+    paintDisc(patched, Point(120, 100), 18, 255);
+    paintDisc(patched, Point(200, 140), 12, 0);
+    paintDisc(patched, Point(160, 60), 9, 255);
+    Domain const region(Point(90, 40), Point(230, 170));
+
+    CompositeObject patchedComposite = composite;
+    patchedComposite.applyPatch(region, patched);
+    CompositeObject const rebuilt(patched);
+    check(describeComponents(patchedComposite) == describeComponents(rebuilt), "same components as rebuilt");
+    // Both ways, through the distance transforms of the background.
+    check(patchedComposite.computeHausdorffDistance(rebuilt) == 0., "same distances as rebuilt");
+    check(rebuilt.computeHausdorffDistance(patchedComposite) == 0., "same distances as patched");
+
+    // The patched object is left as it was after a patch of the same pixels.
+    std::size_t const numberComponents = patchedComposite.components.size();
+    check(patchedComposite.applyPatch(region, patched) == 0, "no new component for the same pixels");
+    check(patchedComposite.components.size() == numberComponents, "no component lost for the same pixels");
+
+    // A lone disc at the rim is culled. A patch meeting the rim cuts it along a band:
+    // the piece left off the rim is a new component, though none of its points had one before.
+    Image rimImage = image;
+    paintDisc(rimImage, Point(0, 128), 40, 0);
+    paintDisc(rimImage, Point(0, 128), 30, 255);
+    CompositeObject rimComposite(rimImage);
+    Image           rimPatched = rimImage;
+    for (int y = 95; y <= 161; ++y)
+    {
+        for (int x = 10; x <= 13; ++x)
+        {
+            rimPatched.setValue(Point(x, y), 0);
+        }
+    }
+    Domain const rimRegion(Point(0, 90), Point(40, 170));
+    check(rimComposite.applyPatch(rimRegion, rimPatched) == 1, "the piece off the rim is new");
+    CompositeObject const rimRebuilt(rimPatched);
+    check(describeComponents(rimComposite) == describeComponents(rimRebuilt), "same components as rebuilt at the rim");
+
+    // Culled, the largest component can't be found again: the patch throws in every build.
+    CompositeObject culled = composite;
+    culled.cullAllButLargestComponent();
+    bool isThrown = false;
+    try
+    {
+        culled.applyPatch(region, patched);
+    }
+    catch (DGtal::InputException const &)
+    {
+        isThrown = true;
+    }
+    check(isThrown, "no patch after culling");
+    check(culled.components.size() == 1, "the culled object is left as it was");
+
+    return reportChecks("patches");
+}
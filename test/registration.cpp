@@ -0,0 +1,159 @@
+#include "common.hpp"
+
+#include <util/UniformGrid2D.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Checks the nearest points of the uniform grid against a brute force,
+// and the rigid registration against the nearest boundary points found by trying them all.
+
+typedef td::util::UniformGrid2D<RealPoint>     UniformGrid;
+typedef typename CompositeObject::Registration Registration;
+typedef typename CompositeObject::RealVector   RealVector;
+
+/// Smallest squared distance from a point to the set, by trying them all.
+double
+  computeSquaredDistance(RealPoint const & query, std::vector<RealPoint> const & points)
+{
+    double smallest = std::numeric_limits<double>::max();
+    for (auto const & point : points)
+    {
+        RealVector const d = point - query;
+        smallest           = std::min(smallest, d[0] * d[0] + d[1] * d[1]);
+    }
+    return smallest;
+}
+
+/// Nearest points of the grid at the same distance as the brute force, for queries inside and around it.
+void
+  checkGrid(std::vector<RealPoint> const & points, double cellSize, std::uint64_t seed, char const * what)
+{
+    UniformGrid const grid(points, cellSize);
+    check(grid.size() == points.size(), what);
+
+    RealPoint lower = points.front();
+    RealPoint upper = points.front();
+    for (auto const & point : points)
+    {
+        lower = lower.inf(point);
+        upper = upper.sup(point);
+    }
+    // Far enough around the grid for the clamped cells of the queries to be away from them.
+    double const                           margin = 10. * cellSize;
+    std::mt19937_64                        generator(seed);
+    std::uniform_real_distribution<double> x(lower[0] - margin, upper[0] + margin);
+    std::uniform_real_distribution<double> y(lower[1] - margin, upper[1] + margin);
+    bool                                   isNearest = true;
+    bool                                   isMember  = true;
+    for (int i = 0; i < 2000; ++i)
+    {
+        RealPoint const   query    = RealPoint(x(generator), y(generator));
+        RealPoint const & nearest  = grid.findNearest(query);
+        RealVector const  d        = nearest - query;
+        double const      expected = computeSquaredDistance(query, points);
+        isNearest = isNearest && std::abs(d[0] * d[0] + d[1] * d[1] - expected) <= 1e-9 * std::max(1., expected);
+        isMember  = isMember && std::find(points.begin(), points.end(), nearest) != points.end();
+    }
+    check(isNearest, what);
+    check(isMember, what);
+}
+
+/// Keyhole: a disc and a bar below it, with no rotational symmetry for the registration to confuse.
+bool
+  isInKeyhole(RealPoint const & point)
+{
+    RealVector const d = point - RealPoint(110., 100.);
+    return d[0] * d[0] + d[1] * d[1] <= 30. * 30. || (std::abs(d[0]) <= 8. && d[1] >= 0. && d[1] <= 70.);
+}
+
+/// Pixels of the keyhole moved by a rigid transformation, painted from the inverse one so that no pixel is missed.
+Image
+  paintKeyhole(Domain const & domain, RealPoint const & centre, double angle, RealVector const & translation)
+{
+    double const c = std::cos(angle);
+    double const s = std::sin(angle);
+    Image        image(domain);
+    for (auto const & point : domain)
+    {
+        RealVector const d = RealPoint(point[0], point[1]) - centre - translation;
+        RealPoint const  preimage(c * d[0] + s * d[1] + centre[0], -s * d[0] + c * d[1] + centre[1]);
+        image.setValue(point, isInKeyhole(preimage) ? 255 : 0);
+    }
+    return image;
+}
+
+int
+  main()
+{
+    // Spread points, clustered points leaving most cells empty, collinear points and a single point.
+    std::mt19937_64                        generator(3);
+    std::uniform_real_distribution<double> spread(-50., 150.);
+    std::normal_distribution<double>       cluster(0., 3.);
+    std::vector<RealPoint>                 spreadPoints;
+    std::vector<RealPoint>                 clusteredPoints;
+    std::vector<RealPoint>                 collinearPoints;
+    for (int i = 0; i < 400; ++i)
+    {
+        spreadPoints.emplace_back(spread(generator), spread(generator));
+        RealPoint const clusterCentre = i % 2 == 0 ? RealPoint(-40., 20.) : RealPoint(90., 130.);
+        clusteredPoints.push_back(clusterCentre + RealVector(cluster(generator), cluster(generator)));
+        collinearPoints.emplace_back(0.5 * i, 10. + 0.25 * i);
+    }
+    for (double const cellSize : {1., 4., 25.})
+    {
+        checkGrid(spreadPoints, cellSize, 5, "nearest of spread points");
+        checkGrid(clusteredPoints, cellSize, 6, "nearest of clustered points");
+        checkGrid(collinearPoints, cellSize, 7, "nearest of collinear points");
+        checkGrid({RealPoint(12.5, -3.)}, cellSize, 8, "nearest of a single point");
+    }
+
+    // The other keyhole is moved by a known transformation, the registration brings it back.
+    Domain const     domain(Point(0, 0), Point(255, 255));
+    RealPoint const  centre(128., 128.);
+    double const     angle = 0.2;
+    RealVector const translation(6., -4.);
+    CompositeObject  keyhole(paintKeyhole(domain, centre, 0., RealVector(0., 0.)));
+    CompositeObject  moved(paintKeyhole(domain, centre, angle, translation));
+    keyhole.cullAllButLargestComponent();
+    moved.cullAllButLargestComponent();
+    Registration const registration = keyhole.computeRegistration(moved);
+
+    std::vector<RealPoint> target;
+    for (auto const & point : keyhole.components.front().getBoundaryPoints())
+    {
+        target.emplace_back(point[0], point[1]);
+    }
+    // Brute force distances of the returned transformation, over every boundary point:
+    // no larger than those of the last correspondences, the transformation was improved after them if at all.
+    double const c          = std::cos(registration.angle);
+    double const s          = std::sin(registration.angle);
+    double const cBack      = std::cos(-angle);
+    double const sBack      = std::sin(-angle);
+    double       sumSquared = 0.;
+    double       largestError = 0.;
+    std::size_t  numberPoints = 0;
+    for (auto const & point : moved.components.front().getBoundaryPoints())
+    {
+        RealVector const d = RealPoint(point[0], point[1]) - registration.centre;
+        RealPoint const  y = RealPoint(c * d[0] - s * d[1], s * d[0] + c * d[1]) + registration.centre
+                            + registration.translation;
+        sumSquared += computeSquaredDistance(y, target);
+        ++numberPoints;
+        // Where the known transformation brings the point back.
+        RealVector const e = RealPoint(point[0], point[1]) - centre - translation;
+        RealPoint const  expected = RealPoint(cBack * e[0] - sBack * e[1], sBack * e[0] + cBack * e[1]) + centre;
+        largestError              = std::max(largestError, (y - expected).norm());
+    }
+    double const rms = std::sqrt(sumSquared / static_cast<double>(numberPoints));
+    check(rms <= registration.rms + 1e-9, "rms of the last correspondences");
+    check(registration.rms < 1., "the boundaries are aligned");
+    check(std::abs(registration.angle + angle) < 0.02, "angle brought back");
+    check(largestError < 2., "points brought back");
+
+    return reportChecks("registration");
+}
@@ -0,0 +1,143 @@
+#include "common.hpp"
+
+#include <util/ShapeIndex.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Checks the nearest signatures of the shape index against the distances to every signature, in double precision,
+// that queries from several threads at once agree with a single one,
+// and that a shape of the index is found first when searched for.
+
+typedef td::util::ShapeIndex<dimension, DigitalTopology> ShapeIndex;
+typedef typename ShapeIndex::Signature                   Signature;
+typedef typename ShapeIndex::Match                       Match;
+
+// Relative to the distances, the index sums them in single precision.
+static constexpr double c_tolerance = 1e-4;
+
+/// Distances from a signature to every signature, each coordinate divided by its deviation over all of them.
+std::vector<double>
+  computeDistances(std::vector<Signature> const & signatures, Signature const & query)
+{
+    auto const          count = static_cast<double>(signatures.size());
+    std::vector<double> squared(signatures.size(), 0.);
+    for (std::size_t d = 0; d < ShapeIndex::c_signatureSize; ++d)
+    {
+        double mean = 0.;
+        for (auto const & signature : signatures)
+        {
+            mean += signature[d] / count;
+        }
+        double variance = 0.;
+        for (auto const & signature : signatures)
+        {
+            variance += (signature[d] - mean) * (signature[d] - mean) / count;
+        }
+        double const scale = variance > 0. ? 1. / std::sqrt(variance) : 1.;
+        for (std::size_t i = 0; i < signatures.size(); ++i)
+        {
+            double const diff = (static_cast<double>(signatures[i][d]) - query[d]) * scale;
+            squared[i] += diff * diff;
+        }
+    }
+    std::vector<double> distances;
+    for (double const s : squared)
+    {
+        distances.push_back(std::sqrt(s));
+    }
+    return distances;
+}
+
+/// The k smallest distances, in increasing order, each one reported for its shape.
+void
+  checkNearestSignatures(ShapeIndex const &             index,
+                         std::vector<Signature> const & signatures,
+                         Signature const &              query,
+                         std::size_t                    k,
+                         char const *                   what)
+{
+    std::vector<Match> const  matches   = index.findNearestSignatures(query, k);
+    std::vector<double> const distances = computeDistances(signatures, query);
+    std::vector<double>       smallest  = distances;
+    std::sort(smallest.begin(), smallest.end());
+    check(matches.size() == std::min(k, signatures.size()), what);
+
+    bool isSame = true;
+    for (std::size_t i = 0; i < matches.size() && i < smallest.size(); ++i)
+    {
+        double const tolerance = c_tolerance * std::max(1., smallest[i]);
+        double const expected  = distances[matches[i].index];
+        // Shapes at nearly the same distance may come in either order, the distances may not.
+        isSame = isSame && std::abs(matches[i].signatureDistance - expected) <= tolerance
+                 && std::abs(expected - smallest[i]) <= tolerance;
+    }
+    check(isSame, what);
+}
+
+int
+  main()
+{
+    // The largest grain of each field, of many kinds and sizes.
+    ShapeIndex             index;
+    std::vector<Signature> signatures;
+    for (std::uint64_t seed = 1; seed <= 24; ++seed)
+    {
+        CompositeObject shape(generateGrainField(192, 192, 40, seed));
+        shape.cullAllButLargestComponent();
+        signatures.push_back(ShapeIndex::computeSignature(shape.components.front()));
+        check(index.add(shape) == signatures.size() - 1, "index of the added shape");
+    }
+    check(index.size() == signatures.size(), "size of the index");
+
+    // Signatures of the index, with a single, some and more than all of the shapes.
+    for (std::size_t const k : {std::size_t(1), std::size_t(5), std::size_t(30)})
+    {
+        checkNearestSignatures(index, signatures, signatures[3], k, "nearest signatures of a shape");
+        checkNearestSignatures(index, signatures, signatures[17], k, "nearest signatures of another shape");
+    }
+    // A signature which is not in the index.
+    CompositeObject outside(generateGrainField(192, 192, 40, 101));
+    outside.cullAllButLargestComponent();
+    checkNearestSignatures(
+      index, signatures, ShapeIndex::computeSignature(outside.components.front()), 8, "nearest signatures of a query");
+
+    // The index is only read by the queries.
+    std::vector<Match> const        single = index.findNearestSignatures(signatures[5], 6);
+    std::vector<std::vector<Match>> results(4);
+    std::vector<std::thread>        threads;
+    for (auto & result : results)
+    {
+        threads.emplace_back([&index, &signatures, &result]() { result = index.findNearestSignatures(signatures[5], 6); });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    bool isSame = true;
+    for (auto const & result : results)
+    {
+        for (std::size_t i = 0; isSame && i < single.size(); ++i)
+        {
+            isSame = result.size() == single.size() && result[i].index == single[i].index
+                     && result[i].signatureDistance == single[i].signatureDistance;
+        }
+    }
+    check(isSame, "same nearest signatures from several threads");
+
+    // A shape of the index is at no distance of itself, the others come after it.
+    std::vector<Match> const matches = index.findNearest(index.getShape(9), 4, 8);
+    check(matches.size() == 4, "number of nearest shapes");
+    check(!matches.empty() && matches.front().index == 9 && matches.front().distance == 0., "the shape comes first");
+    bool isSorted = true;
+    for (std::size_t i = 1; i < matches.size(); ++i)
+    {
+        isSorted = isSorted && matches[i - 1].distance <= matches[i].distance;
+    }
+    check(isSorted, "nearest shapes by increasing distance");
+
+    return reportChecks("shapeindex");
+}
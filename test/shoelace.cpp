@@ -0,0 +1,169 @@
+#include "common.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Checks the exact areas of the shoelace formula, over the convex hulls of shapes whose area is known,
+// and its independence from the position of the shapes.
+
+typedef typename Component::Object      Object;
+typedef typename Component::PointSet    PointSet;
+typedef typename Component::Integer     Integer;
+typedef typename Component::Area        Area;
+typedef typename Component::PolygonArea PolygonArea;
+
+/// \param pixels of a single 4-connected component.
+/// \return
+Component
+  createComponent(std::vector<Point> const & pixels)
+{
+    Point lower = pixels.front();
+    Point upper = pixels.front();
+    for (auto const & pixel : pixels)
+    {
+        lower = lower.inf(pixel);
+        upper = upper.sup(pixel);
+    }
+    // Over the window of the component, as the composite objects build them.
+    PointSet set(Domain(lower - Point::diagonal(), upper + Point::diagonal()));
+    for (auto const & pixel : pixels)
+    {
+        set.insert(pixel);
+    }
+    return Component(Object(DGtal::Z2i::dt4_8, set));
+}
+
+/// \param pixels
+/// \param offset
+/// \return
+std::vector<Point>
+  translate(std::vector<Point> pixels, Point const & offset)
+{
+    for (auto & pixel : pixels)
+    {
+        pixel += offset;
+    }
+    return pixels;
+}
+
+/// Mirror image about the vertical axis.
+/// \param pixels
+/// \return
+std::vector<Point>
+  mirror(std::vector<Point> pixels)
+{
+    for (auto & pixel : pixels)
+    {
+        pixel[0] = -pixel[0];
+    }
+    return pixels;
+}
+
+/// \param width
+/// \param height
+/// \return
+std::vector<Point>
+  createRectangle(Integer width, Integer height)
+{
+    std::vector<Point> pixels;
+    for (auto const & pixel : Domain(Point(0, 0), Point(width - 1, height - 1)))
+    {
+        pixels.push_back(pixel);
+    }
+    return pixels;
+}
+
+/// Arms 6 pixels long and 2 pixels wide.
+/// The hull of its corners is (0, 0), (6, 0), (6, 2), (2, 6), (0, 6), of area 28.
+/// \return
+std::vector<Point>
+  createL()
+{
+    std::vector<Point> pixels;
+    for (auto const & pixel : Domain(Point(0, 0), Point(5, 5)))
+    {
+        if (pixel[0] < 2 || pixel[1] < 2)
+        {
+            pixels.push_back(pixel);
+        }
+    }
+    return pixels;
+}
+
+/// Pixels (i, i) and (i + 1, i) for i in [0, numberSteps).
+/// The hull of its corners is (0, 0), (2, 0), (n + 1, n - 1), (n + 1, n), (n - 1, n), (0, 1), of area 3n - 1,
+/// and its two long sides go through n pointels of the boundary each: collinear vertices.
+/// \param numberSteps
+/// \return
+std::vector<Point>
+  createStaircase(Integer numberSteps)
+{
+    std::vector<Point> pixels;
+    for (Integer i = 0; i < numberSteps; ++i)
+    {
+        pixels.emplace_back(i, i);
+        pixels.emplace_back(i + 1, i);
+    }
+    return pixels;
+}
+
+/// The hull area of the shape is the expected one, wherever the shape lies.
+/// \param pixels
+/// \param area
+/// \param what
+void
+  checkHullArea(std::vector<Point> const & pixels, Area area, char const * what)
+{
+    check(createComponent(pixels).getConvexHullArea(PolygonArea::Shoelace) == area, what);
+    // Far from the origin, the cross products of the absolute coordinates would not fit in a double exactly.
+    Component const far = createComponent(translate(pixels, Point(1 << 28, -(1 << 28))));
+    check(far.getConvexHullArea(PolygonArea::Shoelace) == area, what);
+}
+
+/// The segmentation repeats the end point shared by consecutive segments,
+/// its area does not depend on where the shape lies either.
+/// \param pixels
+/// \param what
+void
+  checkSegmentationArea(std::vector<Point> const & pixels, char const * what)
+{
+    Area const area = createComponent(pixels).getSegmentationArea(PolygonArea::Shoelace);
+    Component const far = createComponent(translate(pixels, Point(-(1 << 28), 1 << 28)));
+    check(area > 0. && far.getSegmentationArea(PolygonArea::Shoelace) == area, what);
+    // Vertices on the pixel corners: twice the area is an integer.
+    check(2. * area == static_cast<Area>(static_cast<std::int64_t>(2. * area)), what);
+}
+
+int
+  main()
+{
+    std::vector<std::pair<Integer, Integer>> const rectangles = {{1, 1}, {7, 3}, {2, 40}, {25, 25}};
+    for (auto const & [width, height] : rectangles)
+    {
+        checkHullArea(createRectangle(width, height),
+                      static_cast<Area>(width * height),
+                      "the hull of an axis-aligned rectangle is the rectangle");
+    }
+    checkSegmentationArea(createRectangle(7, 3), "segmentation area of a rectangle");
+    checkSegmentationArea(createRectangle(2, 40), "segmentation area of a thin rectangle");
+
+    // The shapes and their mirror images, of the same areas.
+    checkHullArea(createL(), 28., "hull of an L");
+    checkHullArea(mirror(createL()), 28., "hull of a mirrored L");
+    checkSegmentationArea(createL(), "segmentation area of an L");
+    checkSegmentationArea(mirror(createL()), "segmentation area of a mirrored L");
+
+    for (Integer numberSteps : {1, 2, 5, 17})
+    {
+        checkHullArea(createStaircase(numberSteps),
+                      static_cast<Area>(3 * numberSteps - 1),
+                      "hull of a staircase, with collinear vertices");
+        checkHullArea(mirror(createStaircase(numberSteps)),
+                      static_cast<Area>(3 * numberSteps - 1),
+                      "hull of a mirrored staircase, with collinear vertices");
+        checkSegmentationArea(createStaircase(numberSteps), "segmentation area of a staircase");
+    }
+
+    return reportChecks("shoelace");
+}
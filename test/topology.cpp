@@ -0,0 +1,287 @@
+#include "common.hpp"
+
+#include <util/FlatTopology2D.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <set>
+#include <tuple>
+#include <vector>
+
+// Checks the flat labelling against a breadth-first search over the pixels,
+// and the flat tracking against the cracks between each component, holes filled, and the rest of the plane.
+
+typedef td::util::FlatPoint2D FlatPoint2D;
+typedef td::util::FlatMask2D  FlatMask2D;
+// Pointel it starts from and direction (0: +x, 1: +y, 2: -x, 3: -y).
+typedef std::tuple<std::int32_t, std::int32_t, int> Crack;
+
+/// Pixels set over a box, with a background frame as wide as the neighbourhoods.
+class Raster
+{
+   public:
+    Raster(FlatPoint2D lower, FlatPoint2D upper)
+        : m_lower({lower.x - 1, lower.y - 1}),
+          m_width(upper.x - lower.x + 3),
+          m_height(upper.y - lower.y + 3),
+          m_data(static_cast<std::size_t>(m_width * m_height), 0)
+    {}
+
+    [[nodiscard]] bool
+      isInside(FlatPoint2D point) const
+    {
+        return point.x >= m_lower.x && point.y >= m_lower.y && point.x < m_lower.x + m_width
+               && point.y < m_lower.y + m_height;
+    }
+    [[nodiscard]] bool
+      operator()(FlatPoint2D point) const
+    {
+        return isInside(point) && m_data[getIndex(point)] != 0;
+    }
+    void
+      set(FlatPoint2D point, bool value = true)
+    {
+        m_data[getIndex(point)] = value ? 1 : 0;
+    }
+
+    /// Points in raster order: rows from bottom to top, left to right.
+    [[nodiscard]] std::vector<FlatPoint2D>
+      getPoints(bool value = true) const
+    {
+        std::vector<FlatPoint2D> points;
+        for (std::int32_t y = m_lower.y; y < m_lower.y + m_height; ++y)
+        {
+            for (std::int32_t x = m_lower.x; x < m_lower.x + m_width; ++x)
+            {
+                if ((*this)({x, y}) == value)
+                {
+                    points.push_back({x, y});
+                }
+            }
+        }
+        return points;
+    }
+
+    /// Points connected to a seed with the same value, in the order they are reached.
+    [[nodiscard]] std::vector<FlatPoint2D>
+      searchComponent(FlatPoint2D seed, int adjacency, std::vector<std::uint8_t> & isVisited) const
+    {
+        bool const               value = (*this)(seed);
+        std::vector<FlatPoint2D> component;
+        std::deque<FlatPoint2D>  queue = {seed};
+        isVisited[getIndex(seed)]      = 1;
+        while (!queue.empty())
+        {
+            FlatPoint2D const point = queue.front();
+            queue.pop_front();
+            component.push_back(point);
+            for (std::int32_t dy = -1; dy <= 1; ++dy)
+            {
+                for (std::int32_t dx = -1; dx <= 1; ++dx)
+                {
+                    FlatPoint2D const neighbour = {point.x + dx, point.y + dy};
+                    if ((dx == 0 && dy == 0) || (adjacency == 4 && dx != 0 && dy != 0) || !isInside(neighbour)
+                        || isVisited[getIndex(neighbour)] != 0 || (*this)(neighbour) != value)
+                    {
+                        continue;
+                    }
+                    isVisited[getIndex(neighbour)] = 1;
+                    queue.push_back(neighbour);
+                }
+            }
+        }
+        return component;
+    }
+
+    [[nodiscard]] std::size_t
+      getIndex(FlatPoint2D point) const
+    {
+        return static_cast<std::size_t>((point.y - m_lower.y) * m_width + (point.x - m_lower.x));
+    }
+    [[nodiscard]] std::vector<std::uint8_t>
+      createVisits() const
+    {
+        return std::vector<std::uint8_t>(m_data.size(), 0);
+    }
+
+   private:
+    FlatPoint2D               m_lower;
+    std::int32_t              m_width;
+    std::int32_t              m_height;
+    std::vector<std::uint8_t> m_data;
+};
+
+bool
+  isBefore(FlatPoint2D a, FlatPoint2D b)
+{
+    return a.y < b.y || (a.y == b.y && a.x < b.x);
+}
+
+bool
+  isSame(std::vector<FlatPoint2D> const & a, std::vector<FlatPoint2D> const & b)
+{
+    return std::equal(a.begin(),
+                      a.end(),
+                      b.begin(),
+                      b.end(),
+                      [](FlatPoint2D p, FlatPoint2D q) { return p.x == q.x && p.y == q.y; });
+}
+
+/// Components by breadth-first search, ordered as the flat labelling orders them.
+std::vector<std::vector<FlatPoint2D>>
+  labelComponents(Raster const & raster, int adjacency)
+{
+    std::vector<std::vector<FlatPoint2D>> components;
+    std::vector<std::uint8_t>             isVisited = raster.createVisits();
+    // The seeds come in raster order, so do the components.
+    for (FlatPoint2D const point : raster.getPoints())
+    {
+        if (isVisited[raster.getIndex(point)] == 0)
+        {
+            std::vector<FlatPoint2D> component = raster.searchComponent(point, adjacency, isVisited);
+            std::sort(component.begin(), component.end(), isBefore);
+            components.push_back(std::move(component));
+        }
+    }
+    return components;
+}
+
+/// Cracks between a component, its holes filled, and the rest of the plane, the component being on their left.
+std::set<Crack>
+  computeOuterCracks(std::vector<FlatPoint2D> const & component, FlatPoint2D lower, FlatPoint2D upper, int adjacency)
+{
+    Raster filled(lower, upper);
+    for (FlatPoint2D const point : component)
+    {
+        filled.set(point);
+    }
+    // The background reached from the frame has the other adjacency, the rest of it is holes.
+    std::vector<std::uint8_t>      isVisited = filled.createVisits();
+    FlatPoint2D const              corner    = {lower.x - 1, lower.y - 1};
+    std::vector<FlatPoint2D> const outside   = filled.searchComponent(corner, adjacency == 4 ? 8 : 4, isVisited);
+    std::vector<FlatPoint2D> const background = filled.getPoints(false);
+    for (FlatPoint2D const point : background)
+    {
+        filled.set(point);
+    }
+    for (FlatPoint2D const point : outside)
+    {
+        filled.set(point, false);
+    }
+
+    std::set<Crack> cracks;
+    for (FlatPoint2D const p : filled.getPoints())
+    {
+        if (!filled({p.x, p.y - 1}))
+        {
+            cracks.emplace(p.x, p.y, 0);
+        }
+        if (!filled({p.x + 1, p.y}))
+        {
+            cracks.emplace(p.x + 1, p.y, 1);
+        }
+        if (!filled({p.x, p.y + 1}))
+        {
+            cracks.emplace(p.x + 1, p.y + 1, 2);
+        }
+        if (!filled({p.x - 1, p.y}))
+        {
+            cracks.emplace(p.x, p.y + 1, 3);
+        }
+    }
+    return cracks;
+}
+
+/// Directed cracks of the tracked pointels, each one once.
+std::set<Crack>
+  computeTrackedCracks(std::vector<FlatPoint2D> const & pointels, bool & isSimple)
+{
+    std::set<Crack> cracks;
+    isSimple = !pointels.empty();
+    for (std::size_t i = 0; i < pointels.size(); ++i)
+    {
+        FlatPoint2D const  p         = pointels[i];
+        FlatPoint2D const  q         = pointels[(i + 1) % pointels.size()];
+        std::int32_t const dx        = q.x - p.x;
+        std::int32_t const dy        = q.y - p.y;
+        int const          direction = dx == 1 ? 0 : dy == 1 ? 1 : dx == -1 ? 2 : 3;
+        isSimple = isSimple && std::abs(dx) + std::abs(dy) == 1 && cracks.emplace(p.x, p.y, direction).second;
+    }
+    return cracks;
+}
+
+template <int adjacency>
+void
+  checkTopology(FlatPoint2D lower, FlatPoint2D upper, double probability, std::uint64_t seed, char const * what)
+{
+    typedef td::util::FlatTopology2D<adjacency> FlatTopology;
+
+    std::mt19937_64             generator(seed);
+    std::bernoulli_distribution isSet(probability);
+    Raster                      raster(lower, upper);
+    FlatMask2D                  mask(lower, upper);
+    for (std::int32_t y = lower.y; y <= upper.y; ++y)
+    {
+        for (std::int32_t x = lower.x; x <= upper.x; ++x)
+        {
+            if (isSet(generator))
+            {
+                raster.set({x, y});
+                mask.set({x, y});
+            }
+        }
+    }
+
+    std::vector<std::vector<FlatPoint2D>> const expected   = labelComponents(raster, adjacency);
+    std::vector<std::vector<FlatPoint2D>> const components = FlatTopology::labelComponents(mask);
+    bool isLabelled = components.size() == expected.size();
+    for (std::size_t i = 0; isLabelled && i < components.size(); ++i)
+    {
+        isLabelled = isSame(components[i], expected[i]);
+    }
+    check(isLabelled, what);
+
+    bool isTracked = true;
+    for (auto const & component : expected)
+    {
+        // Built as the components build theirs, from their points.
+        std::vector<Point> points;
+        for (FlatPoint2D const point : component)
+        {
+            points.emplace_back(point.x, point.y);
+        }
+        std::vector<FlatPoint2D> const pointels = FlatTopology::trackBoundary(FlatMask2D(points));
+        bool                           isSimple = false;
+        std::set<Crack> const          cracks   = computeTrackedCracks(pointels, isSimple);
+        // Components are sorted, the first point is the lowest, leftmost one.
+        isTracked = isTracked && isSimple && pointels.front().x == component.front().x
+                    && pointels.front().y == component.front().y
+                    && cracks == computeOuterCracks(component, lower, upper, adjacency);
+    }
+    check(isTracked, what);
+}
+
+int
+  main()
+{
+    // Lower bounds below zero, sparse masks with many small components, dense ones with holes.
+    std::uint64_t seed = 1;
+    for (double const probability : {0.3, 0.55, 0.75})
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            checkTopology<4>({-13, -9}, {20, 14}, probability, seed++, "4-adjacency");
+            checkTopology<8>({-13, -9}, {20, 14}, probability, seed++, "8-adjacency");
+        }
+    }
+    // A single pixel, a single row and a single column.
+    checkTopology<4>({-3, -3}, {-3, -3}, 1., seed++, "4-adjacency, single pixel");
+    checkTopology<8>({-3, -3}, {-3, -3}, 1., seed++, "8-adjacency, single pixel");
+    checkTopology<4>({-20, 5}, {20, 5}, 0.6, seed++, "4-adjacency, single row");
+    checkTopology<8>({5, -20}, {5, 20}, 0.6, seed++, "8-adjacency, single column");
+
+    return reportChecks("topology");
+}
@@ -0,0 +1,367 @@
+#include "common.hpp"
+
+#include <util/BinaryVolume.hpp>
+#include <util/CompositeDigitalVolume.hpp>
+
+#include <DGtal/base/Exceptions.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Checks the reading and the bit packing of binary volumes,
+// then the labelling, the volume and the surfels of 3D components against a brute-force scan.
+
+typedef td::util::CompositeDigitalVolume<DGtal::Z3i::DT6_26> CompositeVolume;
+typedef typename CompositeVolume::Component                  Component3D;
+typedef td::util::BinaryVolume                               BinaryVolume;
+typedef typename BinaryVolume::Point                         Point3D;
+typedef typename BinaryVolume::Domain                        Domain3D;
+typedef typename BinaryVolume::Value                         Value;
+
+// First voxel, volume and number of surfels of a component.
+typedef std::tuple<Point3D, std::size_t, std::size_t> Measures;
+
+// Not a multiple of 64 voxels, so that rows and slices straddle the words.
+static Point3D const c_extent(7, 5, 3);
+
+/// Grey level of each voxel of the files, any value of 16 bits.
+/// \param point
+/// \return
+Value
+  getGreyLevel(Point3D const & point)
+{
+    return static_cast<Value>((point[0] * 7919 + point[1] * 104729 + point[2] * 1299709) % 65536);
+}
+
+/// \param bytesPerVoxel
+/// \param isBigEndian
+/// \return voxels of c_extent, x varying first, then y, then z.
+std::string
+  createVoxelBytes(int bytesPerVoxel, bool isBigEndian)
+{
+    std::string bytes;
+    for (auto const & point : Domain3D(Point3D::zero, c_extent - Point3D::diagonal()))
+    {
+        Value const value = getGreyLevel(point);
+        if (bytesPerVoxel == 1)
+        {
+            bytes.push_back(static_cast<char>(value & 0xff));
+        }
+        else
+        {
+            char const high = static_cast<char>(value >> 8);
+            char const low  = static_cast<char>(value & 0xff);
+            bytes.push_back(isBigEndian ? high : low);
+            bytes.push_back(isBigEndian ? low : high);
+        }
+    }
+    return bytes;
+}
+
+/// \param name
+/// \param contents
+/// \return path of a temporary file holding the contents.
+std::filesystem::path
+  writeFile(char const * name, std::string const & contents)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / name;
+    std::ofstream               os(path, std::ios::binary);
+    os << contents;
+    return path;
+}
+
+/// \param volume
+/// \param bytesPerVoxel of the file it was read from.
+/// \param threshold
+/// \return whether each voxel is foreground exactly when the grey level of the file is above the threshold.
+bool
+  isThresholded(BinaryVolume const & volume, int bytesPerVoxel, Value threshold)
+{
+    if (volume.domain().upperBound() != c_extent - Point3D::diagonal())
+    {
+        return false;
+    }
+    for (auto const & point : volume.domain())
+    {
+        Value const value = bytesPerVoxel == 1 ? static_cast<Value>(getGreyLevel(point) & 0xff) : getGreyLevel(point);
+        if (volume(point) != (value > threshold))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// \param read
+/// \return whether reading throws DGtal::IOException.
+template <class Read>
+bool
+  isThrowing(Read const & read)
+{
+    try
+    {
+        (void)read();
+    }
+    catch (DGtal::IOException const &)
+    {
+        return true;
+    }
+    return false;
+}
+
+void
+  checkImportRaw()
+{
+    std::filesystem::path const path8 = writeFile("td_volume_8.raw", createVoxelBytes(1, false));
+    check(isThresholded(BinaryVolume::importRaw(path8, c_extent, 100), 1, 100), "8-bit raw volume");
+
+    for (bool isBigEndian : {false, true})
+    {
+        auto const byteOrder = isBigEndian ? BinaryVolume::ByteOrder::BigEndian : BinaryVolume::ByteOrder::LittleEndian;
+        std::filesystem::path const path16 = writeFile("td_volume_16.raw", createVoxelBytes(2, isBigEndian));
+        check(isThresholded(BinaryVolume::importRaw(path16, c_extent, 30000, 2, byteOrder), 2, 30000),
+              "16-bit raw volume, in both byte orders");
+    }
+
+    std::string bytes = createVoxelBytes(1, false);
+    bytes.pop_back();
+    std::filesystem::path const truncated = writeFile("td_volume_truncated.raw", bytes);
+    check(isThrowing([&truncated]() { return BinaryVolume::importRaw(truncated, c_extent, 100); }),
+          "a raw volume missing its last voxel throws");
+}
+
+void
+  checkImportPGM3D()
+{
+    std::string const header = "# comment\n" + std::to_string(c_extent[0]) + ' ' + std::to_string(c_extent[1]) + ' '
+                               + std::to_string(c_extent[2]) + '\n';
+
+    std::filesystem::path const binary8 =
+      writeFile("td_volume_8.pgm3d", "P5-3D\n" + header + "255\n" + createVoxelBytes(1, true));
+    check(isThresholded(BinaryVolume::importPGM3D(binary8, 100), 1, 100), "8-bit binary PGM3D volume");
+
+    std::filesystem::path const binary16 =
+      writeFile("td_volume_16.pgm3d", "P5-3D\n" + header + "65535\n" + createVoxelBytes(2, true));
+    check(isThresholded(BinaryVolume::importPGM3D(binary16, 30000), 2, 30000), "16-bit binary PGM3D volume");
+
+    std::string ascii = "P2-3D\n" + header + "255\n";
+    for (auto const & point : Domain3D(Point3D::zero, c_extent - Point3D::diagonal()))
+    {
+        ascii += std::to_string(getGreyLevel(point) & 0xff) + ' ';
+    }
+    std::filesystem::path const asciiPath = writeFile("td_volume_ascii.pgm3d", ascii);
+    check(isThresholded(BinaryVolume::importPGM3D(asciiPath, 100), 1, 100), "ASCII PGM3D volume");
+
+    std::string bytes = createVoxelBytes(1, true);
+    bytes.resize(bytes.size() / 2);
+    std::filesystem::path const truncated =
+      writeFile("td_volume_truncated.pgm3d", "P5-3D\n" + header + "255\n" + bytes);
+    check(isThrowing([&truncated]() { return BinaryVolume::importPGM3D(truncated); }),
+          "a binary PGM3D volume missing slices throws");
+
+    std::filesystem::path const truncatedAscii =
+      writeFile("td_volume_truncated_ascii.pgm3d", "P2-3D\n" + header + "255\n1 2 3\n");
+    check(isThrowing([&truncatedAscii]() { return BinaryVolume::importPGM3D(truncatedAscii); }),
+          "an ASCII PGM3D volume missing voxels throws");
+}
+
+void
+  checkBitPacking()
+{
+    // Away from the origin, as the masks of the components.
+    Domain3D const domain(Point3D(-3, 2, 5), Point3D(-3, 2, 5) + c_extent - Point3D::diagonal());
+    BinaryVolume   volume(domain);
+    std::vector<Point3D> expected;
+    std::size_t          i = 0;
+    for (auto const & point : domain)
+    {
+        // every third voxel, across the boundaries of the words.
+        if (i++ % 3 == 0)
+        {
+            volume.setValue(point, true);
+            expected.push_back(point);
+        }
+    }
+    // Cleared again, the neighbouring bits must not move.
+    volume.setValue(expected[1], false);
+    expected.erase(expected.begin() + 1);
+
+    bool isSame = true;
+    i           = 0;
+    for (auto const & point : domain)
+    {
+        isSame = isSame && volume(point) == (i % 3 == 0 && i != 3);
+        ++i;
+    }
+    check(isSame, "each voxel reads as set");
+    check(volume.count() == expected.size(), "count of the set voxels");
+    check(!volume(domain.lowerBound() - Point3D::diagonal()) && !volume(domain.upperBound() + Point3D::diagonal()),
+          "out of the domain reads as background");
+
+    std::vector<Point3D> visited;
+    volume.forEachPoint([&visited](Point3D const & point) { visited.push_back(point); });
+    check(visited == expected, "forEachPoint visits the set voxels in the order of the domain");
+}
+
+/// Random voxels, below the percolation threshold of the 6-adjacency:
+/// many components, some of them on the rim.
+/// \param seed
+/// \return
+BinaryVolume
+  createRandomVolume(unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    BinaryVolume volume(Point3D(20, 18, 16));
+    for (auto const & point : volume.domain())
+    {
+        volume.setValue(point, generator() % 4 == 0);
+    }
+    return volume;
+}
+
+/// Components of the 6-adjacency not touching the rim, by a flood fill over a set of points.
+/// \param volume
+/// \return measures of each component, in the order of their first voxel.
+std::vector<Measures>
+  labelBruteForce(BinaryVolume const & volume)
+{
+    Domain3D const       domain = volume.domain();
+    std::vector<Point3D> faces;
+    for (DGtal::Dimension k = 0; k < 3; ++k)
+    {
+        Point3D offset = Point3D::zero;
+        offset[k]      = 1;
+        faces.push_back(offset);
+        faces.push_back(-offset);
+    }
+    std::set<Point3D>     visited;
+    std::vector<Measures> components;
+    for (auto const & seed : domain)
+    {
+        if (!volume(seed) || visited.count(seed) != 0)
+        {
+            continue;
+        }
+        std::vector<Point3D> stack {seed};
+        visited.insert(seed);
+        std::size_t numberVoxels  = 0;
+        std::size_t numberSurfels = 0;
+        bool        isOnRim       = false;
+        while (!stack.empty())
+        {
+            Point3D const point = stack.back();
+            stack.pop_back();
+            ++numberVoxels;
+            for (DGtal::Dimension k = 0; k < 3; ++k)
+            {
+                isOnRim = isOnRim || point[k] == domain.lowerBound()[k] || point[k] == domain.upperBound()[k];
+            }
+            for (auto const & face : faces)
+            {
+                Point3D const neighbour = point + face;
+                if (!volume(neighbour))
+                {
+                    ++numberSurfels;
+                }
+                else if (visited.insert(neighbour).second)
+                {
+                    stack.push_back(neighbour);
+                }
+            }
+        }
+        if (!isOnRim)
+        {
+            components.emplace_back(seed, numberVoxels, numberSurfels);
+        }
+    }
+    return components;
+}
+
+/// \param composite
+/// \return measures of each component, in the order of their first voxel.
+std::vector<Measures>
+  measureComponents(CompositeVolume const & composite)
+{
+    std::vector<Measures> components;
+    for (auto const & component : composite.components)
+    {
+        Point3D first = component.getVoxels().domain().upperBound();
+        bool    isSet = false;
+        component.getVoxels().forEachPoint(
+          [&first, &isSet](Point3D const & point)
+          {
+              if (!isSet)
+              {
+                  first = point;
+                  isSet = true;
+              }
+          });
+        components.emplace_back(first,
+                                static_cast<std::size_t>(component.getCountVolume()),
+                                static_cast<std::size_t>(component.getCountSurfaceArea()));
+    }
+    // Ordered by z, then y, then x, as the domain.
+    std::sort(components.begin(),
+              components.end(),
+              [](Measures const & m1, Measures const & m2)
+              {
+                  Point3D const & p1 = std::get<0>(m1);
+                  Point3D const & p2 = std::get<0>(m2);
+                  return std::make_tuple(p1[2], p1[1], p1[0]) < std::make_tuple(p2[2], p2[1], p2[0]);
+              });
+    return components;
+}
+
+/// Cube of 5 voxels, with a cube of 3 voxels removed at its centre, away from the rim of the volume.
+/// \return
+BinaryVolume
+  createHollowCube()
+{
+    BinaryVolume volume(Point3D(9, 9, 9));
+    for (auto const & point : Domain3D(Point3D(2, 2, 2), Point3D(6, 6, 6)))
+    {
+        volume.setValue(point, true);
+    }
+    for (auto const & point : Domain3D(Point3D(3, 3, 3), Point3D(5, 5, 5)))
+    {
+        volume.setValue(point, false);
+    }
+    return volume;
+}
+
+int
+  main()
+{
+    checkImportRaw();
+    checkImportPGM3D();
+    checkBitPacking();
+
+    for (unsigned int seed : {1u, 2u, 3u})
+    {
+        CompositeVolume const composite(createRandomVolume(seed));
+        // Spread over threads, as the volume executable does.
+        composite.computeGeometry(4);
+        std::vector<Measures> const expected = labelBruteForce(composite.getVolume());
+        check(expected.size() > 10, "the random volume has many components");
+        check(measureComponents(composite) == expected,
+              "components, volumes and surfels match the brute-force scan");
+    }
+
+    CompositeVolume const composite(createHollowCube());
+    check(composite.components.size() == 1, "the hollow cube is a single component");
+    if (!composite.components.empty())
+    {
+        Component3D const & cube = composite.components.front();
+        check(cube.getCountVolume() == 125. - 27., "volume of the hollow cube");
+        // 6 faces of 5 x 5 surfels outside, 6 faces of 3 x 3 surfels around the cavity.
+        check(cube.getCountSurfaceArea() == 6. * 25. + 6. * 9., "surfels of the hollow cube, cavity included");
+    }
+
+    return reportChecks("volume");
+}